@@ -4966,6 +4966,34 @@ CryptoServiceTlsSetSessionId (
   return CALL_BASECRYPTLIB (TlsSet.Services.SessionId, TlsSetSessionId, (Tls, SessionId, SessionIdLen), EFI_UNSUPPORTED);
 }
 
+/**
+  Sets a saved TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function sets the session state previously returned by
+  TlsGetResumptionData() for the same server, so that the next handshake
+  can resume the session (session ID or session ticket) instead of running
+  a full handshake. It must be called before the handshake is started.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Data            Pointer to the serialized session state.
+  @param[in]  DataSize        The size of Data in bytes.
+
+  @retval  EFI_SUCCESS           The session was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_ABORTED           The session state could not be decoded or set.
+
+**/
+EFI_STATUS
+EFIAPI
+CryptoServiceTlsSetResumptionData (
+  IN     VOID         *Tls,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        DataSize
+  )
+{
+  return CALL_BASECRYPTLIB (TlsSet.Services.ResumptionData, TlsSetResumptionData, (Tls, Data, DataSize), EFI_UNSUPPORTED);
+}
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -5319,6 +5347,39 @@ CryptoServiceTlsGetSessionId (
   return CALL_BASECRYPTLIB (TlsGet.Services.SessionId, TlsGetSessionId, (Tls, SessionId, SessionIdLen), EFI_UNSUPPORTED);
 }
 
+/**
+  Gets the resumable session state of the specified TLS connection.
+
+  This function serializes the TLS/SSL session negotiated by the specified
+  TLS connection, including any session ticket received from the server, so
+  that a later connection to the same server can resume it through
+  TlsSetResumptionData(). The session set by TlsSetResumptionData() is not
+  returned again unless the server sent a new one, since a TLS 1.3 session
+  ticket must only be used once.
+
+  @param[in]      Tls             Pointer to the TLS object.
+  @param[out]     Data            Pointer to the buffer to receive the session state.
+  @param[in,out]  DataSize        The size of Data buffer in bytes. On output, the
+                                  size of the session state.
+
+  @retval  EFI_SUCCESS           The session state was returned successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_NOT_FOUND         The connection has no resumable session other than
+                                 the one set by TlsSetResumptionData().
+  @retval  EFI_BUFFER_TOO_SMALL  The Data is too small to hold the session state.
+
+**/
+EFI_STATUS
+EFIAPI
+CryptoServiceTlsGetResumptionData (
+  IN     VOID   *Tls,
+  OUT    UINT8  *Data  OPTIONAL,
+  IN OUT UINTN  *DataSize
+  )
+{
+  return CALL_BASECRYPTLIB (TlsGet.Services.ResumptionData, TlsGetResumptionData, (Tls, Data, DataSize), EFI_UNSUPPORTED);
+}
+
 /**
   Gets the client random data used in the specified TLS connection.
 
@@ -7139,4 +7200,7 @@ const EDKII_CRYPTO_PROTOCOL  mEdkiiCrypto = {
   CryptoServiceRsaOaepDecrypt,
   /// TLS Set (continued)
   CryptoServiceTlsSetServerName,
+  CryptoServiceTlsSetResumptionData,
+  /// TLS Get (continued)
+  CryptoServiceTlsGetResumptionData,
 };
@@ -328,6 +328,7 @@ typedef struct {
       UINT8    SignatureAlgoList  : 1;
       UINT8    EcCurve            : 1;
       UINT8    ServerName         : 1;
+      UINT8    ResumptionData     : 1;
     } Services;
     UINT32    Family;
   } TlsSet;
@@ -347,6 +348,7 @@ typedef struct {
       UINT8    HostPrivateKey       : 1;
       UINT8    CertRevocationList   : 1;
       UINT8    ExportKey            : 1;
+      UINT8    ResumptionData       : 1;
     } Services;
     UINT32    Family;
   } TlsGet;
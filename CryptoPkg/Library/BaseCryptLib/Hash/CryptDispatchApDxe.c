@@ -13,8 +13,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 /**
   Dispatch the block task to each AP in PEI phase.
 
+  StartupAllAPs() is called in blocking mode, so all APs are done with the
+  procedure when this function returns.
+
+  @retval 0  No AP is still running the procedure.
+
 **/
-VOID
+UINTN
 EFIAPI
 DispatchBlockToAp (
   VOID
@@ -33,7 +38,7 @@ DispatchBlockToAp (
     // Failed to locate MpServices Protocol, do parallel hash by one core.
     //
     DEBUG ((DEBUG_ERROR, "[DispatchBlockToApDxe] Failed to locate MpServices Protocol. Status = %r\n", Status));
-    return;
+    return 0;
   }
 
   Status = MpServices->StartupAllAPs (
@@ -45,5 +50,5 @@ DispatchBlockToAp (
                          NULL,
                          NULL
                          );
-  return;
+  return 0;
 }
@@ -0,0 +1,28 @@
+/** @file
+  Dispatch Block to Aps in host-based unit tests for parallelhash algorithm.
+
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "CryptParallelHash.h"
+
+/**
+  Dispatch the block task to a single emulated AP.
+
+  There are no APs in a host application, so the procedure is run once on the
+  calling processor before the BSP part. The AP is reported as started, which
+  makes the caller also wait for its completion signal.
+
+  @retval 1  The procedure has been run on one emulated AP.
+
+**/
+UINTN
+EFIAPI
+DispatchBlockToAp (
+  VOID
+  )
+{
+  ParallelHashApExecute (NULL);
+  return 1;
+}
@@ -12,24 +12,33 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 /**
   Dispatch the block task to each AP in SMM mode.
 
+  MmStartupThisAp() does not wait for the AP, so the APs may still be running
+  the procedure when this function returns.
+
+  @return The number of APs the procedure has been started on.
+
 **/
-VOID
+UINTN
 EFIAPI
 DispatchBlockToAp (
   VOID
   )
 {
   UINTN  Index;
+  UINTN  Started;
 
   if (gMmst == NULL) {
-    return;
+    return 0;
   }
 
+  Started = 0;
   for (Index = 0; Index < gMmst->NumberOfCpus; Index++) {
     if (Index != gMmst->CurrentlyExecutingCpu) {
-      gMmst->MmStartupThisAp (ParallelHashApExecute, Index, NULL);
+      if (!EFI_ERROR (gMmst->MmStartupThisAp (ParallelHashApExecute, Index, NULL))) {
+        Started++;
+      }
     }
   }
 
-  return;
+  return Started;
 }
@@ -15,8 +15,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 /**
   Dispatch the block task to each AP in PEI phase.
 
+  StartupAllAPs() is called in blocking mode, so all APs are done with the
+  procedure when this function returns.
+
+  @retval 0  No AP is still running the procedure.
+
 **/
-VOID
+UINTN
 EFIAPI
 DispatchBlockToAp (
   VOID
@@ -39,7 +44,7 @@ DispatchBlockToAp (
     // Failed to locate MpServices Ppi, do parallel hash by one core.
     //
     DEBUG ((DEBUG_ERROR, "[DispatchBlockToApPei] Failed to locate MpServices Ppi. Status = %r\n", Status));
-    return;
+    return 0;
   }
 
   Status = MpServicesPpi->StartupAllAPs (
@@ -50,5 +55,5 @@ DispatchBlockToAp (
                             0,
                             NULL
                             );
-  return;
+  return 0;
 }
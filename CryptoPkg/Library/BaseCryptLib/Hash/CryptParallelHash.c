@@ -20,6 +20,27 @@ UINT8      *mBlockHashResult;
 BOOLEAN    *mBlockIsCompleted;
 SPIN_LOCK  *mSpinLockList;
 
+volatile UINT32  mApsCompleted;
+
+/**
+  Wait until the APs the procedure has been dispatched to are done with it.
+
+  The shared block state must not be freed before, as an AP may still be
+  walking it after the BSP has seen every block completed.
+
+  @param[in] ApsStarted  Number of APs returned by DispatchBlockToAp().
+**/
+STATIC
+VOID
+WaitForDispatchedAps (
+  IN UINTN  ApsStarted
+  )
+{
+  while (mApsCompleted < ApsStarted) {
+    CpuPause ();
+  }
+}
+
 /**
   Complete computation of digest of each block.
 
@@ -66,6 +87,8 @@ ParallelHashApExecute (
       ReleaseSpinLock (&mSpinLockList[Index]);
     }
   }
+
+  InterlockedIncrement (&mApsCompleted);
 }
 
 /**
@@ -109,6 +132,7 @@ ParallelHash256HashAll (
   BOOLEAN  AllCompleted;
   UINTN    Offset;
   BOOLEAN  ReturnValue;
+  UINTN    ApsStarted;
 
   if ((InputByteLen == 0) || (OutputByteLen == 0) || (BlockSize == 0)) {
     return FALSE;
@@ -175,7 +199,8 @@ ParallelHash256HashAll (
   //
   // Dispatch blocklist to each AP.
   //
-  DispatchBlockToAp ();
+  mApsCompleted = 0;
+  ApsStarted    = DispatchBlockToAp ();
 
   //
   // Wait until all block hash completed.
@@ -212,6 +237,8 @@ ParallelHash256HashAll (
     }
   } while (!AllCompleted);
 
+  WaitForDispatchedAps (ApsStarted);
+
   //
   // Fill LeftEncode(n).
   //
@@ -206,6 +206,11 @@ CShake256HashAll (
   OUT  UINT8       *HashValue
   );
 
+//
+// Number of APs which finished the procedure dispatched by DispatchBlockToAp().
+//
+extern volatile UINT32  mApsCompleted;
+
 /**
   Complete computation of digest of each block.
 
@@ -222,8 +227,14 @@ ParallelHashApExecute (
 /**
   Dispatch the block task to each AP.
 
+  Each AP signals the end of the procedure through mApsCompleted, so that the
+  caller does not release the shared state while an AP still touches it.
+
+  @return The number of APs the procedure may still be running on when this
+          function returns.
+
 **/
-VOID
+UINTN
 EFIAPI
 DispatchBlockToAp (
   VOID
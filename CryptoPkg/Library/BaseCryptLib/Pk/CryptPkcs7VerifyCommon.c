@@ -24,6 +24,31 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 GLOBAL_REMOVE_IF_UNREFERENCED const UINT8  mOidValue[9] = { 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x07, 0x02 };
 
+//
+// Number of verified certificate links remembered across Pkcs7Verify() calls.
+//
+#define PKCS7_CHAIN_CACHE_SIZE  16
+
+//
+// A certificate link whose signature has been verified: the issuer's key
+// verified the subject's signature, in a chain that ended at the anchor.
+// All certificates are identified by the SHA-256 digest of their encoding.
+//
+typedef struct {
+  UINT8    Anchor[SHA256_DIGEST_SIZE];
+  UINT8    Issuer[SHA256_DIGEST_SIZE];
+  UINT8    Subject[SHA256_DIGEST_SIZE];
+} PKCS7_CHAIN_CACHE_ENTRY;
+
+GLOBAL_REMOVE_IF_UNREFERENCED PKCS7_CHAIN_CACHE_ENTRY  mPkcs7ChainCache[PKCS7_CHAIN_CACHE_SIZE];
+GLOBAL_REMOVE_IF_UNREFERENCED UINTN                    mPkcs7ChainCacheCount;
+GLOBAL_REMOVE_IF_UNREFERENCED UINTN                    mPkcs7ChainCacheNext;
+
+//
+// Digest of the trusted certificate of the Pkcs7Verify() call in progress.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED UINT8  mPkcs7AnchorDigest[SHA256_DIGEST_SIZE];
+
 /**
   Check input P7Data is a wrapped ContentInfo structure or not. If not construct
   a new structure to wrap P7Data.
@@ -747,6 +772,188 @@ _Error:
   return Status;
 }
 
+/**
+  Find a verified certificate link in the chain cache.
+
+  @param[in]  Issuer   SHA-256 digest of the issuer certificate.
+  @param[in]  Subject  SHA-256 digest of the subject certificate.
+
+  @retval  TRUE   The link was verified before under the current anchor.
+  @retval  FALSE  The link is not cached.
+
+**/
+STATIC
+BOOLEAN
+Pkcs7ChainCacheLookup (
+  IN CONST UINT8  *Issuer,
+  IN CONST UINT8  *Subject
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < mPkcs7ChainCacheCount; Index++) {
+    if ((CompareMem (mPkcs7ChainCache[Index].Subject, Subject, SHA256_DIGEST_SIZE) == 0) &&
+        (CompareMem (mPkcs7ChainCache[Index].Issuer, Issuer, SHA256_DIGEST_SIZE) == 0) &&
+        (CompareMem (mPkcs7ChainCache[Index].Anchor, mPkcs7AnchorDigest, SHA256_DIGEST_SIZE) == 0))
+    {
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Record a verified certificate link in the chain cache.
+
+  When the cache is full the oldest entry is replaced.
+
+  @param[in]  Issuer   SHA-256 digest of the issuer certificate.
+  @param[in]  Subject  SHA-256 digest of the subject certificate.
+
+**/
+STATIC
+VOID
+Pkcs7ChainCacheInsert (
+  IN CONST UINT8  *Issuer,
+  IN CONST UINT8  *Subject
+  )
+{
+  PKCS7_CHAIN_CACHE_ENTRY  *Entry;
+
+  Entry = &mPkcs7ChainCache[mPkcs7ChainCacheNext];
+  CopyMem (Entry->Anchor, mPkcs7AnchorDigest, SHA256_DIGEST_SIZE);
+  CopyMem (Entry->Issuer, Issuer, SHA256_DIGEST_SIZE);
+  CopyMem (Entry->Subject, Subject, SHA256_DIGEST_SIZE);
+
+  mPkcs7ChainCacheNext = (mPkcs7ChainCacheNext + 1) % PKCS7_CHAIN_CACHE_SIZE;
+  if (mPkcs7ChainCacheCount < PKCS7_CHAIN_CACHE_SIZE) {
+    mPkcs7ChainCacheCount++;
+  }
+}
+
+/**
+  Report a certificate chain error to the verify callback of the store.
+
+  @param[in]  Context  The X509 store context holding the built chain.
+  @param[in]  Cert     The certificate the error applies to.
+  @param[in]  Depth    The depth of Cert in the chain.
+  @param[in]  Error    The X509_V_ERR_* error code.
+
+  @retval  1  The verify callback chose to ignore the error.
+  @retval  0  The chain is rejected.
+
+**/
+STATIC
+int
+Pkcs7ChainError (
+  IN X509_STORE_CTX  *Context,
+  IN X509            *Cert,
+  IN INTN            Depth,
+  IN int             Error
+  )
+{
+  X509_STORE_CTX_set_error_depth (Context, (int)Depth);
+  X509_STORE_CTX_set_current_cert (Context, Cert);
+  X509_STORE_CTX_set_error (Context, Error);
+  return X509_STORE_CTX_get_verify_cb (Context)(0, Context);
+}
+
+/**
+  Verify the signatures along a certificate chain built by OpenSSL.
+
+  This replaces the default signature pass of X509_verify_cert() and follows
+  it: each issuer must be allowed to sign certificates by its key usage
+  extension, each certificate is checked with the public key of the next one
+  in the chain, up to the trust anchor, whose own signature is not checked,
+  and the verify callback of the store sees every error and every checked
+  certificate. Links between two CA certificates that were verified before
+  under the same anchor are taken from the chain cache, so that on repeated
+  verifications usually only the signature of the signer certificate is
+  checked. Validity periods are not checked here, as X509_V_FLAG_NO_CHECK_TIME
+  is set on the store.
+
+  @param[in]  Context  The X509 store context holding the built chain.
+
+  @retval  1  The chain is valid.
+  @retval  0  The chain is rejected, the error is set in Context.
+
+**/
+STATIC
+int
+Pkcs7VerifyChainSignatures (
+  IN X509_STORE_CTX  *Context
+  )
+{
+  STACK_OF (X509)  *Chain;
+  INTN             Index;
+  X509             *Subject;
+  X509             *Issuer;
+  EVP_PKEY         *IssuerKey;
+  UINT8            SubjectDigest[SHA256_DIGEST_SIZE];
+  UINT8            IssuerDigest[SHA256_DIGEST_SIZE];
+  BOOLEAN          Cacheable;
+
+  Chain = X509_STORE_CTX_get0_chain (Context);
+  if (Chain == NULL) {
+    return 0;
+  }
+
+  for (Index = sk_X509_num (Chain) - 2; Index >= 0; Index--) {
+    Subject = sk_X509_value (Chain, (int)Index);
+    Issuer  = sk_X509_value (Chain, (int)Index + 1);
+
+    //
+    // RFC 5280: the issuer key must be allowed to sign certificates. This is
+    // checked on every call, the trust anchor included, as the chain cache
+    // only stands for the signature.
+    //
+    if (((X509_get_extension_flags (Issuer) & EXFLAG_KUSAGE) != 0) &&
+        ((X509_get_key_usage (Issuer) & KU_KEY_CERT_SIGN) == 0))
+    {
+      if (Pkcs7ChainError (Context, Issuer, Index + 1, X509_V_ERR_KEYUSAGE_NO_CERTSIGN) == 0) {
+        return 0;
+      }
+    }
+
+    //
+    // Links to the signer certificate change with every signer, so they are
+    // neither looked up nor recorded.
+    //
+    Cacheable = (BOOLEAN)(Index > 0);
+    if (Cacheable) {
+      Cacheable = (BOOLEAN)((X509_digest (Subject, EVP_sha256 (), SubjectDigest, NULL) == 1) &&
+                            (X509_digest (Issuer, EVP_sha256 (), IssuerDigest, NULL) == 1));
+    }
+
+    if (!Cacheable || !Pkcs7ChainCacheLookup (IssuerDigest, SubjectDigest)) {
+      IssuerKey = X509_get0_pubkey (Issuer);
+      if (IssuerKey == NULL) {
+        if (Pkcs7ChainError (Context, Issuer, Index + 1, X509_V_ERR_UNABLE_TO_DECODE_ISSUER_PUBLIC_KEY) == 0) {
+          return 0;
+        }
+      } else if (X509_verify (Subject, IssuerKey) <= 0) {
+        if (Pkcs7ChainError (Context, Subject, Index, X509_V_ERR_CERT_SIGNATURE_FAILURE) == 0) {
+          return 0;
+        }
+      } else if (Cacheable) {
+        Pkcs7ChainCacheInsert (IssuerDigest, SubjectDigest);
+      }
+    }
+
+    //
+    // Let the verify callback see the checked certificate.
+    //
+    X509_STORE_CTX_set_error_depth (Context, (int)Index);
+    X509_STORE_CTX_set_current_cert (Context, Subject);
+    if (X509_STORE_CTX_get_verify_cb (Context)(1, Context) == 0) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
 /**
   Verifies the validity of a PKCS#7 signed data as described in "PKCS #7:
   Cryptographic Message Syntax Standard". The input signed data could be wrapped
@@ -906,6 +1113,14 @@ Pkcs7Verify (
   //
   X509_STORE_set_purpose (CertStore, X509_PURPOSE_ANY);
 
+  //
+  // Check the chain signatures through the verified link cache, scoped to
+  // this trusted certificate.
+  //
+  if (X509_digest (Cert, EVP_sha256 (), mPkcs7AnchorDigest, NULL) == 1) {
+    X509_STORE_set_verify (CertStore, Pkcs7VerifyChainSignatures);
+  }
+
   //
   // Verifies the PKCS#7 signedData structure
   //
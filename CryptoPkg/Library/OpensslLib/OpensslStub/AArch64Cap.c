@@ -90,6 +90,24 @@ OPENSSL_cpuid_setup (
   {
     OPENSSL_armcap_P |= ARMV8_SHA512;
   }
+
+  if (GET_BITFIELD (
+        Isar0,
+        ARM_ID_AA64ISAR0_EL1_SHA3_SHIFT,
+        ARM_ID_AA64ISAR0_EL1_SHA3_MASK
+        ) >= ARM_ID_AA64ISAR0_EL1_SHA3_FEAT_SHA3_MASK)
+  {
+    OPENSSL_armcap_P |= ARMV8_SHA3;
+  }
+
+  if (GET_BITFIELD (
+        Isar0,
+        ARM_ID_AA64ISAR0_EL1_SM3_SHIFT,
+        ARM_ID_AA64ISAR0_EL1_SM3_MASK
+        ) >= ARM_ID_AA64ISAR0_EL1_SM3_FEAT_SM3_MASK)
+  {
+    OPENSSL_armcap_P |= ARMV8_SM3;
+  }
 }
 
 /** Read system counter value.
@@ -30,15 +30,19 @@ typedef struct {
   // Main SSL Connection which is created by a server or a client
   // per established connection.
   //
-  SSL    *Ssl;
+  SSL            *Ssl;
   //
   // Memory BIO for the TLS/SSL Reading operations.
   //
-  BIO    *InBio;
+  BIO            *InBio;
   //
   // Memory BIO for the TLS/SSL Writing operations.
   //
-  BIO    *OutBio;
+  BIO            *OutBio;
+  //
+  // Session set by TlsSetResumptionData(), which must not be handed out again.
+  //
+  SSL_SESSION    *ResumedSession;
 } TLS_CONNECTION;
 
 /* This is a context that we pass to callbacks */
@@ -674,6 +674,67 @@ TlsSetSessionId (
   return EFI_SUCCESS;
 }
 
+/**
+  Sets a saved TLS/SSL session to be resumed during TLS/SSL connect.
+
+  This function sets the session state previously returned by
+  TlsGetResumptionData() for the same server, so that the next handshake
+  can resume the session (session ID or session ticket) instead of running
+  a full handshake. It must be called before the handshake is started.
+
+  @param[in]  Tls             Pointer to the TLS object.
+  @param[in]  Data            Pointer to the serialized session state.
+  @param[in]  DataSize        The size of Data in bytes.
+
+  @retval  EFI_SUCCESS           The session was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_ABORTED           The session state could not be decoded or set.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetResumptionData (
+  IN     VOID         *Tls,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        DataSize
+  )
+{
+  TLS_CONNECTION       *TlsConn;
+  SSL_SESSION          *Session;
+  CONST unsigned char  *Buffer;
+  INTN                 Ret;
+
+  TlsConn = (TLS_CONNECTION *)Tls;
+
+  if ((TlsConn == NULL) || (TlsConn->Ssl == NULL) || (Data == NULL) || (DataSize == 0) || (DataSize > MAX_INT32)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Buffer  = (CONST unsigned char *)Data;
+  Session = d2i_SSL_SESSION (NULL, &Buffer, (long)DataSize);
+  if (Session == NULL) {
+    return EFI_ABORTED;
+  }
+
+  //
+  // SSL_set_session() takes its own reference on the session. The reference
+  // taken here is kept to recognize the session when it is still the current
+  // one, i.e. no new session ticket was received.
+  //
+  Ret = SSL_set_session (TlsConn->Ssl, Session);
+  if (Ret != 1) {
+    SSL_SESSION_free (Session);
+    return EFI_ABORTED;
+  }
+
+  if (TlsConn->ResumedSession != NULL) {
+    SSL_SESSION_free (TlsConn->ResumedSession);
+  }
+
+  TlsConn->ResumedSession = Session;
+  return EFI_SUCCESS;
+}
+
 /**
   Adds the CA to the cert store when requesting Server or Client authentication.
 
@@ -1387,6 +1448,70 @@ TlsGetSessionId (
   return EFI_SUCCESS;
 }
 
+/**
+  Gets the resumable session state of the specified TLS connection.
+
+  This function serializes the TLS/SSL session negotiated by the specified
+  TLS connection, including any session ticket received from the server, so
+  that a later connection to the same server can resume it through
+  TlsSetResumptionData(). The session set by TlsSetResumptionData() is not
+  returned again unless the server sent a new one, since a TLS 1.3 session
+  ticket must only be used once.
+
+  @param[in]      Tls             Pointer to the TLS object.
+  @param[out]     Data            Pointer to the buffer to receive the session state.
+  @param[in,out]  DataSize        The size of Data buffer in bytes. On output, the
+                                  size of the session state.
+
+  @retval  EFI_SUCCESS           The session state was returned successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_NOT_FOUND         The connection has no resumable session other than
+                                 the one set by TlsSetResumptionData().
+  @retval  EFI_BUFFER_TOO_SMALL  The Data is too small to hold the session state.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsGetResumptionData (
+  IN     VOID   *Tls,
+  OUT    UINT8  *Data  OPTIONAL,
+  IN OUT UINTN  *DataSize
+  )
+{
+  TLS_CONNECTION  *TlsConn;
+  SSL_SESSION     *Session;
+  unsigned char   *Buffer;
+  INTN            Length;
+
+  TlsConn = (TLS_CONNECTION *)Tls;
+
+  if ((TlsConn == NULL) || (TlsConn->Ssl == NULL) || (DataSize == NULL) ||
+      ((Data == NULL) && (*DataSize != 0)))
+  {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Session = SSL_get_session (TlsConn->Ssl);
+  if ((Session == NULL) || (Session == TlsConn->ResumedSession) || (SSL_SESSION_is_resumable (Session) != 1)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Length = i2d_SSL_SESSION (Session, NULL);
+  if (Length <= 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (*DataSize < (UINTN)Length) {
+    *DataSize = (UINTN)Length;
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  Buffer    = (unsigned char *)Data;
+  *DataSize = (UINTN)i2d_SSL_SESSION (Session, &Buffer);
+
+  return EFI_SUCCESS;
+}
+
 /**
   Gets the client random data used in the specified TLS connection.
 
@@ -138,6 +138,10 @@ TlsFree (
     SSL_free (TlsConn->Ssl);
   }
 
+  if (TlsConn->ResumedSession != NULL) {
+    SSL_SESSION_free (TlsConn->ResumedSession);
+  }
+
   OPENSSL_free (Tls);
 }
 
@@ -174,7 +178,8 @@ TlsNew (
     return NULL;
   }
 
-  TlsConn->Ssl = NULL;
+  TlsConn->Ssl            = NULL;
+  TlsConn->ResumedSession = NULL;
 
   //
   // Create a new SSL Object
@@ -385,6 +385,526 @@ GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  TestCert2[] = {
   0x25, 0x9f, 0x16
 };
 
+//
+// TestCase3: Intermediate CA whose key usage does not allow certificate signing
+//
+// The extensions are in ext.cnf:
+//   [root] / [ca]: basicConstraints=critical,CA:TRUE
+//                  keyUsage=critical,keyCertSign,cRLSign
+//   [nocertsign]:  basicConstraints=critical,CA:TRUE
+//                  keyUsage=critical,digitalSignature
+//   [signer]:      basicConstraints=critical,CA:FALSE
+//                  keyUsage=critical,digitalSignature
+//
+// Root CA X509 Certificate (Generated by OpenSSL utility).
+// $ openssl genrsa -out TestChainRootKey 2048
+// $ openssl req -x509 -new -days 36500 -key TestChainRootKey -subj "/C=US/ST=WA/L=Seattle/O=Tianocore/OU=EDK2/CN=UEFI Root CA" -extensions root -config openssl.cnf -outform DER -out TestChainRootCert
+// $ xxd --include TestChainRootCert
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  TestChainRootCert[] = {
+  0x30, 0x82, 0x03, 0x9e, 0x30, 0x82, 0x02, 0x86, 0xa0, 0x03, 0x02, 0x01,
+  0x02, 0x02, 0x14, 0x2b, 0x17, 0x7a, 0x70, 0xd3, 0xe9, 0x0e, 0xe7, 0x24,
+  0x4e, 0xe9, 0x55, 0x55, 0x37, 0xbf, 0x8e, 0x69, 0xd5, 0x1f, 0x12, 0x30,
+  0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b,
+  0x05, 0x00, 0x30, 0x66, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04,
+  0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55,
+  0x04, 0x08, 0x0c, 0x02, 0x57, 0x41, 0x31, 0x10, 0x30, 0x0e, 0x06, 0x03,
+  0x55, 0x04, 0x07, 0x0c, 0x07, 0x53, 0x65, 0x61, 0x74, 0x74, 0x6c, 0x65,
+  0x31, 0x12, 0x30, 0x10, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x09, 0x54,
+  0x69, 0x61, 0x6e, 0x6f, 0x63, 0x6f, 0x72, 0x65, 0x31, 0x0d, 0x30, 0x0b,
+  0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x04, 0x45, 0x44, 0x4b, 0x32, 0x31,
+  0x15, 0x30, 0x13, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x0c, 0x55, 0x45,
+  0x46, 0x49, 0x20, 0x52, 0x6f, 0x6f, 0x74, 0x20, 0x43, 0x41, 0x30, 0x20,
+  0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x34, 0x32, 0x32,
+  0x32, 0x31, 0x5a, 0x18, 0x0f, 0x32, 0x31, 0x32, 0x36, 0x30, 0x39, 0x32,
+  0x35, 0x31, 0x34, 0x32, 0x32, 0x32, 0x31, 0x5a, 0x30, 0x66, 0x31, 0x0b,
+  0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31,
+  0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x08, 0x0c, 0x02, 0x57, 0x41,
+  0x31, 0x10, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x04, 0x07, 0x0c, 0x07, 0x53,
+  0x65, 0x61, 0x74, 0x74, 0x6c, 0x65, 0x31, 0x12, 0x30, 0x10, 0x06, 0x03,
+  0x55, 0x04, 0x0a, 0x0c, 0x09, 0x54, 0x69, 0x61, 0x6e, 0x6f, 0x63, 0x6f,
+  0x72, 0x65, 0x31, 0x0d, 0x30, 0x0b, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+  0x04, 0x45, 0x44, 0x4b, 0x32, 0x31, 0x15, 0x30, 0x13, 0x06, 0x03, 0x55,
+  0x04, 0x03, 0x0c, 0x0c, 0x55, 0x45, 0x46, 0x49, 0x20, 0x52, 0x6f, 0x6f,
+  0x74, 0x20, 0x43, 0x41, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06, 0x09,
+  0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00, 0x03,
+  0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01, 0x01,
+  0x00, 0xc4, 0xf0, 0x3b, 0x40, 0x7d, 0xce, 0x9d, 0x72, 0xb2, 0x49, 0x07,
+  0x0b, 0xbb, 0x98, 0x76, 0x30, 0x36, 0xf4, 0x1c, 0x1b, 0xc5, 0xce, 0x2f,
+  0x86, 0x37, 0x14, 0xab, 0xe8, 0xc5, 0xee, 0xa2, 0x0c, 0x43, 0x8f, 0x98,
+  0x41, 0xb3, 0x1c, 0x68, 0x24, 0x99, 0x03, 0x15, 0x0f, 0x2e, 0x8f, 0xc1,
+  0x92, 0x29, 0x81, 0xcb, 0x81, 0xae, 0x9b, 0x0f, 0x59, 0xea, 0xd3, 0xec,
+  0xa0, 0xd0, 0xc9, 0x61, 0x92, 0x2c, 0xf2, 0x7c, 0x11, 0xf3, 0x65, 0x26,
+  0xb8, 0x2f, 0x9a, 0x9c, 0x3c, 0xba, 0x9e, 0x62, 0x53, 0x14, 0x7f, 0x1f,
+  0x80, 0x6a, 0xe5, 0xa8, 0xfb, 0x41, 0x99, 0x64, 0xb0, 0xf4, 0xa8, 0x3f,
+  0xce, 0x83, 0xb8, 0xcf, 0xd5, 0x0f, 0x5e, 0xdf, 0x7d, 0x1e, 0x5d, 0x75,
+  0x51, 0xd0, 0x58, 0x8a, 0xe4, 0x10, 0x63, 0xa4, 0xf0, 0xa9, 0xdc, 0xd8,
+  0xec, 0xa3, 0x7e, 0x42, 0x4e, 0x29, 0x1c, 0x88, 0xce, 0xfa, 0xa0, 0xdc,
+  0xcd, 0x19, 0x16, 0x19, 0xf2, 0x64, 0x48, 0x24, 0x65, 0x99, 0x5f, 0x50,
+  0xe5, 0x94, 0x49, 0xa9, 0xdc, 0xab, 0x00, 0xba, 0x46, 0x39, 0x68, 0x42,
+  0xf1, 0x77, 0x03, 0xb2, 0x1f, 0x42, 0x61, 0x8a, 0x0e, 0xd2, 0x45, 0xf7,
+  0xa2, 0x7c, 0xd0, 0x1a, 0xf0, 0x01, 0x2d, 0x17, 0xa1, 0x8f, 0xda, 0xff,
+  0xc0, 0x42, 0x8f, 0x5e, 0x64, 0xeb, 0x37, 0x5a, 0xf6, 0x5a, 0xf1, 0x5a,
+  0x51, 0xa5, 0x94, 0x76, 0x36, 0x09, 0xe3, 0x50, 0x6e, 0x45, 0x5c, 0x2d,
+  0x7a, 0x2e, 0xb8, 0x18, 0xf0, 0x2c, 0x15, 0xf6, 0xcd, 0x0e, 0x3b, 0xb3,
+  0xf1, 0x71, 0x5d, 0xb5, 0xb8, 0xe5, 0x4d, 0x9a, 0xd5, 0x20, 0xcf, 0x71,
+  0xbf, 0x70, 0x3c, 0xa9, 0x4d, 0x9f, 0x32, 0x85, 0xc0, 0x8d, 0x3a, 0xa3,
+  0xad, 0x6c, 0xda, 0xd6, 0xfa, 0x96, 0xf9, 0x58, 0xd7, 0x76, 0xd1, 0x33,
+  0xb8, 0xa7, 0xa3, 0x39, 0x4b, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3, 0x42,
+  0x30, 0x40, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff,
+  0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06, 0x03, 0x55,
+  0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06, 0x30,
+  0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x68, 0x7c,
+  0xe3, 0x6d, 0xab, 0x76, 0x8d, 0x39, 0xc1, 0x41, 0xd8, 0x93, 0x99, 0xd9,
+  0xd6, 0xbe, 0xad, 0x91, 0x5d, 0x2a, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86,
+  0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03, 0x82, 0x01,
+  0x01, 0x00, 0xb3, 0x03, 0xa7, 0x86, 0xc5, 0x8d, 0x64, 0xcc, 0x06, 0xcd,
+  0x84, 0x05, 0x20, 0x95, 0x14, 0x6c, 0x79, 0xed, 0x87, 0x2a, 0x8f, 0xde,
+  0x72, 0x03, 0x85, 0x66, 0x0f, 0xbb, 0xa9, 0x54, 0x55, 0x5e, 0x38, 0xab,
+  0x16, 0x3b, 0xed, 0x55, 0x09, 0xf4, 0xe3, 0x04, 0x8e, 0x29, 0x24, 0x7e,
+  0x95, 0x1d, 0xa0, 0x4a, 0xb3, 0xf5, 0x8d, 0xaf, 0xfa, 0xab, 0x25, 0xa1,
+  0x44, 0xfb, 0x96, 0x80, 0x81, 0xf3, 0x13, 0xff, 0x04, 0x2f, 0x9f, 0x53,
+  0xef, 0x11, 0x91, 0x1d, 0x52, 0x43, 0xa2, 0x24, 0x4c, 0x3c, 0xb0, 0x30,
+  0xb5, 0x95, 0x93, 0xd7, 0x70, 0x1b, 0x78, 0x87, 0x52, 0x32, 0xa9, 0x39,
+  0x64, 0x6b, 0x7e, 0x0b, 0xe0, 0x86, 0x59, 0x9a, 0xbe, 0x1e, 0x9d, 0xc8,
+  0x3b, 0xab, 0x83, 0x6c, 0xaa, 0xb9, 0x9f, 0x1d, 0x1c, 0x3b, 0x83, 0x85,
+  0xd1, 0x9d, 0x43, 0xf0, 0x8d, 0x51, 0x52, 0x85, 0xac, 0xc9, 0xbf, 0x95,
+  0x3f, 0x7c, 0xaf, 0xa5, 0xbe, 0xaf, 0x79, 0xb7, 0x17, 0x64, 0xae, 0x00,
+  0x16, 0x23, 0x36, 0x6a, 0xbf, 0x87, 0x2b, 0x2f, 0xd5, 0x26, 0x83, 0x2c,
+  0x38, 0x57, 0xd9, 0x42, 0x39, 0x92, 0x79, 0x07, 0x2f, 0xd1, 0xd4, 0x39,
+  0xf0, 0x06, 0x40, 0xbc, 0xf1, 0xfe, 0x8a, 0x23, 0x8e, 0xd8, 0xb2, 0x9d,
+  0x56, 0xef, 0xd9, 0xd9, 0x92, 0xb9, 0x5c, 0xe2, 0x0d, 0x04, 0x5e, 0xfb,
+  0x84, 0x3f, 0x93, 0xb7, 0x49, 0xef, 0x12, 0xb5, 0xae, 0x88, 0x0a, 0xd9,
+  0x5a, 0x6d, 0xd2, 0x32, 0x3d, 0x39, 0xc6, 0x65, 0xc1, 0x72, 0x00, 0xb0,
+  0x57, 0xc0, 0x6a, 0x12, 0x5c, 0x44, 0xfc, 0x34, 0xeb, 0xd1, 0x01, 0x01,
+  0x38, 0x28, 0xfd, 0xdb, 0xfb, 0x30, 0x4e, 0xa2, 0x2b, 0xed, 0x8e, 0x0e,
+  0xf4, 0x6c, 0x48, 0x66, 0xa6, 0xe6, 0xcc, 0x73, 0xa7, 0xc9, 0x86, 0x7d,
+  0xb4, 0x3f, 0x27, 0x59, 0x57, 0x48
+};
+
+//
+// Intermediate CA X509 Certificates, with the same subject and key, issued by
+// the root CA (Generated by OpenSSL utility).
+// $ openssl genrsa -out TestChainCAKey 2048
+// $ openssl req -new -key TestChainCAKey -subj "/C=US/ST=WA/L=Seattle/O=Tianocore/OU=EDK2/CN=UEFI Intermediate CA" -out TestChainCACsr
+// $ openssl x509 -req -days 36500 -CA TestChainRootCert.pem -CAkey TestChainRootKey -set_serial 101 -extfile ext.cnf -extensions ca -in TestChainCACsr -outform DER -out TestChainCACert
+// $ openssl x509 -req -days 36500 -CA TestChainRootCert.pem -CAkey TestChainRootKey -set_serial 102 -extfile ext.cnf -extensions nocertsign -in TestChainCACsr -outform DER -out TestChainNoCertSignCACert
+// $ xxd --include TestChainCACert
+// $ xxd --include TestChainNoCertSignCACert
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  TestChainCACert[] = {
+  0x30, 0x82, 0x03, 0xb4, 0x30, 0x82, 0x02, 0x9c, 0xa0, 0x03, 0x02, 0x01,
+  0x02, 0x02, 0x01, 0x65, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86,
+  0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x66, 0x31, 0x0b, 0x30,
+  0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x0b,
+  0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x08, 0x0c, 0x02, 0x57, 0x41, 0x31,
+  0x10, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x04, 0x07, 0x0c, 0x07, 0x53, 0x65,
+  0x61, 0x74, 0x74, 0x6c, 0x65, 0x31, 0x12, 0x30, 0x10, 0x06, 0x03, 0x55,
+  0x04, 0x0a, 0x0c, 0x09, 0x54, 0x69, 0x61, 0x6e, 0x6f, 0x63, 0x6f, 0x72,
+  0x65, 0x31, 0x0d, 0x30, 0x0b, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x04,
+  0x45, 0x44, 0x4b, 0x32, 0x31, 0x15, 0x30, 0x13, 0x06, 0x03, 0x55, 0x04,
+  0x03, 0x0c, 0x0c, 0x55, 0x45, 0x46, 0x49, 0x20, 0x52, 0x6f, 0x6f, 0x74,
+  0x20, 0x43, 0x41, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31,
+  0x39, 0x31, 0x34, 0x32, 0x32, 0x32, 0x32, 0x5a, 0x18, 0x0f, 0x32, 0x31,
+  0x32, 0x36, 0x30, 0x39, 0x32, 0x35, 0x31, 0x34, 0x32, 0x32, 0x32, 0x32,
+  0x5a, 0x30, 0x6e, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06,
+  0x13, 0x02, 0x55, 0x53, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04,
+  0x08, 0x0c, 0x02, 0x57, 0x41, 0x31, 0x10, 0x30, 0x0e, 0x06, 0x03, 0x55,
+  0x04, 0x07, 0x0c, 0x07, 0x53, 0x65, 0x61, 0x74, 0x74, 0x6c, 0x65, 0x31,
+  0x12, 0x30, 0x10, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x09, 0x54, 0x69,
+  0x61, 0x6e, 0x6f, 0x63, 0x6f, 0x72, 0x65, 0x31, 0x0d, 0x30, 0x0b, 0x06,
+  0x03, 0x55, 0x04, 0x0b, 0x0c, 0x04, 0x45, 0x44, 0x4b, 0x32, 0x31, 0x1d,
+  0x30, 0x1b, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x14, 0x55, 0x45, 0x46,
+  0x49, 0x20, 0x49, 0x6e, 0x74, 0x65, 0x72, 0x6d, 0x65, 0x64, 0x69, 0x61,
+  0x74, 0x65, 0x20, 0x43, 0x41, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06,
+  0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00,
+  0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01,
+  0x01, 0x00, 0x9f, 0x03, 0x2f, 0xb7, 0xdc, 0xc2, 0xa7, 0x90, 0x02, 0x7f,
+  0x6c, 0xfa, 0x21, 0xca, 0xc7, 0xb1, 0x80, 0xad, 0x17, 0x44, 0x29, 0x14,
+  0x55, 0x91, 0x59, 0xe2, 0x25, 0xd1, 0xb0, 0x11, 0x54, 0x35, 0xc1, 0x5a,
+  0x8b, 0xe1, 0x4d, 0x10, 0x09, 0x02, 0x78, 0x75, 0x78, 0x41, 0xd7, 0x74,
+  0x95, 0xc9, 0xe3, 0x43, 0x94, 0x76, 0xc2, 0x45, 0xac, 0x5f, 0x20, 0xb8,
+  0x12, 0xb5, 0x6b, 0x63, 0x16, 0x86, 0x79, 0x11, 0x14, 0x3c, 0xb0, 0xfd,
+  0x19, 0x81, 0xcb, 0x42, 0x5b, 0xd7, 0x22, 0x33, 0xc1, 0x19, 0xf4, 0x5a,
+  0x8c, 0xdc, 0x8d, 0xc3, 0xe2, 0x71, 0xda, 0xe9, 0xa8, 0x6e, 0x4e, 0x2c,
+  0x7e, 0x92, 0xeb, 0x07, 0xa4, 0x3e, 0x7a, 0xa3, 0x65, 0x69, 0x64, 0xaf,
+  0x30, 0xc9, 0x5a, 0xde, 0xb5, 0x8a, 0x15, 0xea, 0x75, 0xa9, 0x1c, 0x3f,
+  0xaf, 0x34, 0x24, 0x69, 0x80, 0x06, 0xf0, 0xa8, 0xec, 0x66, 0x97, 0x7c,
+  0x3f, 0x41, 0x62, 0x17, 0xc9, 0xdd, 0xb1, 0x52, 0x86, 0xe5, 0xdd, 0x2d,
+  0xcd, 0x27, 0xf1, 0xca, 0x34, 0xa1, 0x8e, 0xf1, 0x98, 0xae, 0x0f, 0xd2,
+  0x49, 0xbd, 0xe7, 0xeb, 0x25, 0x3b, 0xba, 0x1b, 0x8a, 0x83, 0x23, 0x9e,
+  0xa9, 0xed, 0x48, 0x08, 0x6f, 0xb3, 0x02, 0xbe, 0x77, 0xdb, 0x37, 0x4e,
+  0x71, 0xe3, 0x7f, 0x0b, 0xdc, 0xbb, 0x18, 0x78, 0xc5, 0x43, 0x90, 0x29,
+  0x89, 0x0b, 0x22, 0x19, 0xf7, 0x33, 0xa3, 0xaa, 0x78, 0xed, 0xee, 0xfc,
+  0x3e, 0x85, 0xa6, 0x24, 0x18, 0xf0, 0xe3, 0x9b, 0x18, 0xd9, 0x43, 0x3e,
+  0x34, 0x69, 0xa0, 0x69, 0x71, 0x44, 0x2a, 0xf8, 0xd6, 0xd3, 0xe7, 0x67,
+  0x18, 0x50, 0x17, 0x0b, 0x5e, 0xf1, 0xf4, 0x23, 0x9b, 0x50, 0xbc, 0xe5,
+  0x65, 0xcb, 0xc9, 0xcd, 0xfd, 0x83, 0xc3, 0xa5, 0x09, 0x75, 0x07, 0xc8,
+  0x7e, 0x91, 0xbd, 0xe0, 0x42, 0xab, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3,
+  0x63, 0x30, 0x61, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01,
+  0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06, 0x03,
+  0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06,
+  0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x08,
+  0x02, 0x61, 0x2f, 0xfe, 0xf5, 0x45, 0xba, 0x00, 0x35, 0xa4, 0x2a, 0x52,
+  0x02, 0xc9, 0x93, 0x7e, 0xae, 0x94, 0x15, 0x30, 0x1f, 0x06, 0x03, 0x55,
+  0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x68, 0x7c, 0xe3, 0x6d,
+  0xab, 0x76, 0x8d, 0x39, 0xc1, 0x41, 0xd8, 0x93, 0x99, 0xd9, 0xd6, 0xbe,
+  0xad, 0x91, 0x5d, 0x2a, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86,
+  0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03, 0x82, 0x01, 0x01, 0x00,
+  0x6f, 0x76, 0x87, 0x95, 0x64, 0x0b, 0x08, 0xa0, 0x3d, 0x7d, 0x63, 0x75,
+  0x4b, 0x40, 0xa5, 0xf4, 0xee, 0x94, 0x50, 0xfd, 0xb3, 0x4e, 0x10, 0xdf,
+  0xe1, 0x37, 0x8a, 0xe8, 0xe7, 0x0d, 0x81, 0xb0, 0xb0, 0x4b, 0x21, 0xdb,
+  0xa9, 0x66, 0xba, 0x4e, 0x2a, 0x5f, 0x01, 0x99, 0xbd, 0xc8, 0x4b, 0xce,
+  0x7b, 0xde, 0x58, 0x7d, 0xe9, 0x1a, 0xfd, 0x26, 0x9e, 0xbc, 0x8d, 0x3e,
+  0x30, 0xa6, 0xcc, 0xf9, 0xad, 0x73, 0xb8, 0x39, 0xe3, 0x94, 0x98, 0x36,
+  0x99, 0x5d, 0x1d, 0x9e, 0xf7, 0xb7, 0x43, 0x72, 0xd9, 0x1d, 0xd8, 0x5c,
+  0xa3, 0xf6, 0xe2, 0x31, 0x21, 0x5c, 0x19, 0x9d, 0x6b, 0x8b, 0xf3, 0xd9,
+  0x78, 0x4b, 0x6e, 0x2c, 0xb3, 0x69, 0x55, 0x7c, 0x56, 0xb3, 0x99, 0xd7,
+  0x38, 0xa8, 0x97, 0xc5, 0x6c, 0xca, 0xe7, 0x50, 0x03, 0xb2, 0x7b, 0x48,
+  0x8c, 0x0b, 0x8d, 0xd9, 0x43, 0x99, 0x97, 0xc5, 0x0a, 0x70, 0xf8, 0x72,
+  0xb2, 0x42, 0x4d, 0x05, 0xc8, 0x2b, 0x7d, 0x40, 0xf5, 0x37, 0x51, 0x5e,
+  0x72, 0xae, 0xee, 0xef, 0xca, 0x9b, 0x47, 0xef, 0x2f, 0x52, 0x0a, 0x8a,
+  0xb1, 0xeb, 0x4f, 0xa4, 0xbd, 0xdd, 0x69, 0x9b, 0xa0, 0x9b, 0xce, 0x8b,
+  0xc7, 0x02, 0x79, 0x56, 0x5a, 0x98, 0x13, 0x19, 0xc4, 0x93, 0x82, 0xd9,
+  0xe6, 0x93, 0x25, 0x3d, 0xbc, 0x60, 0xb4, 0xe7, 0x81, 0xea, 0x12, 0xf2,
+  0xd2, 0xbd, 0x74, 0xa3, 0xfb, 0x9e, 0x66, 0x57, 0x28, 0xe1, 0x61, 0x6b,
+  0x40, 0x41, 0x6a, 0x32, 0xa1, 0xce, 0x89, 0x3f, 0xd4, 0xca, 0xb5, 0x93,
+  0x94, 0x68, 0x69, 0x35, 0x14, 0x25, 0x00, 0x96, 0xb0, 0x41, 0xb4, 0xb7,
+  0x6d, 0xd4, 0x34, 0x7b, 0x75, 0x0d, 0xad, 0xdf, 0xf6, 0xbc, 0xba, 0x7c,
+  0x1a, 0x46, 0xb1, 0x3c, 0xdd, 0x85, 0x16, 0x77, 0x61, 0x88, 0x4b, 0x6e,
+  0x22, 0x2d, 0x7d, 0xb3
+};
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  TestChainNoCertSignCACert[] = {
+  0x30, 0x82, 0x03, 0xb4, 0x30, 0x82, 0x02, 0x9c, 0xa0, 0x03, 0x02, 0x01,
+  0x02, 0x02, 0x01, 0x66, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86,
+  0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x66, 0x31, 0x0b, 0x30,
+  0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31, 0x0b,
+  0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x08, 0x0c, 0x02, 0x57, 0x41, 0x31,
+  0x10, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x04, 0x07, 0x0c, 0x07, 0x53, 0x65,
+  0x61, 0x74, 0x74, 0x6c, 0x65, 0x31, 0x12, 0x30, 0x10, 0x06, 0x03, 0x55,
+  0x04, 0x0a, 0x0c, 0x09, 0x54, 0x69, 0x61, 0x6e, 0x6f, 0x63, 0x6f, 0x72,
+  0x65, 0x31, 0x0d, 0x30, 0x0b, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c, 0x04,
+  0x45, 0x44, 0x4b, 0x32, 0x31, 0x15, 0x30, 0x13, 0x06, 0x03, 0x55, 0x04,
+  0x03, 0x0c, 0x0c, 0x55, 0x45, 0x46, 0x49, 0x20, 0x52, 0x6f, 0x6f, 0x74,
+  0x20, 0x43, 0x41, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31,
+  0x39, 0x31, 0x34, 0x32, 0x32, 0x32, 0x32, 0x5a, 0x18, 0x0f, 0x32, 0x31,
+  0x32, 0x36, 0x30, 0x39, 0x32, 0x35, 0x31, 0x34, 0x32, 0x32, 0x32, 0x32,
+  0x5a, 0x30, 0x6e, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06,
+  0x13, 0x02, 0x55, 0x53, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04,
+  0x08, 0x0c, 0x02, 0x57, 0x41, 0x31, 0x10, 0x30, 0x0e, 0x06, 0x03, 0x55,
+  0x04, 0x07, 0x0c, 0x07, 0x53, 0x65, 0x61, 0x74, 0x74, 0x6c, 0x65, 0x31,
+  0x12, 0x30, 0x10, 0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x09, 0x54, 0x69,
+  0x61, 0x6e, 0x6f, 0x63, 0x6f, 0x72, 0x65, 0x31, 0x0d, 0x30, 0x0b, 0x06,
+  0x03, 0x55, 0x04, 0x0b, 0x0c, 0x04, 0x45, 0x44, 0x4b, 0x32, 0x31, 0x1d,
+  0x30, 0x1b, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x14, 0x55, 0x45, 0x46,
+  0x49, 0x20, 0x49, 0x6e, 0x74, 0x65, 0x72, 0x6d, 0x65, 0x64, 0x69, 0x61,
+  0x74, 0x65, 0x20, 0x43, 0x41, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06,
+  0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00,
+  0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01,
+  0x01, 0x00, 0x9f, 0x03, 0x2f, 0xb7, 0xdc, 0xc2, 0xa7, 0x90, 0x02, 0x7f,
+  0x6c, 0xfa, 0x21, 0xca, 0xc7, 0xb1, 0x80, 0xad, 0x17, 0x44, 0x29, 0x14,
+  0x55, 0x91, 0x59, 0xe2, 0x25, 0xd1, 0xb0, 0x11, 0x54, 0x35, 0xc1, 0x5a,
+  0x8b, 0xe1, 0x4d, 0x10, 0x09, 0x02, 0x78, 0x75, 0x78, 0x41, 0xd7, 0x74,
+  0x95, 0xc9, 0xe3, 0x43, 0x94, 0x76, 0xc2, 0x45, 0xac, 0x5f, 0x20, 0xb8,
+  0x12, 0xb5, 0x6b, 0x63, 0x16, 0x86, 0x79, 0x11, 0x14, 0x3c, 0xb0, 0xfd,
+  0x19, 0x81, 0xcb, 0x42, 0x5b, 0xd7, 0x22, 0x33, 0xc1, 0x19, 0xf4, 0x5a,
+  0x8c, 0xdc, 0x8d, 0xc3, 0xe2, 0x71, 0xda, 0xe9, 0xa8, 0x6e, 0x4e, 0x2c,
+  0x7e, 0x92, 0xeb, 0x07, 0xa4, 0x3e, 0x7a, 0xa3, 0x65, 0x69, 0x64, 0xaf,
+  0x30, 0xc9, 0x5a, 0xde, 0xb5, 0x8a, 0x15, 0xea, 0x75, 0xa9, 0x1c, 0x3f,
+  0xaf, 0x34, 0x24, 0x69, 0x80, 0x06, 0xf0, 0xa8, 0xec, 0x66, 0x97, 0x7c,
+  0x3f, 0x41, 0x62, 0x17, 0xc9, 0xdd, 0xb1, 0x52, 0x86, 0xe5, 0xdd, 0x2d,
+  0xcd, 0x27, 0xf1, 0xca, 0x34, 0xa1, 0x8e, 0xf1, 0x98, 0xae, 0x0f, 0xd2,
+  0x49, 0xbd, 0xe7, 0xeb, 0x25, 0x3b, 0xba, 0x1b, 0x8a, 0x83, 0x23, 0x9e,
+  0xa9, 0xed, 0x48, 0x08, 0x6f, 0xb3, 0x02, 0xbe, 0x77, 0xdb, 0x37, 0x4e,
+  0x71, 0xe3, 0x7f, 0x0b, 0xdc, 0xbb, 0x18, 0x78, 0xc5, 0x43, 0x90, 0x29,
+  0x89, 0x0b, 0x22, 0x19, 0xf7, 0x33, 0xa3, 0xaa, 0x78, 0xed, 0xee, 0xfc,
+  0x3e, 0x85, 0xa6, 0x24, 0x18, 0xf0, 0xe3, 0x9b, 0x18, 0xd9, 0x43, 0x3e,
+  0x34, 0x69, 0xa0, 0x69, 0x71, 0x44, 0x2a, 0xf8, 0xd6, 0xd3, 0xe7, 0x67,
+  0x18, 0x50, 0x17, 0x0b, 0x5e, 0xf1, 0xf4, 0x23, 0x9b, 0x50, 0xbc, 0xe5,
+  0x65, 0xcb, 0xc9, 0xcd, 0xfd, 0x83, 0xc3, 0xa5, 0x09, 0x75, 0x07, 0xc8,
+  0x7e, 0x91, 0xbd, 0xe0, 0x42, 0xab, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3,
+  0x63, 0x30, 0x61, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01,
+  0xff, 0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0e, 0x06, 0x03,
+  0x55, 0x1d, 0x0f, 0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x07, 0x80,
+  0x30, 0x1d, 0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x08,
+  0x02, 0x61, 0x2f, 0xfe, 0xf5, 0x45, 0xba, 0x00, 0x35, 0xa4, 0x2a, 0x52,
+  0x02, 0xc9, 0x93, 0x7e, 0xae, 0x94, 0x15, 0x30, 0x1f, 0x06, 0x03, 0x55,
+  0x1d, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x68, 0x7c, 0xe3, 0x6d,
+  0xab, 0x76, 0x8d, 0x39, 0xc1, 0x41, 0xd8, 0x93, 0x99, 0xd9, 0xd6, 0xbe,
+  0xad, 0x91, 0x5d, 0x2a, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86,
+  0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x03, 0x82, 0x01, 0x01, 0x00,
+  0x12, 0xb4, 0xbb, 0xc1, 0x66, 0x0e, 0x52, 0x13, 0xa2, 0xad, 0xb0, 0x98,
+  0x28, 0xdc, 0x8b, 0x16, 0xfe, 0x61, 0x92, 0x78, 0xdd, 0xa3, 0xb1, 0x51,
+  0x73, 0x97, 0x46, 0x8a, 0x16, 0x4d, 0xc2, 0x43, 0x55, 0x9e, 0xad, 0xb5,
+  0x0f, 0x59, 0xf2, 0xc4, 0xaf, 0x3f, 0x49, 0x44, 0x89, 0x15, 0x33, 0x27,
+  0x3e, 0xbf, 0xdd, 0xab, 0x2c, 0x36, 0x99, 0xac, 0x65, 0x47, 0x8e, 0x30,
+  0xba, 0x97, 0xda, 0x5a, 0xdf, 0xc5, 0xda, 0xda, 0x06, 0xad, 0x7e, 0x6f,
+  0x32, 0x7b, 0x35, 0x60, 0x14, 0xf3, 0x51, 0x9b, 0x52, 0x30, 0x77, 0x01,
+  0x6c, 0x56, 0xa9, 0x2a, 0x26, 0xef, 0xbc, 0xa0, 0xae, 0x38, 0x47, 0x31,
+  0xc0, 0x79, 0x34, 0xa6, 0xbb, 0x97, 0xca, 0x24, 0xbf, 0xbe, 0x79, 0xe1,
+  0x70, 0x54, 0xa4, 0xf6, 0x50, 0x38, 0x22, 0xf6, 0xaa, 0x2d, 0xc8, 0xe9,
+  0x80, 0x10, 0x35, 0xa7, 0x16, 0xb6, 0x31, 0xe1, 0x8b, 0xac, 0x89, 0xaa,
+  0x89, 0xc9, 0x39, 0x6a, 0xad, 0xad, 0x88, 0xf5, 0xa6, 0x41, 0xe3, 0xbd,
+  0x6d, 0x34, 0xaf, 0x89, 0xf5, 0x69, 0x21, 0x46, 0x82, 0x57, 0x8e, 0xf9,
+  0x3d, 0x5f, 0x04, 0x91, 0xad, 0x69, 0xf8, 0x71, 0x0c, 0x41, 0xac, 0xe0,
+  0x12, 0xb4, 0xb7, 0xd7, 0xf7, 0x13, 0xc1, 0x67, 0x27, 0x8d, 0x2e, 0x7c,
+  0x4b, 0x57, 0xe3, 0x22, 0x16, 0x7e, 0xfa, 0xbe, 0xc8, 0x3c, 0xff, 0xff,
+  0xf4, 0xcb, 0x7c, 0xc4, 0xd7, 0x45, 0x5f, 0x0a, 0xfc, 0x7a, 0xd2, 0x24,
+  0x0d, 0x4d, 0xd8, 0x36, 0xb0, 0x7b, 0xf3, 0x75, 0xec, 0x59, 0x38, 0x16,
+  0x5c, 0x3a, 0x78, 0x42, 0x84, 0xc0, 0x66, 0xc3, 0x09, 0xfe, 0xe1, 0x21,
+  0x74, 0x78, 0x4d, 0x17, 0x43, 0x2b, 0xfb, 0x58, 0xf0, 0xdf, 0x80, 0x2c,
+  0x0c, 0x05, 0x49, 0x51, 0x1c, 0xe9, 0x18, 0x85, 0xa2, 0x68, 0x36, 0x0c,
+  0x27, 0xd7, 0x42, 0x77
+};
+
+//
+// Password-protected PEM Key data of the signer (encryption key is "client").
+// (Generated by OpenSSL utility).
+// $ openssl genrsa -traditional -aes256 -out TestChainSignerKeyPem -passout pass:client 2048
+// password should match PemPass in this file
+// $ xxd --include TestChainSignerKeyPem
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  TestChainSignerKeyPem[] = {
+  0x2d, 0x2d, 0x2d, 0x2d, 0x2d, 0x42, 0x45, 0x47, 0x49, 0x4e, 0x20, 0x52,
+  0x53, 0x41, 0x20, 0x50, 0x52, 0x49, 0x56, 0x41, 0x54, 0x45, 0x20, 0x4b,
+  0x45, 0x59, 0x2d, 0x2d, 0x2d, 0x2d, 0x2d, 0x0a, 0x50, 0x72, 0x6f, 0x63,
+  0x2d, 0x54, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x34, 0x2c, 0x45, 0x4e, 0x43,
+  0x52, 0x59, 0x50, 0x54, 0x45, 0x44, 0x0a, 0x44, 0x45, 0x4b, 0x2d, 0x49,
+  0x6e, 0x66, 0x6f, 0x3a, 0x20, 0x41, 0x45, 0x53, 0x2d, 0x32, 0x35, 0x36,
+  0x2d, 0x43, 0x42, 0x43, 0x2c, 0x36, 0x31, 0x46, 0x44, 0x34, 0x36, 0x31,
+  0x41, 0x42, 0x38, 0x42, 0x41, 0x45, 0x38, 0x44, 0x38, 0x31, 0x39, 0x44,
+  0x45, 0x42, 0x39, 0x33, 0x34, 0x35, 0x46, 0x39, 0x31, 0x38, 0x39, 0x45,
+  0x46, 0x0a, 0x0a, 0x55, 0x4b, 0x62, 0x54, 0x67, 0x68, 0x33, 0x34, 0x61,
+  0x69, 0x58, 0x36, 0x72, 0x52, 0x55, 0x79, 0x4d, 0x61, 0x46, 0x56, 0x62,
+  0x74, 0x78, 0x66, 0x32, 0x4b, 0x67, 0x35, 0x6c, 0x31, 0x2b, 0x42, 0x4b,
+  0x6e, 0x49, 0x54, 0x34, 0x76, 0x4c, 0x34, 0x52, 0x64, 0x50, 0x34, 0x68,
+  0x49, 0x4c, 0x44, 0x6e, 0x76, 0x6c, 0x76, 0x4b, 0x41, 0x6a, 0x48, 0x2f,
+  0x48, 0x74, 0x52, 0x59, 0x32, 0x7a, 0x66, 0x0a, 0x4c, 0x50, 0x54, 0x78,
+  0x51, 0x45, 0x59, 0x79, 0x50, 0x45, 0x53, 0x33, 0x2f, 0x48, 0x4f, 0x6f,
+  0x46, 0x67, 0x62, 0x43, 0x44, 0x30, 0x52, 0x37, 0x6a, 0x73, 0x6e, 0x42,
+  0x51, 0x47, 0x2f, 0x52, 0x49, 0x59, 0x6a, 0x66, 0x79, 0x6e, 0x68, 0x45,
+  0x4d, 0x79, 0x4c, 0x4b, 0x32, 0x74, 0x4f, 0x2f, 0x39, 0x6c, 0x61, 0x32,
+  0x6f, 0x58, 0x2f, 0x75, 0x33, 0x4d, 0x2f, 0x35, 0x36, 0x34, 0x75, 0x74,
+  0x0a, 0x52, 0x79, 0x78, 0x6d, 0x69, 0x44, 0x4e, 0x38, 0x37, 0x42, 0x34,
+  0x6b, 0x45, 0x41, 0x30, 0x49, 0x65, 0x33, 0x77, 0x71, 0x34, 0x42, 0x72,
+  0x33, 0x67, 0x7a, 0x58, 0x65, 0x38, 0x54, 0x54, 0x2b, 0x6b, 0x41, 0x6a,
+  0x42, 0x42, 0x6f, 0x6b, 0x65, 0x54, 0x78, 0x48, 0x42, 0x4b, 0x37, 0x4f,
+  0x34, 0x4a, 0x46, 0x4b, 0x64, 0x37, 0x31, 0x6d, 0x4d, 0x78, 0x48, 0x71,
+  0x50, 0x64, 0x5a, 0x6d, 0x37, 0x0a, 0x6b, 0x77, 0x64, 0x57, 0x44, 0x38,
+  0x6d, 0x45, 0x4b, 0x33, 0x75, 0x72, 0x48, 0x52, 0x66, 0x6e, 0x4b, 0x76,
+  0x52, 0x4f, 0x39, 0x43, 0x72, 0x34, 0x61, 0x6f, 0x37, 0x31, 0x46, 0x73,
+  0x6b, 0x55, 0x36, 0x2f, 0x39, 0x45, 0x2b, 0x2b, 0x64, 0x63, 0x57, 0x6c,
+  0x67, 0x49, 0x68, 0x33, 0x5a, 0x4d, 0x6e, 0x43, 0x4a, 0x51, 0x75, 0x59,
+  0x32, 0x63, 0x4b, 0x34, 0x7a, 0x64, 0x39, 0x73, 0x57, 0x6a, 0x0a, 0x49,
+  0x72, 0x50, 0x74, 0x76, 0x66, 0x2b, 0x52, 0x6d, 0x6f, 0x61, 0x52, 0x61,
+  0x4b, 0x58, 0x44, 0x64, 0x34, 0x35, 0x33, 0x32, 0x56, 0x45, 0x32, 0x41,
+  0x77, 0x75, 0x6a, 0x49, 0x52, 0x52, 0x56, 0x57, 0x4d, 0x48, 0x49, 0x77,
+  0x39, 0x6c, 0x54, 0x61, 0x4f, 0x6a, 0x7a, 0x47, 0x58, 0x4f, 0x77, 0x41,
+  0x6e, 0x67, 0x46, 0x4f, 0x64, 0x53, 0x59, 0x67, 0x2f, 0x68, 0x64, 0x70,
+  0x30, 0x65, 0x6d, 0x0a, 0x36, 0x4e, 0x46, 0x62, 0x64, 0x58, 0x2f, 0x58,
+  0x6f, 0x65, 0x72, 0x34, 0x4d, 0x37, 0x5a, 0x71, 0x6e, 0x73, 0x56, 0x47,
+  0x65, 0x54, 0x48, 0x65, 0x57, 0x52, 0x6f, 0x42, 0x7a, 0x72, 0x32, 0x38,
+  0x4f, 0x4c, 0x63, 0x39, 0x50, 0x2f, 0x69, 0x34, 0x63, 0x37, 0x38, 0x6c,
+  0x59, 0x43, 0x64, 0x75, 0x6c, 0x73, 0x70, 0x74, 0x71, 0x51, 0x43, 0x52,
+  0x46, 0x41, 0x68, 0x77, 0x4d, 0x72, 0x2b, 0x56, 0x0a, 0x4a, 0x58, 0x59,
+  0x32, 0x61, 0x48, 0x6a, 0x52, 0x75, 0x31, 0x41, 0x72, 0x2f, 0x58, 0x38,
+  0x4a, 0x70, 0x6c, 0x49, 0x74, 0x58, 0x56, 0x64, 0x43, 0x77, 0x4b, 0x34,
+  0x4a, 0x43, 0x6d, 0x35, 0x79, 0x41, 0x58, 0x4c, 0x41, 0x34, 0x44, 0x62,
+  0x35, 0x34, 0x33, 0x72, 0x5a, 0x64, 0x65, 0x71, 0x55, 0x6c, 0x52, 0x48,
+  0x35, 0x78, 0x4d, 0x4b, 0x4c, 0x67, 0x51, 0x58, 0x51, 0x58, 0x53, 0x54,
+  0x38, 0x0a, 0x6b, 0x44, 0x6a, 0x6f, 0x6e, 0x4a, 0x38, 0x75, 0x78, 0x43,
+  0x33, 0x73, 0x56, 0x69, 0x75, 0x64, 0x78, 0x52, 0x59, 0x2b, 0x42, 0x48,
+  0x35, 0x75, 0x66, 0x6a, 0x54, 0x70, 0x67, 0x47, 0x5a, 0x58, 0x31, 0x51,
+  0x59, 0x6f, 0x5a, 0x6c, 0x75, 0x2f, 0x4e, 0x37, 0x30, 0x55, 0x69, 0x34,
+  0x54, 0x54, 0x53, 0x63, 0x48, 0x33, 0x67, 0x6d, 0x73, 0x6a, 0x6a, 0x66,
+  0x52, 0x39, 0x2b, 0x58, 0x76, 0x7a, 0x0a, 0x46, 0x41, 0x37, 0x5a, 0x2f,
+  0x38, 0x6a, 0x44, 0x2f, 0x50, 0x6c, 0x52, 0x4b, 0x4b, 0x6d, 0x63, 0x41,
+  0x69, 0x65, 0x64, 0x77, 0x46, 0x62, 0x79, 0x72, 0x45, 0x37, 0x4b, 0x7a,
+  0x64, 0x66, 0x71, 0x39, 0x71, 0x64, 0x36, 0x36, 0x66, 0x76, 0x54, 0x58,
+  0x58, 0x64, 0x78, 0x51, 0x63, 0x70, 0x51, 0x43, 0x44, 0x6a, 0x79, 0x6e,
+  0x41, 0x2b, 0x41, 0x70, 0x30, 0x38, 0x59, 0x32, 0x44, 0x56, 0x76, 0x0a,
+  0x66, 0x4c, 0x5a, 0x53, 0x72, 0x76, 0x68, 0x65, 0x37, 0x76, 0x5a, 0x58,
+  0x6f, 0x56, 0x4a, 0x75, 0x77, 0x55, 0x2f, 0x79, 0x48, 0x62, 0x4e, 0x37,
+  0x54, 0x4f, 0x49, 0x47, 0x38, 0x32, 0x75, 0x66, 0x61, 0x4a, 0x6c, 0x54,
+  0x6f, 0x63, 0x42, 0x39, 0x66, 0x2b, 0x77, 0x6a, 0x34, 0x4d, 0x62, 0x62,
+  0x55, 0x44, 0x33, 0x43, 0x61, 0x36, 0x4c, 0x50, 0x45, 0x47, 0x30, 0x59,
+  0x37, 0x7a, 0x53, 0x31, 0x0a, 0x6b, 0x76, 0x6a, 0x73, 0x57, 0x71, 0x53,
+  0x7a, 0x32, 0x70, 0x49, 0x4c, 0x4d, 0x38, 0x54, 0x58, 0x2b, 0x4c, 0x63,
+  0x38, 0x69, 0x76, 0x6c, 0x4c, 0x64, 0x6b, 0x47, 0x37, 0x73, 0x6c, 0x46,
+  0x6a, 0x42, 0x31, 0x71, 0x38, 0x41, 0x4e, 0x6a, 0x31, 0x49, 0x48, 0x58,
+  0x41, 0x52, 0x43, 0x70, 0x59, 0x57, 0x64, 0x52, 0x61, 0x77, 0x39, 0x67,
+  0x46, 0x55, 0x33, 0x32, 0x74, 0x71, 0x58, 0x6d, 0x77, 0x0a, 0x70, 0x76,
+  0x69, 0x67, 0x61, 0x30, 0x61, 0x79, 0x68, 0x2b, 0x70, 0x68, 0x51, 0x47,
+  0x6d, 0x49, 0x6d, 0x2b, 0x69, 0x43, 0x78, 0x43, 0x65, 0x69, 0x4a, 0x53,
+  0x72, 0x37, 0x30, 0x4a, 0x32, 0x39, 0x69, 0x54, 0x50, 0x52, 0x68, 0x58,
+  0x55, 0x6f, 0x64, 0x48, 0x33, 0x51, 0x62, 0x57, 0x73, 0x65, 0x6c, 0x6f,
+  0x65, 0x37, 0x56, 0x5a, 0x50, 0x4e, 0x5a, 0x46, 0x4c, 0x6e, 0x78, 0x30,
+  0x67, 0x62, 0x0a, 0x6c, 0x79, 0x4d, 0x63, 0x31, 0x65, 0x36, 0x76, 0x44,
+  0x35, 0x63, 0x43, 0x36, 0x4d, 0x63, 0x73, 0x6e, 0x39, 0x67, 0x69, 0x75,
+  0x2f, 0x63, 0x50, 0x43, 0x56, 0x35, 0x65, 0x63, 0x68, 0x77, 0x62, 0x76,
+  0x41, 0x4f, 0x49, 0x6a, 0x68, 0x45, 0x70, 0x69, 0x45, 0x52, 0x6c, 0x4b,
+  0x4f, 0x7a, 0x6f, 0x2f, 0x66, 0x47, 0x51, 0x6f, 0x6c, 0x4e, 0x6d, 0x6e,
+  0x30, 0x4e, 0x4d, 0x59, 0x38, 0x79, 0x4d, 0x0a, 0x4c, 0x6f, 0x56, 0x4e,
+  0x70, 0x39, 0x2b, 0x59, 0x37, 0x42, 0x45, 0x4e, 0x59, 0x49, 0x51, 0x59,
+  0x4a, 0x67, 0x63, 0x59, 0x49, 0x50, 0x44, 0x69, 0x31, 0x73, 0x66, 0x75,
+  0x37, 0x41, 0x68, 0x36, 0x45, 0x4d, 0x68, 0x75, 0x55, 0x6d, 0x31, 0x38,
+  0x64, 0x67, 0x76, 0x36, 0x4a, 0x64, 0x79, 0x77, 0x62, 0x6b, 0x6e, 0x71,
+  0x72, 0x54, 0x67, 0x67, 0x59, 0x43, 0x74, 0x78, 0x67, 0x6b, 0x6c, 0x64,
+  0x0a, 0x7a, 0x6d, 0x51, 0x6d, 0x54, 0x69, 0x72, 0x71, 0x64, 0x2b, 0x54,
+  0x45, 0x61, 0x59, 0x74, 0x46, 0x58, 0x64, 0x2b, 0x42, 0x36, 0x4b, 0x68,
+  0x49, 0x42, 0x51, 0x51, 0x52, 0x37, 0x2f, 0x75, 0x46, 0x53, 0x44, 0x47,
+  0x6d, 0x4c, 0x46, 0x34, 0x72, 0x76, 0x64, 0x79, 0x4b, 0x34, 0x6f, 0x56,
+  0x6e, 0x68, 0x6b, 0x6f, 0x55, 0x76, 0x74, 0x76, 0x52, 0x61, 0x34, 0x6a,
+  0x71, 0x4d, 0x54, 0x79, 0x61, 0x0a, 0x30, 0x76, 0x48, 0x4c, 0x56, 0x53,
+  0x6e, 0x64, 0x77, 0x50, 0x56, 0x70, 0x62, 0x5a, 0x53, 0x49, 0x4a, 0x30,
+  0x6a, 0x51, 0x39, 0x72, 0x41, 0x64, 0x48, 0x6a, 0x78, 0x69, 0x30, 0x47,
+  0x33, 0x56, 0x39, 0x6e, 0x43, 0x41, 0x55, 0x57, 0x4d, 0x7a, 0x5a, 0x55,
+  0x56, 0x74, 0x31, 0x48, 0x70, 0x39, 0x6e, 0x7a, 0x4d, 0x4d, 0x4b, 0x7a,
+  0x59, 0x54, 0x5a, 0x42, 0x32, 0x72, 0x4d, 0x37, 0x31, 0x53, 0x0a, 0x48,
+  0x36, 0x30, 0x68, 0x4b, 0x36, 0x56, 0x65, 0x73, 0x50, 0x72, 0x2b, 0x34,
+  0x53, 0x6e, 0x73, 0x31, 0x38, 0x6b, 0x66, 0x62, 0x6c, 0x70, 0x49, 0x6c,
+  0x68, 0x6d, 0x55, 0x70, 0x7a, 0x73, 0x71, 0x6b, 0x67, 0x59, 0x4e, 0x37,
+  0x34, 0x49, 0x6a, 0x38, 0x71, 0x75, 0x4c, 0x58, 0x4b, 0x65, 0x42, 0x77,
+  0x63, 0x31, 0x42, 0x6f, 0x53, 0x56, 0x66, 0x4d, 0x6a, 0x73, 0x6c, 0x74,
+  0x4f, 0x5a, 0x42, 0x0a, 0x49, 0x64, 0x48, 0x2f, 0x30, 0x36, 0x48, 0x78,
+  0x63, 0x58, 0x6c, 0x63, 0x32, 0x45, 0x49, 0x56, 0x6a, 0x69, 0x68, 0x71,
+  0x34, 0x61, 0x75, 0x45, 0x65, 0x74, 0x42, 0x50, 0x42, 0x75, 0x39, 0x55,
+  0x32, 0x38, 0x79, 0x54, 0x52, 0x38, 0x5a, 0x79, 0x2f, 0x51, 0x65, 0x41,
+  0x79, 0x66, 0x45, 0x4c, 0x47, 0x37, 0x47, 0x70, 0x52, 0x6e, 0x53, 0x79,
+  0x62, 0x36, 0x69, 0x46, 0x33, 0x78, 0x46, 0x47, 0x0a, 0x53, 0x73, 0x63,
+  0x59, 0x43, 0x63, 0x32, 0x4e, 0x33, 0x59, 0x4e, 0x39, 0x4a, 0x5a, 0x52,
+  0x34, 0x71, 0x64, 0x6d, 0x4d, 0x35, 0x59, 0x56, 0x61, 0x6e, 0x68, 0x6a,
+  0x4d, 0x77, 0x43, 0x51, 0x72, 0x70, 0x33, 0x73, 0x6c, 0x79, 0x75, 0x70,
+  0x7a, 0x5a, 0x45, 0x48, 0x4a, 0x71, 0x35, 0x31, 0x72, 0x48, 0x68, 0x6d,
+  0x7a, 0x46, 0x55, 0x36, 0x62, 0x30, 0x6e, 0x6f, 0x45, 0x45, 0x4a, 0x6b,
+  0x74, 0x0a, 0x65, 0x6f, 0x4a, 0x36, 0x76, 0x78, 0x32, 0x54, 0x6d, 0x77,
+  0x4e, 0x67, 0x74, 0x72, 0x4b, 0x63, 0x69, 0x4b, 0x39, 0x77, 0x54, 0x2f,
+  0x44, 0x75, 0x41, 0x35, 0x2f, 0x7a, 0x59, 0x38, 0x61, 0x69, 0x74, 0x6a,
+  0x67, 0x73, 0x69, 0x79, 0x70, 0x32, 0x69, 0x55, 0x2b, 0x61, 0x4a, 0x69,
+  0x76, 0x42, 0x61, 0x73, 0x59, 0x43, 0x6e, 0x4e, 0x4e, 0x6a, 0x2f, 0x58,
+  0x38, 0x54, 0x68, 0x72, 0x57, 0x68, 0x0a, 0x73, 0x42, 0x62, 0x57, 0x73,
+  0x33, 0x57, 0x48, 0x62, 0x35, 0x41, 0x32, 0x70, 0x48, 0x4e, 0x2b, 0x43,
+  0x65, 0x73, 0x31, 0x71, 0x51, 0x6e, 0x64, 0x4b, 0x73, 0x66, 0x56, 0x4d,
+  0x70, 0x4a, 0x77, 0x30, 0x53, 0x78, 0x47, 0x49, 0x55, 0x56, 0x36, 0x35,
+  0x66, 0x4f, 0x32, 0x57, 0x65, 0x6d, 0x64, 0x51, 0x67, 0x45, 0x64, 0x78,
+  0x77, 0x61, 0x49, 0x5a, 0x31, 0x31, 0x6b, 0x35, 0x70, 0x76, 0x6e, 0x0a,
+  0x70, 0x73, 0x76, 0x5a, 0x76, 0x72, 0x48, 0x61, 0x45, 0x44, 0x2b, 0x4d,
+  0x64, 0x2b, 0x4c, 0x33, 0x35, 0x35, 0x75, 0x58, 0x2f, 0x47, 0x37, 0x76,
+  0x59, 0x30, 0x68, 0x6d, 0x55, 0x39, 0x72, 0x32, 0x75, 0x72, 0x30, 0x6e,
+  0x6f, 0x74, 0x55, 0x37, 0x6d, 0x2b, 0x75, 0x6a, 0x68, 0x62, 0x79, 0x4e,
+  0x33, 0x78, 0x52, 0x76, 0x36, 0x2f, 0x74, 0x77, 0x2f, 0x69, 0x37, 0x4a,
+  0x74, 0x77, 0x2f, 0x49, 0x0a, 0x4f, 0x56, 0x70, 0x48, 0x36, 0x75, 0x4b,
+  0x68, 0x68, 0x72, 0x37, 0x46, 0x4b, 0x42, 0x4e, 0x78, 0x72, 0x32, 0x2b,
+  0x4b, 0x36, 0x61, 0x33, 0x75, 0x53, 0x4c, 0x34, 0x47, 0x52, 0x7a, 0x70,
+  0x32, 0x65, 0x70, 0x44, 0x6f, 0x79, 0x38, 0x45, 0x46, 0x49, 0x6d, 0x33,
+  0x2f, 0x6f, 0x52, 0x56, 0x6d, 0x6f, 0x79, 0x39, 0x69, 0x6c, 0x43, 0x54,
+  0x78, 0x39, 0x7a, 0x2b, 0x35, 0x6a, 0x46, 0x59, 0x79, 0x0a, 0x75, 0x69,
+  0x63, 0x38, 0x6f, 0x65, 0x6b, 0x30, 0x6e, 0x4f, 0x76, 0x43, 0x47, 0x4c,
+  0x38, 0x4d, 0x77, 0x66, 0x69, 0x47, 0x72, 0x67, 0x7a, 0x6f, 0x74, 0x73,
+  0x66, 0x71, 0x7a, 0x51, 0x71, 0x56, 0x5a, 0x43, 0x51, 0x51, 0x41, 0x71,
+  0x61, 0x51, 0x61, 0x2f, 0x71, 0x49, 0x4a, 0x75, 0x62, 0x53, 0x4e, 0x70,
+  0x2f, 0x30, 0x6e, 0x70, 0x4a, 0x65, 0x59, 0x51, 0x58, 0x44, 0x31, 0x47,
+  0x36, 0x63, 0x0a, 0x45, 0x44, 0x2b, 0x30, 0x39, 0x46, 0x4d, 0x65, 0x48,
+  0x46, 0x57, 0x64, 0x78, 0x4c, 0x6b, 0x37, 0x4d, 0x39, 0x43, 0x49, 0x6e,
+  0x31, 0x43, 0x67, 0x6d, 0x69, 0x35, 0x79, 0x58, 0x56, 0x68, 0x71, 0x57,
+  0x35, 0x66, 0x65, 0x47, 0x55, 0x41, 0x4a, 0x73, 0x74, 0x32, 0x6f, 0x77,
+  0x34, 0x4a, 0x63, 0x4b, 0x66, 0x47, 0x30, 0x62, 0x39, 0x45, 0x34, 0x55,
+  0x4b, 0x66, 0x31, 0x37, 0x31, 0x59, 0x49, 0x0a, 0x2d, 0x2d, 0x2d, 0x2d,
+  0x2d, 0x45, 0x4e, 0x44, 0x20, 0x52, 0x53, 0x41, 0x20, 0x50, 0x52, 0x49,
+  0x56, 0x41, 0x54, 0x45, 0x20, 0x4b, 0x45, 0x59, 0x2d, 0x2d, 0x2d, 0x2d,
+  0x2d, 0x0a
+};
+
+//
+// Signer X509 Certificate issued by the intermediate CA (Generated by OpenSSL utility).
+// $ openssl req -new -key TestChainSignerKeyPem -subj "/C=US/ST=WA/L=Seattle/O=Tianocore/OU=EDK2/CN=UEFI Signer" -out TestChainSignerCsr
+// $ openssl x509 -req -days 36500 -CA TestChainCACert.pem -CAkey TestChainCAKey -set_serial 201 -extfile ext.cnf -extensions signer -in TestChainSignerCsr -outform DER -out TestChainSignerCert
+// $ xxd --include TestChainSignerCert
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8  TestChainSignerCert[] = {
+  0x30, 0x82, 0x03, 0xb1, 0x30, 0x82, 0x02, 0x99, 0xa0, 0x03, 0x02, 0x01,
+  0x02, 0x02, 0x02, 0x00, 0xc9, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48,
+  0x86, 0xf7, 0x0d, 0x01, 0x01, 0x0b, 0x05, 0x00, 0x30, 0x6e, 0x31, 0x0b,
+  0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55, 0x53, 0x31,
+  0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x08, 0x0c, 0x02, 0x57, 0x41,
+  0x31, 0x10, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x04, 0x07, 0x0c, 0x07, 0x53,
+  0x65, 0x61, 0x74, 0x74, 0x6c, 0x65, 0x31, 0x12, 0x30, 0x10, 0x06, 0x03,
+  0x55, 0x04, 0x0a, 0x0c, 0x09, 0x54, 0x69, 0x61, 0x6e, 0x6f, 0x63, 0x6f,
+  0x72, 0x65, 0x31, 0x0d, 0x30, 0x0b, 0x06, 0x03, 0x55, 0x04, 0x0b, 0x0c,
+  0x04, 0x45, 0x44, 0x4b, 0x32, 0x31, 0x1d, 0x30, 0x1b, 0x06, 0x03, 0x55,
+  0x04, 0x03, 0x0c, 0x14, 0x55, 0x45, 0x46, 0x49, 0x20, 0x49, 0x6e, 0x74,
+  0x65, 0x72, 0x6d, 0x65, 0x64, 0x69, 0x61, 0x74, 0x65, 0x20, 0x43, 0x41,
+  0x30, 0x20, 0x17, 0x0d, 0x32, 0x36, 0x31, 0x30, 0x31, 0x39, 0x31, 0x34,
+  0x32, 0x32, 0x32, 0x32, 0x5a, 0x18, 0x0f, 0x32, 0x31, 0x32, 0x36, 0x30,
+  0x39, 0x32, 0x35, 0x31, 0x34, 0x32, 0x32, 0x32, 0x32, 0x5a, 0x30, 0x65,
+  0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x06, 0x13, 0x02, 0x55,
+  0x53, 0x31, 0x0b, 0x30, 0x09, 0x06, 0x03, 0x55, 0x04, 0x08, 0x0c, 0x02,
+  0x57, 0x41, 0x31, 0x10, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x04, 0x07, 0x0c,
+  0x07, 0x53, 0x65, 0x61, 0x74, 0x74, 0x6c, 0x65, 0x31, 0x12, 0x30, 0x10,
+  0x06, 0x03, 0x55, 0x04, 0x0a, 0x0c, 0x09, 0x54, 0x69, 0x61, 0x6e, 0x6f,
+  0x63, 0x6f, 0x72, 0x65, 0x31, 0x0d, 0x30, 0x0b, 0x06, 0x03, 0x55, 0x04,
+  0x0b, 0x0c, 0x04, 0x45, 0x44, 0x4b, 0x32, 0x31, 0x14, 0x30, 0x12, 0x06,
+  0x03, 0x55, 0x04, 0x03, 0x0c, 0x0b, 0x55, 0x45, 0x46, 0x49, 0x20, 0x53,
+  0x69, 0x67, 0x6e, 0x65, 0x72, 0x30, 0x82, 0x01, 0x22, 0x30, 0x0d, 0x06,
+  0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x01, 0x01, 0x05, 0x00,
+  0x03, 0x82, 0x01, 0x0f, 0x00, 0x30, 0x82, 0x01, 0x0a, 0x02, 0x82, 0x01,
+  0x01, 0x00, 0xb1, 0x8b, 0x67, 0x39, 0x7f, 0x84, 0xdd, 0xdb, 0x42, 0x6f,
+  0x79, 0xb6, 0x99, 0x31, 0x97, 0x3c, 0x19, 0xff, 0xd4, 0x01, 0xf1, 0x02,
+  0xea, 0x8c, 0x1c, 0xfc, 0x81, 0x76, 0xc2, 0xfa, 0xf6, 0x7b, 0xbe, 0xaa,
+  0xcb, 0x3c, 0x5d, 0xac, 0xef, 0xde, 0xe1, 0x9b, 0x52, 0xba, 0x60, 0x3f,
+  0x6f, 0x0f, 0x1b, 0xd9, 0x85, 0x70, 0xa9, 0xba, 0x64, 0x1b, 0x93, 0xc2,
+  0x2d, 0x5a, 0x77, 0xc5, 0xfc, 0x58, 0xd6, 0x44, 0x1b, 0x5d, 0x10, 0xdf,
+  0xf8, 0xc2, 0x1c, 0xe3, 0x10, 0xab, 0x4f, 0x7e, 0xa8, 0x95, 0x98, 0xbb,
+  0xc8, 0x8a, 0x28, 0xc0, 0xe5, 0xfb, 0x05, 0x61, 0x84, 0xbd, 0xa0, 0xc3,
+  0x13, 0xc8, 0x4a, 0x91, 0xbe, 0xe9, 0xdf, 0xb4, 0x5b, 0x9a, 0x14, 0xe7,
+  0xf5, 0x32, 0x1e, 0xfe, 0xca, 0x8c, 0x56, 0x9d, 0x12, 0xf4, 0xbb, 0xa3,
+  0xf3, 0x89, 0x9e, 0xb3, 0x20, 0x82, 0x05, 0xac, 0x3a, 0xd2, 0xa6, 0xab,
+  0x57, 0xbc, 0xae, 0x58, 0x98, 0x2a, 0x0c, 0x05, 0x78, 0xf3, 0x21, 0xd1,
+  0x50, 0x92, 0x2c, 0x30, 0xed, 0xa7, 0x5f, 0x4a, 0xc8, 0x6e, 0x67, 0xae,
+  0x0f, 0xdd, 0xb1, 0xcb, 0xfd, 0x79, 0xa1, 0x9d, 0xa1, 0xc2, 0x7e, 0xb1,
+  0x17, 0x10, 0xb0, 0x83, 0x0c, 0xdd, 0x6e, 0x1f, 0xa9, 0x92, 0x75, 0x3f,
+  0x9d, 0x6c, 0x30, 0x67, 0x1a, 0xd2, 0x21, 0x6b, 0xbb, 0x8d, 0x25, 0x34,
+  0xca, 0x6b, 0xbc, 0x97, 0xe0, 0x6e, 0x63, 0x08, 0x32, 0x88, 0x99, 0xec,
+  0xb6, 0x28, 0x5d, 0x3b, 0x47, 0xca, 0xb7, 0xd7, 0x1c, 0xd9, 0xe0, 0xe8,
+  0x1a, 0x1c, 0x75, 0x96, 0x7f, 0x8c, 0xd8, 0x2f, 0x19, 0xba, 0x63, 0x23,
+  0xc2, 0x2a, 0x9a, 0x63, 0x6d, 0xa7, 0x69, 0x4e, 0x17, 0x4d, 0x48, 0xa9,
+  0x4a, 0xf0, 0xf8, 0xdf, 0xa0, 0x36, 0x03, 0x01, 0x55, 0x47, 0x68, 0xe3,
+  0x02, 0x7e, 0xbd, 0xe6, 0xb7, 0x15, 0x02, 0x03, 0x01, 0x00, 0x01, 0xa3,
+  0x60, 0x30, 0x5e, 0x30, 0x0c, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01,
+  0xff, 0x04, 0x02, 0x30, 0x00, 0x30, 0x0e, 0x06, 0x03, 0x55, 0x1d, 0x0f,
+  0x01, 0x01, 0xff, 0x04, 0x04, 0x03, 0x02, 0x07, 0x80, 0x30, 0x1d, 0x06,
+  0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x8c, 0x1e, 0xec, 0xff,
+  0x1a, 0xa1, 0x8d, 0x83, 0x98, 0x0e, 0x66, 0xbc, 0x51, 0xe4, 0x3f, 0xb2,
+  0x0f, 0x34, 0x28, 0xf2, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23, 0x04,
+  0x18, 0x30, 0x16, 0x80, 0x14, 0x08, 0x02, 0x61, 0x2f, 0xfe, 0xf5, 0x45,
+  0xba, 0x00, 0x35, 0xa4, 0x2a, 0x52, 0x02, 0xc9, 0x93, 0x7e, 0xae, 0x94,
+  0x15, 0x30, 0x0d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01,
+  0x01, 0x0b, 0x05, 0x00, 0x03, 0x82, 0x01, 0x01, 0x00, 0x29, 0x88, 0xb1,
+  0xfd, 0x10, 0x90, 0x9a, 0x4b, 0x39, 0x58, 0xef, 0x22, 0x04, 0xe6, 0xf0,
+  0x2a, 0x7d, 0xe4, 0xfc, 0x69, 0xde, 0xb4, 0x0f, 0x5a, 0x96, 0xad, 0x6b,
+  0x31, 0xfc, 0xd3, 0xbd, 0x0c, 0x99, 0xcb, 0x92, 0xad, 0x6c, 0x24, 0x8d,
+  0x12, 0x6b, 0xfa, 0x60, 0x3d, 0x9a, 0x64, 0x91, 0xf8, 0x7d, 0x2f, 0xcd,
+  0xdc, 0x0f, 0xb0, 0x44, 0x41, 0xc4, 0x56, 0x74, 0x42, 0xfd, 0x22, 0xb1,
+  0x9b, 0x6c, 0xc5, 0x9b, 0x26, 0x37, 0x6e, 0x47, 0x0c, 0xe6, 0xb4, 0x09,
+  0x3a, 0x09, 0x0e, 0x01, 0x23, 0x29, 0x55, 0x98, 0xec, 0x32, 0xa6, 0xfa,
+  0x8b, 0x43, 0x98, 0x2f, 0x4f, 0x00, 0x56, 0x4d, 0xae, 0x08, 0xd8, 0x90,
+  0xb4, 0xe6, 0xd9, 0x24, 0x16, 0xbf, 0xc2, 0x38, 0x43, 0x7a, 0x66, 0x55,
+  0xb5, 0x46, 0xbe, 0x63, 0x6f, 0x09, 0x21, 0xfb, 0xa4, 0x87, 0xa6, 0x50,
+  0xa5, 0xce, 0x96, 0x01, 0x71, 0x22, 0xc9, 0x5e, 0x71, 0x81, 0xc1, 0x50,
+  0xe6, 0xb5, 0xa8, 0xbd, 0x3d, 0x3e, 0x91, 0x1e, 0x9f, 0x0c, 0xec, 0x8e,
+  0xa0, 0x9f, 0xa7, 0xea, 0x40, 0x66, 0xd0, 0xe7, 0x4a, 0x6e, 0x13, 0xf9,
+  0x9b, 0x81, 0x4b, 0x69, 0xe7, 0xe8, 0x74, 0x62, 0xef, 0x29, 0xdc, 0x3a,
+  0xc1, 0x3c, 0xe9, 0xb8, 0x07, 0x68, 0xed, 0x86, 0x78, 0x4a, 0x3e, 0xad,
+  0xbd, 0xec, 0x80, 0x87, 0x19, 0x40, 0x9c, 0xcb, 0x9d, 0xb3, 0xcf, 0xf9,
+  0x9f, 0x7c, 0x56, 0xbc, 0x3c, 0x4e, 0x18, 0x22, 0x83, 0x06, 0xac, 0xff,
+  0xe9, 0xd5, 0x36, 0x62, 0x99, 0xa2, 0x34, 0x3a, 0x63, 0x8a, 0x4c, 0x7e,
+  0x1a, 0xc0, 0x14, 0x1f, 0x6d, 0x77, 0xc6, 0x81, 0xdf, 0xb8, 0xb5, 0xa0,
+  0x8e, 0x7a, 0x16, 0x09, 0x41, 0x8e, 0x8b, 0x32, 0x04, 0xda, 0xf5, 0x98,
+  0x20, 0x4b, 0xad, 0xc5, 0xfc, 0x7d, 0x4d, 0xde, 0xa4, 0x2d, 0xf4, 0xd4,
+  0x21
+};
+
 //
 // Message Hash for Signing & Verification Validation.
 //
@@ -650,6 +1170,98 @@ TestVerifyPkcs7SignVerifyNonSelfIssued (
   return UNIT_TEST_PASSED;
 }
 
+/**
+  Sign Payload with the TestCase3 signer, including the given intermediate CA
+  in the signature, and verify the signature against the root CA.
+
+  @param[in]  CACert          DER-encoded intermediate CA certificate.
+  @param[in]  CACertSize      Size of CACert in bytes.
+  @param[in]  ExpectVerified  Expected result of Pkcs7Verify().
+
+**/
+STATIC
+UNIT_TEST_STATUS
+SignAndVerifyWithCA (
+  IN CONST UINT8  *CACert,
+  IN UINTN        CACertSize,
+  IN BOOLEAN      ExpectVerified
+  )
+{
+  BOOLEAN  Status;
+  UINT8    *P7SignedData;
+  UINTN    P7SignedDataSize;
+  UINT8    *SignCert;
+  UINT8    *OtherCerts;
+
+  P7SignedData = NULL;
+  SignCert     = NULL;
+  OtherCerts   = NULL;
+
+  Status = X509ConstructCertificate (TestChainSignerCert, sizeof (TestChainSignerCert), (UINT8 **)&SignCert);
+  UT_ASSERT_TRUE (Status);
+  UT_ASSERT_NOT_NULL (SignCert);
+
+  Status = X509ConstructCertificateStack (&OtherCerts, CACert, CACertSize, NULL);
+  UT_ASSERT_TRUE (Status);
+  UT_ASSERT_NOT_NULL (OtherCerts);
+
+  Status = Pkcs7Sign (
+             TestChainSignerKeyPem,
+             sizeof (TestChainSignerKeyPem),
+             (CONST UINT8 *)PemPass,
+             (UINT8 *)Payload,
+             AsciiStrLen (Payload),
+             SignCert,
+             OtherCerts,
+             &P7SignedData,
+             &P7SignedDataSize
+             );
+  UT_ASSERT_TRUE (Status);
+  UT_ASSERT_NOT_EQUAL (P7SignedDataSize, 0);
+
+  Status = Pkcs7Verify (
+             P7SignedData,
+             P7SignedDataSize,
+             TestChainRootCert,
+             sizeof (TestChainRootCert),
+             (UINT8 *)Payload,
+             AsciiStrLen (Payload)
+             );
+  UT_ASSERT_EQUAL (Status, ExpectVerified);
+
+  FreePool (P7SignedData);
+  X509StackFree (OtherCerts);
+  X509Free (SignCert);
+
+  return UNIT_TEST_PASSED;
+}
+
+//
+// TestCase3: Intermediate CA whose key usage does not allow certificate signing
+// A chain through such a CA is rejected, also after the same chain has been
+// verified through a CA with the same key that may sign certificates.
+//
+UNIT_TEST_STATUS
+EFIAPI
+TestVerifyPkcs7NoCertSignIntermediate (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UNIT_TEST_STATUS  TestStatus;
+
+  TestStatus = SignAndVerifyWithCA (TestChainNoCertSignCACert, sizeof (TestChainNoCertSignCACert), FALSE);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  TestStatus = SignAndVerifyWithCA (TestChainCACert, sizeof (TestChainCACert), TRUE);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  return SignAndVerifyWithCA (TestChainNoCertSignCACert, sizeof (TestChainNoCertSignCACert), FALSE);
+}
+
 TEST_DESC  mRsaCertTest[] = {
   //
   // -----Description--------------------------------------Class----------------------Function-----------------Pre---Post--Context
@@ -665,6 +1277,7 @@ TEST_DESC  mPkcs7Test[] = {
   //
   { "TestVerifyPkcs7SignVerify()",              "CryptoPkg.BaseCryptLib.Pkcs7", TestVerifyPkcs7SignVerify,              NULL, NULL, NULL },
   { "TestVerifyPkcs7SignVerifyNonSelfIssued()", "CryptoPkg.BaseCryptLib.Pkcs7", TestVerifyPkcs7SignVerifyNonSelfIssued, NULL, NULL, NULL },
+  { "TestVerifyPkcs7NoCertSignIntermediate()",  "CryptoPkg.BaseCryptLib.Pkcs7", TestVerifyPkcs7NoCertSignIntermediate,  NULL, NULL, NULL },
 };
 
 UINTN  mPkcs7TestNum = ARRAY_SIZE (mPkcs7Test);
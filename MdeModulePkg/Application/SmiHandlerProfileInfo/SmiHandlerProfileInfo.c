@@ -629,6 +629,10 @@ DumpSmiHandler (
         }
 
         Print (L"      </Caller>\n", SmiHandlerStruct->Handler);
+        if (SmiStruct->Header.Revision >= 0x0002) {
+          Print (L"      <DispatchCount>%ld</DispatchCount>\n", SmiHandlerStruct->DispatchCount);
+        }
+
         SmiHandlerStruct = (VOID *)((UINTN)SmiHandlerStruct + SmiHandlerStruct->Length);
         Print (L"    </SmiHandler>\n");
       }
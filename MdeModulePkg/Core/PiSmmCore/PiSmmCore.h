@@ -81,6 +81,7 @@ typedef struct {
 
   EFI_GUID      HandlerType; // Type of interrupt
   LIST_ENTRY    SmiHandlers; // All handlers
+  LIST_ENTRY    HashLink;    // Link on the hash bucket of HandlerType
 } SMI_ENTRY;
 
 #define SMI_HANDLER_SIGNATURE  SIGNATURE_32('s','m','i','h')
@@ -94,6 +95,7 @@ typedef struct {
   VOID                            *Context;    // for profile
   UINTN                           ContextSize; // for profile
   BOOLEAN                         ToRemove;    // To remove this SMI_HANDLER later
+  UINT64                          DispatchCount; // Number of times the handler is dispatched, for profile
 } SMI_HANDLER;
 
 //
@@ -8,6 +8,11 @@
 
 #include "PiSmmCore.h"
 
+//
+// Number of hash buckets to look up SMI entries by handler type. Must be a power of 2.
+//
+#define SMI_ENTRY_HASH_BUCKETS  64
+
 //
 // mSmiManageCallingDepth is used to track the depth of recursive calls of SmiManage.
 //
@@ -20,8 +25,50 @@ SMI_ENTRY  mRootSmiEntry = {
   INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.AllEntries),
   { 0 },
   INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.SmiHandlers),
+  INITIALIZE_LIST_HEAD_VARIABLE (mRootSmiEntry.HashLink),
 };
 
+//
+// SMI entries of mSmiEntryList hashed by handler type, so that SmiManage()
+// does not compare the GUID of every entry on each SMI.
+//
+LIST_ENTRY  mSmiEntryHash[SMI_ENTRY_HASH_BUCKETS];
+BOOLEAN     mSmiEntryHashInitialized = FALSE;
+
+/**
+  Get the hash bucket of an SMI handler type.
+
+  @param  HandlerType            The type of the interrupt
+
+  @return The list head of the hash bucket.
+
+**/
+LIST_ENTRY *
+SmiEntryHashBucket (
+  IN CONST EFI_GUID  *HandlerType
+  )
+{
+  UINTN   Index;
+  UINT32  Hash;
+
+  if (!mSmiEntryHashInitialized) {
+    for (Index = 0; Index < SMI_ENTRY_HASH_BUCKETS; Index++) {
+      InitializeListHead (&mSmiEntryHash[Index]);
+    }
+
+    mSmiEntryHashInitialized = TRUE;
+  }
+
+  Hash = ReadUnaligned32 ((CONST UINT32 *)HandlerType) ^
+         ReadUnaligned32 ((CONST UINT32 *)HandlerType + 1) ^
+         ReadUnaligned32 ((CONST UINT32 *)HandlerType + 2) ^
+         ReadUnaligned32 ((CONST UINT32 *)HandlerType + 3);
+  Hash ^= Hash >> 16;
+  Hash ^= Hash >> 8;
+
+  return &mSmiEntryHash[Hash & (SMI_ENTRY_HASH_BUCKETS - 1)];
+}
+
 /**
   Finds the SMI entry for the requested handler type.
 
@@ -38,19 +85,21 @@ SmmCoreFindSmiEntry (
   IN BOOLEAN   Create
   )
 {
+  LIST_ENTRY  *Bucket;
   LIST_ENTRY  *Link;
   SMI_ENTRY   *Item;
   SMI_ENTRY   *SmiEntry;
 
   //
-  // Search the SMI entry list for the matching GUID
+  // Search the hash bucket of the GUID for the matching SMI entry
   //
   SmiEntry = NULL;
-  for (Link = mSmiEntryList.ForwardLink;
-       Link != &mSmiEntryList;
+  Bucket   = SmiEntryHashBucket (HandlerType);
+  for (Link = Bucket->ForwardLink;
+       Link != Bucket;
        Link = Link->ForwardLink)
   {
-    Item = CR (Link, SMI_ENTRY, AllEntries, SMI_ENTRY_SIGNATURE);
+    Item = CR (Link, SMI_ENTRY, HashLink, SMI_ENTRY_SIGNATURE);
     if (CompareGuid (&Item->HandlerType, HandlerType)) {
       //
       // This is the SMI entry
@@ -78,6 +127,7 @@ SmmCoreFindSmiEntry (
       // Add it to SMI entry list
       //
       InsertTailList (&mSmiEntryList, &SmiEntry->AllEntries);
+      InsertTailList (Bucket, &SmiEntry->HashLink);
     }
   }
 
@@ -110,6 +160,7 @@ RemoveSmiHandler (
   if (SmiEntry != NULL) {
     if (IsListEmpty (&SmiEntry->SmiHandlers)) {
       RemoveEntryList (&SmiEntry->AllEntries);
+      RemoveEntryList (&SmiEntry->HashLink);
       FreePool (SmiEntry);
       return TRUE;
     }
@@ -178,6 +229,7 @@ SmiManage (
 
   for (Link = Head->ForwardLink; Link != Head; Link = Link->ForwardLink) {
     SmiHandler = CR (Link, SMI_HANDLER, Link, SMI_HANDLER_SIGNATURE);
+    SmiHandler->DispatchCount++;
 
     Status = SmiHandler->Handler (
                            (EFI_HANDLE)SmiHandler,
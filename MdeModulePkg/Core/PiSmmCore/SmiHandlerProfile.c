@@ -748,6 +748,7 @@ GetSmmSmiHandlerDataOnSmiEntry (
     SmiHandlerStruct->Handler           = (UINTN)SmiHandler->Handler;
     SmiHandlerStruct->ImageRef          = AddressToImageRef ((UINTN)SmiHandler->Handler);
     SmiHandlerStruct->ContextBufferSize = (UINT32)SmiHandler->ContextSize;
+    SmiHandlerStruct->DispatchCount     = SmiHandler->DispatchCount;
     if (SmiHandler->ContextSize != 0) {
       SmiHandlerStruct->ContextBufferOffset = sizeof (SMM_CORE_SMI_HANDLER_STRUCTURE);
       CopyMem ((UINT8 *)SmiHandlerStruct + SmiHandlerStruct->ContextBufferOffset, SmiHandler->Context, SmiHandler->ContextSize);
@@ -883,13 +884,15 @@ BuildSmiHandlerProfileDatabase (
   mSmiHandlerProfileDatabaseSize = GetSmiHandlerProfileDatabaseSize ();
   mSmiHandlerProfileDatabase     = AllocatePool (mSmiHandlerProfileDatabaseSize);
   if (mSmiHandlerProfileDatabase == NULL) {
+    mSmiHandlerProfileDatabaseSize = 0;
     return;
   }
 
   Status = GetSmiHandlerProfileDatabaseData (mSmiHandlerProfileDatabase);
   if (EFI_ERROR (Status)) {
     FreePool (mSmiHandlerProfileDatabase);
-    mSmiHandlerProfileDatabase = NULL;
+    mSmiHandlerProfileDatabase     = NULL;
+    mSmiHandlerProfileDatabaseSize = 0;
   }
 }
 
@@ -927,6 +930,116 @@ SmiHandlerProfileCopyData (
   *DataOffset = *DataOffset + *DataSize;
 }
 
+/**
+  Find the SMI entry of a handler type in an SMI entry list.
+
+  @param SmiEntryList   The SMI entry list.
+  @param HandlerType    The handler type of the SMI entry.
+
+  @return The SMI entry, or NULL if it is not in the list.
+**/
+STATIC
+SMI_ENTRY *
+FindSmiEntryOnList (
+  IN LIST_ENTRY      *SmiEntryList,
+  IN CONST EFI_GUID  *HandlerType
+  )
+{
+  LIST_ENTRY  *ListEntry;
+  SMI_ENTRY   *SmiEntry;
+
+  for (ListEntry = SmiEntryList->ForwardLink;
+       ListEntry != SmiEntryList;
+       ListEntry = ListEntry->ForwardLink)
+  {
+    SmiEntry = CR (ListEntry, SMI_ENTRY, AllEntries, SMI_ENTRY_SIGNATURE);
+    if (CompareGuid (&SmiEntry->HandlerType, HandlerType)) {
+      return SmiEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Refresh the dispatch counts held in the SMI handler profile database.
+
+  The database is built once at SmmReadyToLock and is not rebuilt afterwards
+  because the image information it is built from is freed then. Only the
+  DispatchCount field of each SMI handler record is written here, from the
+  SMI handler with the same Handler and CallerAddr on the same SMI entry.
+  Records whose SMI handler has been unregistered keep their last count.
+**/
+STATIC
+VOID
+UpdateSmiHandlerProfileDispatchCount (
+  VOID
+  )
+{
+  SMM_CORE_SMI_DATABASE_STRUCTURE  *SmiStruct;
+  SMM_CORE_SMI_HANDLER_STRUCTURE   *SmiHandlerStruct;
+  LIST_ENTRY                       *SmiEntryList;
+  SMI_ENTRY                        *SmiEntry;
+  LIST_ENTRY                       *ListEntry;
+  LIST_ENTRY                       *CursorEntry;
+  SMI_HANDLER                      *SmiHandler;
+  UINTN                            Offset;
+  UINTN                            Index;
+
+  if (mSmiHandlerProfileDatabase == NULL) {
+    return;
+  }
+
+  for (Offset = mSmmImageDatabaseSize;
+       Offset < mSmiHandlerProfileDatabaseSize;
+       Offset += SmiStruct->Header.Length)
+  {
+    SmiStruct = (SMM_CORE_SMI_DATABASE_STRUCTURE *)((UINT8 *)mSmiHandlerProfileDatabase + Offset);
+    switch (SmiStruct->HandlerCategory) {
+      case SmmCoreSmiHandlerCategoryRootHandler:
+        SmiEntryList = mSmmCoreRootSmiEntryList;
+        break;
+      case SmmCoreSmiHandlerCategoryGuidHandler:
+        SmiEntryList = mSmmCoreSmiEntryList;
+        break;
+      default:
+        //
+        // Hardware SMI handlers are not dispatched by the SMM core.
+        //
+        continue;
+    }
+
+    SmiEntry = FindSmiEntryOnList (SmiEntryList, &SmiStruct->HandlerType);
+    if (SmiEntry == NULL) {
+      continue;
+    }
+
+    //
+    // The records were written in SmiHandlers list order, so search for each
+    // one from just past the SMI handler matched by the previous record.
+    //
+    CursorEntry      = &SmiEntry->SmiHandlers;
+    SmiHandlerStruct = (SMM_CORE_SMI_HANDLER_STRUCTURE *)(SmiStruct + 1);
+    for (Index = 0; Index < SmiStruct->HandlerCount; Index++) {
+      for (ListEntry = CursorEntry->ForwardLink;
+           ListEntry != &SmiEntry->SmiHandlers;
+           ListEntry = ListEntry->ForwardLink)
+      {
+        SmiHandler = CR (ListEntry, SMI_HANDLER, Link, SMI_HANDLER_SIGNATURE);
+        if ((SmiHandlerStruct->Handler == (UINTN)SmiHandler->Handler) &&
+            (SmiHandlerStruct->CallerAddr == (UINTN)SmiHandler->CallerAddr))
+        {
+          SmiHandlerStruct->DispatchCount = SmiHandler->DispatchCount;
+          CursorEntry                     = ListEntry;
+          break;
+        }
+      }
+
+      SmiHandlerStruct = (SMM_CORE_SMI_HANDLER_STRUCTURE *)((UINTN)SmiHandlerStruct + SmiHandlerStruct->Length);
+    }
+  }
+}
+
 /**
   SMI handler profile handler to get info.
 
@@ -943,6 +1056,8 @@ SmiHandlerProfileHandlerGetInfo (
   SmiHandlerProfileRecordingStatus  = mSmiHandlerProfileRecordingStatus;
   mSmiHandlerProfileRecordingStatus = FALSE;
 
+  UpdateSmiHandlerProfileDispatchCount ();
+
   SmiHandlerProfileParameterGetInfo->DataSize            = mSmiHandlerProfileDatabaseSize;
   SmiHandlerProfileParameterGetInfo->Header.ReturnStatus = 0;
 
@@ -2486,6 +2486,8 @@ DumpFreePagesList (
   LIST_ENTRY                   *Node;
   FREE_PAGE_LIST               *Pages;
   UINTN                        Index;
+  UINTN                        TotalPages;
+  UINTN                        LargestPages;
   MEMORY_PROFILE_CONTEXT_DATA  *ContextData;
   BOOLEAN                      SmramProfileGettingStatus;
 
@@ -2500,6 +2502,8 @@ DumpFreePagesList (
   DEBUG ((DEBUG_INFO, "======= SmramProfile begin =======\n"));
 
   DEBUG ((DEBUG_INFO, "FreePagesList:\n"));
+  TotalPages   = 0;
+  LargestPages = 0;
   FreePageList = &mSmmMemoryMap;
   for (Node = FreePageList->BackLink, Index = 0;
        Node != FreePageList;
@@ -2509,8 +2513,19 @@ DumpFreePagesList (
     DEBUG ((DEBUG_INFO, "  Index - 0x%x\n", Index));
     DEBUG ((DEBUG_INFO, "    PhysicalStart - 0x%016lx\n", (PHYSICAL_ADDRESS)(UINTN)Pages));
     DEBUG ((DEBUG_INFO, "    NumberOfPages - 0x%08x\n", Pages->NumberOfPages));
+    TotalPages  += Pages->NumberOfPages;
+    LargestPages = MAX (LargestPages, Pages->NumberOfPages);
   }
 
+  //
+  // The ratio of the largest free range to the total free pages shows how
+  // fragmented SMRAM is.
+  //
+  DEBUG ((DEBUG_INFO, "FreePagesSummary:\n"));
+  DEBUG ((DEBUG_INFO, "  RangeCount        - 0x%x\n", Index));
+  DEBUG ((DEBUG_INFO, "  TotalPages        - 0x%x\n", TotalPages));
+  DEBUG ((DEBUG_INFO, "  LargestRangePages - 0x%x\n", LargestPages));
+
   DEBUG ((DEBUG_INFO, "======= SmramProfile end =======\n"));
 
   mSmramProfileGettingStatus = SmramProfileGettingStatus;
@@ -77,6 +77,10 @@ typedef struct {
 // The payload for this function is SMM_VARIABLE_COMMUNICATE_GET_RUNTIME_CACHE_INFO
 //
 #define SMM_VARIABLE_FUNCTION_GET_RUNTIME_CACHE_INFO  14
+//
+// The payload for this function is SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES
+//
+#define SMM_VARIABLE_FUNCTION_GET_NEXT_VARIABLE_NAMES  15
 
 ///
 /// Size of SMM communicate header, without including the payload.
@@ -119,6 +123,34 @@ typedef struct {
   UINT32    Attributes;
 } SMM_VARIABLE_COMMUNICATE_QUERY_VARIABLE_INFO;
 
+///
+/// This structure is used to communicate with SMI handler by GetNextVariableName to
+/// return multiple consecutive variable names in one SMI.
+///
+/// The structure is followed by NameCount + 1 SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME
+/// entries, each at a UINTN aligned offset from the structure. The first entry is the input name and GUID
+/// to start the search from, and its NameSize is the size of the input name. The rest are
+/// the returned names in the order GetNextVariableName() returns them.
+///
+typedef struct {
+  UINTN      NameCount;     // Number of returned names
+  BOOLEAN    EndOfList;     // TRUE if the last returned name is the last variable
+} SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES;
+
+///
+/// Return the first SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME entry that follows
+/// the SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES structure.
+///
+#define SMM_VARIABLE_FIRST_NAME_ENTRY(Names) \
+  ((SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME *)((SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES *)(Names) + 1))
+
+///
+/// Return the SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME entry that follows Entry.
+///
+#define SMM_VARIABLE_NEXT_NAME_ENTRY(Names, Entry) \
+  ((SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME *)((UINT8 *)(Names) + \
+    ALIGN_VALUE ((UINTN)((UINT8 *)(Entry)->Name - (UINT8 *)(Names)) + (Entry)->NameSize, sizeof (UINTN))))
+
 typedef SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME SMM_VARIABLE_COMMUNICATE_LOCK_VARIABLE;
 
 typedef struct {
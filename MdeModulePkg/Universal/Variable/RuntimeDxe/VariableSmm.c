@@ -424,6 +424,67 @@ SmmVariableGetStatistics (
   return EFI_SUCCESS;
 }
 
+/**
+  Get as many consecutive variable names as the communicate buffer can hold.
+
+  Each name is searched from the previous entry, which is copied forward as the
+  input of VariableServiceGetNextVariableName(), so that the returned entries
+  are in the same order as GetNextVariableName() returns them one by one.
+
+  @param[in, out] GetNextVariableNames  The payload of the communicate buffer. The first
+                                        entry holds the name and GUID to start the search from.
+  @param[in]      PayloadSize           The size in bytes of the payload.
+
+  @retval EFI_SUCCESS  At least one name is returned.
+  @return Others       The status of searching the first name.
+**/
+EFI_STATUS
+SmmGetNextVariableNames (
+  IN OUT SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES  *GetNextVariableNames,
+  IN     UINTN                                             PayloadSize
+  )
+{
+  EFI_STATUS                                       Status;
+  SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME  *Entry;
+  SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME  *NextEntry;
+  UINTN                                            NextEntryOffset;
+  UINTN                                            NameSize;
+
+  GetNextVariableNames->NameCount = 0;
+  GetNextVariableNames->EndOfList = FALSE;
+
+  Status = EFI_BUFFER_TOO_SMALL;
+  Entry  = SMM_VARIABLE_FIRST_NAME_ENTRY (GetNextVariableNames);
+  while (TRUE) {
+    NextEntry       = SMM_VARIABLE_NEXT_NAME_ENTRY (GetNextVariableNames, Entry);
+    NextEntryOffset = (UINT8 *)NextEntry - (UINT8 *)GetNextVariableNames;
+    if ((NextEntryOffset > PayloadSize) ||
+        (PayloadSize - NextEntryOffset < OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME, Name) + Entry->NameSize))
+    {
+      break;
+    }
+
+    CopyGuid (&NextEntry->Guid, &Entry->Guid);
+    CopyMem (NextEntry->Name, Entry->Name, Entry->NameSize);
+    NameSize = PayloadSize - NextEntryOffset - OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME, Name);
+    Status   = VariableServiceGetNextVariableName (&NameSize, NextEntry->Name, &NextEntry->Guid);
+    if (EFI_ERROR (Status)) {
+      GetNextVariableNames->EndOfList = (BOOLEAN)(Status == EFI_NOT_FOUND);
+      break;
+    }
+
+    NextEntry->NameSize = NameSize;
+    GetNextVariableNames->NameCount++;
+    Entry = NextEntry;
+  }
+
+  if (GetNextVariableNames->NameCount != 0) {
+    return EFI_SUCCESS;
+  }
+
+  return Status;
+}
+
 /**
   Communication service SMI Handler entry.
 
@@ -463,6 +524,7 @@ SmmVariableHandler (
   SMM_VARIABLE_COMMUNICATE_HEADER                          *SmmVariableFunctionHeader;
   SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE                 *SmmVariableHeader;
   SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME          *GetNextVariableName;
+  SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES         *GetNextVariableNames;
   SMM_VARIABLE_COMMUNICATE_QUERY_VARIABLE_INFO             *QueryVariableInfo;
   SMM_VARIABLE_COMMUNICATE_GET_PAYLOAD_SIZE                *GetPayloadSize;
   SMM_VARIABLE_COMMUNICATE_RUNTIME_VARIABLE_CACHE_CONTEXT  *RuntimeVariableCacheContext;
@@ -608,6 +670,35 @@ SmmVariableHandler (
       CopyMem (SmmVariableFunctionHeader->Data, mVariableBufferPayload, CommBufferPayloadSize);
       break;
 
+    case SMM_VARIABLE_FUNCTION_GET_NEXT_VARIABLE_NAMES:
+      if (CommBufferPayloadSize < sizeof (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES) + OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME, Name)) {
+        DEBUG ((DEBUG_ERROR, "GetNextVariableNames: SMM communication buffer size invalid!\n"));
+        return EFI_SUCCESS;
+      }
+
+      //
+      // Copy the input communicate buffer payload to pre-allocated SMM variable buffer payload.
+      //
+      CopyMem (mVariableBufferPayload, SmmVariableFunctionHeader->Data, CommBufferPayloadSize);
+      GetNextVariableNames = (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES *)mVariableBufferPayload;
+      GetNextVariableName  = SMM_VARIABLE_FIRST_NAME_ENTRY (GetNextVariableNames);
+
+      //
+      // Make sure input VariableName is a Null-terminated string within the communicate buffer.
+      //
+      NameBufferSize = CommBufferPayloadSize - ((UINT8 *)GetNextVariableName->Name - (UINT8 *)GetNextVariableNames);
+      if ((GetNextVariableName->NameSize < sizeof (CHAR16)) ||
+          (GetNextVariableName->NameSize > NameBufferSize) ||
+          (GetNextVariableName->Name[GetNextVariableName->NameSize / sizeof (CHAR16) - 1] != L'\0'))
+      {
+        Status = EFI_ACCESS_DENIED;
+        goto EXIT;
+      }
+
+      Status = SmmGetNextVariableNames (GetNextVariableNames, CommBufferPayloadSize);
+      CopyMem (SmmVariableFunctionHeader->Data, mVariableBufferPayload, CommBufferPayloadSize);
+      break;
+
     case SMM_VARIABLE_FUNCTION_SET_VARIABLE:
       if (CommBufferPayloadSize < OFFSET_OF (SMM_VARIABLE_COMMUNICATE_ACCESS_VARIABLE, Name)) {
         DEBUG ((DEBUG_ERROR, "SetVariable: SMM communication buffer size invalid!\n"));
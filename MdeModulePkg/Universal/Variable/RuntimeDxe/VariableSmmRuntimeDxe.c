@@ -62,6 +62,17 @@ EDKII_VAR_CHECK_PROTOCOL        mVarCheck;
 VARIABLE_RUNTIME_CACHE_INFO     mVariableRtCacheInfo;
 BOOLEAN                         mIsRuntimeCacheEnabled = FALSE;
 
+//
+// Variable names returned by SMM_VARIABLE_FUNCTION_GET_NEXT_VARIABLE_NAMES. They serve the
+// following GetNextVariableName() calls of the same enumeration without triggering an SMI.
+// mVariableNameCacheIndex and mVariableNameCacheOffset locate the entry of the name that
+// the enumeration is expected to continue from.
+//
+UINT8    *mVariableNameCache      = NULL;
+BOOLEAN  mVariableNameCacheValid  = FALSE;
+UINTN    mVariableNameCacheIndex  = 0;
+UINTN    mVariableNameCacheOffset = 0;
+
 /**
   The logic to initialize the VariablePolicy engine is in its own file.
 
@@ -1042,6 +1053,189 @@ Done:
   return Status;
 }
 
+/**
+  Finds the next variable name in the variable name cache.
+
+  Only the enumeration that filled the cache continues from it. Any other input name, such as
+  one from an interleaved or resumed enumeration, is not served from the cache, so the names
+  returned are never older than the SMI that started the current run of the enumeration.
+
+  @param[in, out] VariableNameSize   Size of the variable name.
+  @param[in, out] VariableName       Pointer to variable name.
+  @param[in, out] VendorGuid         Variable Vendor Guid.
+  @param[out]     Status             The status to return to the caller when the name is found in the cache.
+
+  @retval TRUE   The input variable is found in the cache, and Status is the result.
+  @retval FALSE  The result is not known from the cache.
+
+**/
+BOOLEAN
+GetNextVariableNameInNameCache (
+  IN OUT  UINTN       *VariableNameSize,
+  IN OUT  CHAR16      *VariableName,
+  IN OUT  EFI_GUID    *VendorGuid,
+  OUT     EFI_STATUS  *Status
+  )
+{
+  SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES  *Names;
+  SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME   *Entry;
+  SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME   *NextEntry;
+
+  if (!mVariableNameCacheValid) {
+    return FALSE;
+  }
+
+  Names = (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES *)mVariableNameCache;
+  Entry = (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME *)(mVariableNameCache + mVariableNameCacheOffset);
+  if (!CompareGuid (&Entry->Guid, VendorGuid) || (StrCmp (Entry->Name, VariableName) != 0)) {
+    return FALSE;
+  }
+
+  if (mVariableNameCacheIndex == Names->NameCount) {
+    if (!Names->EndOfList) {
+      return FALSE;
+    }
+
+    //
+    // The enumeration is complete.
+    //
+    mVariableNameCacheValid = FALSE;
+    *Status                 = EFI_NOT_FOUND;
+    return TRUE;
+  }
+
+  NextEntry = SMM_VARIABLE_NEXT_NAME_ENTRY (Names, Entry);
+  if (*VariableNameSize < NextEntry->NameSize) {
+    *VariableNameSize = NextEntry->NameSize;
+    *Status           = EFI_BUFFER_TOO_SMALL;
+    return TRUE;
+  }
+
+  CopyGuid (VendorGuid, &NextEntry->Guid);
+  CopyMem (VariableName, NextEntry->Name, NextEntry->NameSize);
+  *VariableNameSize = NextEntry->NameSize;
+  *Status           = EFI_SUCCESS;
+
+  mVariableNameCacheIndex++;
+  mVariableNameCacheOffset = (UINTN)((UINT8 *)NextEntry - mVariableNameCache);
+  return TRUE;
+}
+
+/**
+  Fills the variable name cache with the variable names that follow the input variable.
+
+  All the names that fit in the communicate buffer are returned by SMM in one SMI.
+
+  @param[in] VariableName       Pointer to variable name to start the search from.
+  @param[in] VendorGuid         Variable Vendor Guid.
+
+  @retval EFI_SUCCESS           The variable name cache is filled.
+  @retval EFI_NOT_FOUND         The input variable is the last one. The variable name cache records that.
+  @retval Others                The variable name cache is not filled.
+
+**/
+EFI_STATUS
+FillVariableNameCacheFromSmm (
+  IN CHAR16    *VariableName,
+  IN EFI_GUID  *VendorGuid
+  )
+{
+  EFI_STATUS                                        Status;
+  UINTN                                             PayloadSize;
+  UINTN                                             InVariableNameSize;
+  SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES  *SmmGetNextVariableNames;
+  SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME   *Entry;
+
+  mVariableNameCacheValid = FALSE;
+
+  PayloadSize = mVariableBufferSize - SMM_VARIABLE_COMMUNICATE_HEADER_SIZE -
+                ((mMmCommunication3 != NULL) ? SMM_COMMUNICATE_HEADER_SIZE_V3 : SMM_COMMUNICATE_HEADER_SIZE);
+  PayloadSize        = MIN (PayloadSize, mVariableBufferPayloadSize);
+  InVariableNameSize = StrSize (VariableName);
+  if (InVariableNameSize > PayloadSize - sizeof (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAMES) - OFFSET_OF (SMM_VARIABLE_COMMUNICATE_GET_NEXT_VARIABLE_NAME, Name)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Status = InitCommunicateBuffer ((VOID **)&SmmGetNextVariableNames, PayloadSize, SMM_VARIABLE_FUNCTION_GET_NEXT_VARIABLE_NAMES);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  ASSERT (SmmGetNextVariableNames != NULL);
+
+  Entry           = SMM_VARIABLE_FIRST_NAME_ENTRY (SmmGetNextVariableNames);
+  Entry->NameSize = InVariableNameSize;
+  CopyGuid (&Entry->Guid, VendorGuid);
+  CopyMem (Entry->Name, VariableName, InVariableNameSize);
+
+  //
+  // Send data to SMM
+  //
+  Status = SendCommunicateBuffer (PayloadSize);
+  if (!EFI_ERROR (Status) || (Status == EFI_NOT_FOUND)) {
+    CopyMem (mVariableNameCache, SmmGetNextVariableNames, PayloadSize);
+    mVariableNameCacheValid  = TRUE;
+    mVariableNameCacheIndex  = 0;
+    mVariableNameCacheOffset = (UINTN)((UINT8 *)SMM_VARIABLE_FIRST_NAME_ENTRY (mVariableNameCache) - mVariableNameCache);
+  }
+
+  return Status;
+}
+
+/**
+  This code Finds the Next available variable through the variable name cache.
+  The names are fetched from SMM in batch, so that an enumeration does not
+  trigger one SMI per variable.
+
+  @param[in, out] VariableNameSize   Size of the variable name.
+  @param[in, out] VariableName       Pointer to variable name.
+  @param[in, out] VendorGuid         Variable Vendor Guid.
+
+  @retval EFI_SUCCESS                The function completed successfully.
+  @retval EFI_NOT_FOUND              The next variable was not found.
+  @retval EFI_BUFFER_TOO_SMALL       The VariableNameSize is too small for the result.
+                                     VariableNameSize has been updated with the size needed to complete the request.
+  @retval EFI_INVALID_PARAMETER      The input values of VariableName and VendorGuid are not a name and
+                                     GUID of an existing variable.
+  @retval EFI_DEVICE_ERROR           The variable could not be retrieved due to a hardware error.
+
+**/
+EFI_STATUS
+GetNextVariableNameThroughNameCache (
+  IN OUT  UINTN     *VariableNameSize,
+  IN OUT  CHAR16    *VariableName,
+  IN OUT  EFI_GUID  *VendorGuid
+  )
+{
+  EFI_STATUS  Status;
+
+  if (mVariableNameCache != NULL) {
+    //
+    // Always start a new enumeration from SMM, so that the names are at most as stale
+    // as the beginning of the enumeration.
+    //
+    if (VariableName[0] == L'\0') {
+      mVariableNameCacheValid = FALSE;
+    }
+
+    if (GetNextVariableNameInNameCache (VariableNameSize, VariableName, VendorGuid, &Status)) {
+      return Status;
+    }
+
+    Status = FillVariableNameCacheFromSmm (VariableName, VendorGuid);
+    if (Status == EFI_UNSUPPORTED) {
+      //
+      // The SMM variable driver does not support returning multiple names.
+      //
+      mVariableNameCache = NULL;
+    } else if (GetNextVariableNameInNameCache (VariableNameSize, VariableName, VendorGuid, &Status)) {
+      return Status;
+    }
+  }
+
+  return GetNextVariableNameInSmm (VariableNameSize, VariableName, VendorGuid);
+}
+
 /**
   This code Finds the Next available variable.
 
@@ -1100,7 +1294,7 @@ RuntimeServiceGetNextVariableName (
   if (mIsRuntimeCacheEnabled) {
     Status = GetNextVariableNameInRuntimeCache (VariableNameSize, VariableName, VendorGuid);
   } else {
-    Status = GetNextVariableNameInSmm (VariableNameSize, VariableName, VendorGuid);
+    Status = GetNextVariableNameThroughNameCache (VariableNameSize, VariableName, VendorGuid);
   }
 
   ReleaseLockOnlyAtBootTime (&mVariableServicesLock);
@@ -1180,6 +1374,11 @@ RuntimeServiceSetVariable (
 
   AcquireLockOnlyAtBootTime (&mVariableServicesLock);
 
+  //
+  // The variable may be created or deleted, so the cached variable names are out of date.
+  //
+  mVariableNameCacheValid = FALSE;
+
   //
   // Init the communicate buffer. The buffer data size is:
   // SMM_COMMUNICATE_HEADER_SIZE + SMM_VARIABLE_COMMUNICATE_HEADER_SIZE + PayloadSize.
@@ -1307,6 +1506,12 @@ OnExitBootServices (
   IN      VOID       *Context
   )
 {
+  //
+  // The variables without EFI_VARIABLE_RUNTIME_ACCESS are hidden from now on, so the cached
+  // variable names are out of date.
+  //
+  mVariableNameCacheValid = FALSE;
+
   //
   // Init the communicate buffer. The buffer data size is:
   // SMM_COMMUNICATE_HEADER_SIZE + SMM_VARIABLE_COMMUNICATE_HEADER_SIZE.
@@ -1378,6 +1583,7 @@ VariableAddressChangeEvent (
   )
 {
   EfiConvertPointer (0x0, (VOID **)&mVariableBuffer);
+  EfiConvertPointer (EFI_OPTIONAL_PTR, (VOID **)&mVariableNameCache);
   if (mMmCommunication3 != NULL) {
     EfiConvertPointer (0x0, (VOID **)&mMmCommunication3);
   } else {
@@ -1844,6 +2050,7 @@ SmmVariableReady (
     ASSERT_EFI_ERROR (Status);
   } else {
     DEBUG ((DEBUG_INFO, "Variable driver runtime cache is disabled.\n"));
+    mVariableNameCache = AllocateRuntimePool (mVariableBufferPayloadSize);
   }
 
   gRT->GetVariable         = RuntimeServiceGetVariable;
@@ -0,0 +1,346 @@
+/** @file
+  Tests for the reception of the HTTP headers in HttpProto.c.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <Library/GoogleTestLib.h>
+#include <string>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include "../HttpDriver.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These functions are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+
+VOID
+EFIAPI
+HttpFreeMsgParser (
+  IN  VOID  *MsgParser
+  )
+{
+}
+
+EFI_STATUS
+EFIAPI
+HttpGenRequestMessage (
+  IN     CONST EFI_HTTP_MESSAGE  *Message,
+  IN     CONST CHAR8             *Url,
+  OUT CHAR8                      **RequestMsg,
+  OUT UINTN                      *RequestMsgSize
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+BOOLEAN
+EFIAPI
+HttpIsMessageComplete (
+  IN VOID  *MsgParser
+  )
+{
+  return TRUE;
+}
+
+EFI_STATUS
+EFIAPI
+HttpParseMessageBody (
+  IN OUT VOID   *MsgParser,
+  IN     UINTN  BodyLength,
+  IN     CHAR8  *Body
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+EFI_STATUS
+HttpResponseWorker (
+  IN  HTTP_TOKEN_WRAP  *Wrap
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+EFI_STATUS
+EFIAPI
+HttpsReceive (
+  IN     HTTP_PROTOCOL  *HttpInstance,
+  IN OUT NET_FRAGMENT   *Fragment,
+  IN     EFI_EVENT      Timeout
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+VOID
+EFIAPI
+TlsCloseTxRxEvent (
+  IN  HTTP_PROTOCOL  *HttpInstance
+  )
+{
+}
+
+EFI_STATUS
+EFIAPI
+TlsConfigureSession (
+  IN OUT HTTP_PROTOCOL  *HttpInstance
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+EFI_STATUS
+EFIAPI
+TlsConnectSession (
+  IN  HTTP_PROTOCOL  *HttpInstance,
+  IN  EFI_EVENT      Timeout
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+EFI_STATUS
+EFIAPI
+TlsProcessMessage (
+  IN     HTTP_PROTOCOL       *HttpInstance,
+  IN     UINT8               *Message,
+  IN     UINTN               MessageSize,
+  IN     EFI_TLS_CRYPT_MODE  ProcessMode,
+  IN OUT NET_FRAGMENT        *Fragment
+  )
+{
+  return EFI_UNSUPPORTED;
+}
+
+EFI_STATUS
+EFIAPI
+QueueDpc (
+  IN EFI_TPL            DpcTpl,
+  IN EFI_DPC_PROCEDURE  DpcProcedure,
+  IN VOID               *DpcContext    OPTIONAL
+  )
+{
+  return EFI_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// HttpAppendHeaderFragment Tests
+////////////////////////////////////////////////////////////////////////
+
+class HttpAppendHeaderFragmentTest : public ::testing::Test {
+public:
+  HTTP_PROTOCOL HttpInstance;
+  CHAR8 *HttpHeaders;
+  CHAR8 *EndofHeader;
+  UINTN SizeofHeaders;
+  UINTN BufferSize;
+  UINTN Capacity;
+  UINTN Reallocations;
+  UINT32 Seed;
+
+protected:
+  virtual void
+  SetUp (
+    )
+  {
+    HttpHeaders   = NULL;
+    EndofHeader   = NULL;
+    SizeofHeaders = 0;
+    BufferSize    = 0;
+    Capacity      = 0;
+    Reallocations = 0;
+    Seed          = 0x2545F491;
+
+    ZeroMem (&HttpInstance, sizeof (HttpInstance));
+    HttpInstance.HttpHeaders = &HttpHeaders;
+    HttpInstance.EndofHeader = &EndofHeader;
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    if (HttpHeaders != NULL) {
+      FreePool (HttpHeaders);
+    }
+  }
+
+  //
+  // A small deterministic pseudo random generator, so that failures can be
+  // reproduced.
+  //
+  UINT32
+  Random (
+    )
+  {
+    Seed ^= Seed << 13;
+    Seed ^= Seed >> 17;
+    Seed ^= Seed << 5;
+    return Seed;
+  }
+
+  EFI_STATUS
+  Append (
+    CONST CHAR8  *Data,
+    UINTN        Length
+    )
+  {
+    NET_FRAGMENT  Fragment;
+    UINTN         OldCapacity;
+    EFI_STATUS    Status;
+
+    Fragment.Bulk = (UINT8 *)Data;
+    Fragment.Len  = (UINT32)Length;
+    OldCapacity   = Capacity;
+
+    Status = HttpAppendHeaderFragment (&HttpInstance, &Fragment, &SizeofHeaders, &BufferSize, &Capacity);
+    if (Capacity != OldCapacity) {
+      Reallocations++;
+    }
+
+    return Status;
+  }
+
+  //
+  // Feed a message in fragments of random size, stopping once the end of the
+  // headers is found as HttpTcpReceiveHeader() does.
+  //
+  VOID
+  AppendInRandomFragments (
+    CONST std::string  &Message,
+    UINTN              MaxFragment
+    )
+  {
+    UINTN  Offset;
+    UINTN  Length;
+
+    for (Offset = 0; Offset < Message.size () && EndofHeader == NULL; Offset += Length) {
+      Length = 1 + Random () % MaxFragment;
+      Length = MIN (Length, Message.size () - Offset);
+      ASSERT_EQ (Append (Message.c_str () + Offset, Length), EFI_SUCCESS);
+    }
+  }
+
+  //
+  // Build a header block of about Size bytes with random printable content
+  // and single line breaks, which never contains the end of headers.
+  //
+  std::string
+  RandomHeaders (
+    UINTN  Size
+    )
+  {
+    std::string  Headers ("HTTP/1.1 200 OK\r\n");
+
+    while (Headers.size () < Size) {
+      Headers += "X-Field-" + std::to_string (Random () % 1000) + ": ";
+      for (UINTN Index = Random () % 64; Index > 0; Index--) {
+        Headers += (CHAR8)(' ' + Random () % ('~' - ' '));
+      }
+
+      //
+      // Also throw in lone CR and LF, which must not be taken for the end.
+      //
+      switch (Random () % 4) {
+        case 0:
+          Headers += "\r";
+          break;
+        case 1:
+          Headers += "\n";
+          break;
+        default:
+          break;
+      }
+
+      Headers += "\r\n";
+    }
+
+    return Headers;
+  }
+};
+
+// Test Description:
+// The end of the headers is found when it is split across two fragments at
+// each possible position.
+TEST_F (HttpAppendHeaderFragmentTest, TerminatorSpanningFragmentsIsFound) {
+  std::string  Message ("HTTP/1.1 200 OK\r\nContent-Length: 4\r\n\r\nbody");
+  UINTN        Split;
+
+  for (Split = 1; Split < Message.size (); Split++) {
+    TearDown ();
+    SetUp ();
+
+    ASSERT_EQ (Append (Message.c_str (), Split), EFI_SUCCESS);
+    if (EndofHeader == NULL) {
+      ASSERT_EQ (Append (Message.c_str () + Split, Message.size () - Split), EFI_SUCCESS);
+    }
+
+    ASSERT_NE (EndofHeader, (CHAR8 *)NULL) << "Split at " << Split;
+    EXPECT_EQ ((UINTN)(EndofHeader - HttpHeaders), Message.find ("\r\n\r\n")) << "Split at " << Split;
+    EXPECT_EQ (BufferSize, SizeofHeaders);
+    EXPECT_EQ (AsciiStrnCmp (HttpHeaders, Message.c_str (), SizeofHeaders), 0);
+  }
+}
+
+// Test Description:
+// Messages split into fragments of random size are reassembled intact and the
+// first end of headers is found, never a false one.
+TEST_F (HttpAppendHeaderFragmentTest, RandomFragmentationFindsFirstTerminator) {
+  std::string  Message;
+  UINTN        Iteration;
+
+  for (Iteration = 0; Iteration < 500; Iteration++) {
+    TearDown ();
+    SetUp ();
+    Seed += (UINT32)Iteration;
+
+    Message = RandomHeaders (Random () % (4 * DEF_BUF_LEN)) + "\r\n" + "\r\n\r\nbody";
+    AppendInRandomFragments (Message, 1 + Random () % 300);
+
+    ASSERT_NE (EndofHeader, (CHAR8 *)NULL) << "Iteration " << Iteration;
+    EXPECT_EQ ((UINTN)(EndofHeader - HttpHeaders), Message.find ("\r\n\r\n")) << "Iteration " << Iteration;
+    EXPECT_EQ (CompareMem (HttpHeaders, Message.c_str (), SizeofHeaders), 0);
+    EXPECT_EQ (HttpHeaders[SizeofHeaders], '\0');
+    EXPECT_LE (SizeofHeaders, Capacity);
+  }
+}
+
+// Test Description:
+// Headers without a terminator are accumulated without a false match.
+TEST_F (HttpAppendHeaderFragmentTest, NoTerminatorIsNotFound) {
+  std::string  Message;
+
+  Message = RandomHeaders (3 * DEF_BUF_LEN);
+  AppendInRandomFragments (Message, 100);
+
+  EXPECT_EQ (EndofHeader, (CHAR8 *)NULL);
+  EXPECT_EQ (SizeofHeaders, Message.size ());
+  EXPECT_EQ (CompareMem (HttpHeaders, Message.c_str (), SizeofHeaders), 0);
+}
+
+// Test Description:
+// Large headers received one byte at a time only reallocate the buffer a
+// logarithmic number of times, rather than once per fragment.
+TEST_F (HttpAppendHeaderFragmentTest, ByteAtATimeGrowsGeometrically) {
+  std::string  Message;
+  UINTN        Offset;
+  UINTN        Limit;
+
+  Message = RandomHeaders (256 * 1024) + "\r\n";
+  for (Offset = 0; Offset < Message.size () && EndofHeader == NULL; Offset++) {
+    ASSERT_EQ (Append (Message.c_str () + Offset, 1), EFI_SUCCESS);
+  }
+
+  ASSERT_NE (EndofHeader, (CHAR8 *)NULL);
+  EXPECT_EQ (SizeofHeaders, Message.size ());
+
+  Limit = 1 + HighBitSet64 (Message.size () / DEF_BUF_LEN) + 1;
+  EXPECT_LE (Reallocations, Limit);
+}
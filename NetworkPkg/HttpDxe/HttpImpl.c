@@ -1141,7 +1141,7 @@ HttpResponseWorker (
       // The data is stored at [NextMsg, CacheBody + CacheLen].
       //
       HdrLen      = HttpInstance->CacheBody + HttpInstance->CacheLen - HttpInstance->NextMsg;
-      HttpHeaders = AllocateZeroPool (HdrLen);
+      HttpHeaders = AllocateZeroPool (HdrLen + 1);
       if (HttpHeaders == NULL) {
         Status = EFI_OUT_OF_RESOURCES;
         goto Error;
@@ -1828,6 +1828,77 @@ HttpTcpReceive (
   return HttpResponseWorker ((HTTP_TOKEN_WRAP *)Item->Value);
 }
 
+/**
+  Append a received fragment to the cached HTTP headers and look for the end
+  of the headers.
+
+  The header buffer grows geometrically rather than by one fragment at a
+  time, and only the newly received bytes (plus the three bytes before them,
+  in case the terminator spans two fragments) are searched for the end of
+  the headers, so that receiving large headers in many small fragments costs
+  time linear in the header size.
+
+  @param[in]       HttpInstance     The HTTP instance private data.
+  @param[in]       Fragment         The received fragment.
+  @param[in, out]  SizeofHeaders    The length of the cached header message.
+  @param[in, out]  BufferSize       The size of buffer to cache the header message.
+  @param[in, out]  Capacity         The allocated size of the header buffer, not
+                                    including the Null-terminator.
+
+  @retval EFI_SUCCESS               The fragment is appended.
+  @retval EFI_OUT_OF_RESOURCES      Failed to grow the header buffer.
+
+**/
+EFI_STATUS
+HttpAppendHeaderFragment (
+  IN     HTTP_PROTOCOL  *HttpInstance,
+  IN     NET_FRAGMENT   *Fragment,
+  IN OUT UINTN          *SizeofHeaders,
+  IN OUT UINTN          *BufferSize,
+  IN OUT UINTN          *Capacity
+  )
+{
+  CHAR8  **HttpHeaders;
+  CHAR8  *Buffer;
+  UINTN  NewCapacity;
+  UINTN  SearchStart;
+
+  HttpHeaders = HttpInstance->HttpHeaders;
+  *BufferSize = *SizeofHeaders + Fragment->Len;
+
+  if ((*HttpHeaders == NULL) || (*BufferSize > *Capacity)) {
+    NewCapacity = MAX (MAX (*Capacity * 2, *BufferSize), DEF_BUF_LEN);
+    Buffer      = AllocatePool (NewCapacity + 1);
+    if (Buffer == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    if (*HttpHeaders != NULL) {
+      CopyMem (Buffer, *HttpHeaders, *SizeofHeaders);
+      FreePool (*HttpHeaders);
+    }
+
+    *HttpHeaders = Buffer;
+    *Capacity    = NewCapacity;
+  }
+
+  CopyMem (*HttpHeaders + *SizeofHeaders, Fragment->Bulk, Fragment->Len);
+  *(*HttpHeaders + *BufferSize) = '\0';
+
+  //
+  // The end of the headers can only be in the new data, or straddle it.
+  //
+  SearchStart = 0;
+  if (*SizeofHeaders > AsciiStrLen (HTTP_END_OF_HDR_STR) - 1) {
+    SearchStart = *SizeofHeaders - (AsciiStrLen (HTTP_END_OF_HDR_STR) - 1);
+  }
+
+  *SizeofHeaders               = *BufferSize;
+  *(HttpInstance->EndofHeader) = AsciiStrStr (*HttpHeaders + SearchStart, HTTP_END_OF_HDR_STR);
+
+  return EFI_SUCCESS;
+}
+
 /**
   Receive the HTTP header by processing the associated HTTP token.
 
@@ -1855,7 +1926,7 @@ HttpTcpReceiveHeader (
   EFI_TCP6_PROTOCOL  *Tcp6;
   CHAR8              **EndofHeader;
   CHAR8              **HttpHeaders;
-  CHAR8              *Buffer;
+  UINTN              Capacity;
   NET_FRAGMENT       Fragment;
 
   ASSERT (HttpInstance != NULL);
@@ -1864,7 +1935,7 @@ HttpTcpReceiveHeader (
   HttpHeaders   = HttpInstance->HttpHeaders;
   Tcp4          = HttpInstance->Tcp4;
   Tcp6          = HttpInstance->Tcp6;
-  Buffer        = NULL;
+  Capacity      = (*HttpHeaders != NULL) ? *SizeofHeaders : 0;
   Rx4Token      = NULL;
   Rx6Token      = NULL;
   Fragment.Len  = 0;
@@ -1941,33 +2012,12 @@ HttpTcpReceiveHeader (
       }
 
       //
-      // Append the response string along with a Null-terminator.
+      // Append the response string and check whether we received end of HTTP headers.
       //
-      *BufferSize = *SizeofHeaders + Fragment.Len;
-      Buffer      = AllocatePool (*BufferSize + 1);
-      if (Buffer == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
+      Status = HttpAppendHeaderFragment (HttpInstance, &Fragment, SizeofHeaders, BufferSize, &Capacity);
+      if (EFI_ERROR (Status)) {
         return Status;
       }
-
-      if (*HttpHeaders != NULL) {
-        CopyMem (Buffer, *HttpHeaders, *SizeofHeaders);
-        FreePool (*HttpHeaders);
-      }
-
-      CopyMem (
-        Buffer + *SizeofHeaders,
-        Fragment.Bulk,
-        Fragment.Len
-        );
-      *(Buffer + *BufferSize) = '\0';
-      *HttpHeaders            = Buffer;
-      *SizeofHeaders          = *BufferSize;
-
-      //
-      // Check whether we received end of HTTP headers.
-      //
-      *EndofHeader = AsciiStrStr (*HttpHeaders, HTTP_END_OF_HDR_STR);
     }
 
     //
@@ -2041,33 +2091,12 @@ HttpTcpReceiveHeader (
       }
 
       //
-      // Append the response string along with a Null-terminator.
+      // Append the response string and check whether we received end of HTTP headers.
       //
-      *BufferSize = *SizeofHeaders + Fragment.Len;
-      Buffer      = AllocatePool (*BufferSize + 1);
-      if (Buffer == NULL) {
-        Status = EFI_OUT_OF_RESOURCES;
+      Status = HttpAppendHeaderFragment (HttpInstance, &Fragment, SizeofHeaders, BufferSize, &Capacity);
+      if (EFI_ERROR (Status)) {
         return Status;
       }
-
-      if (*HttpHeaders != NULL) {
-        CopyMem (Buffer, *HttpHeaders, *SizeofHeaders);
-        FreePool (*HttpHeaders);
-      }
-
-      CopyMem (
-        Buffer + *SizeofHeaders,
-        Fragment.Bulk,
-        Fragment.Len
-        );
-      *(Buffer + *BufferSize) = '\0';
-      *HttpHeaders            = Buffer;
-      *SizeofHeaders          = *BufferSize;
-
-      //
-      // Check whether we received end of HTTP headers.
-      //
-      *EndofHeader = AsciiStrStr (*HttpHeaders, HTTP_END_OF_HDR_STR);
     }
 
     //
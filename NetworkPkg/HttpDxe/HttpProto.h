@@ -560,6 +560,36 @@ HttpTcpReceive (
   IN VOID          *Context
   );
 
+/**
+  Append a received fragment to the cached HTTP headers and look for the end
+  of the headers.
+
+  The header buffer grows geometrically rather than by one fragment at a
+  time, and only the newly received bytes (plus the three bytes before them,
+  in case the terminator spans two fragments) are searched for the end of
+  the headers, so that receiving large headers in many small fragments costs
+  time linear in the header size.
+
+  @param[in]       HttpInstance     The HTTP instance private data.
+  @param[in]       Fragment         The received fragment.
+  @param[in, out]  SizeofHeaders    The length of the cached header message.
+  @param[in, out]  BufferSize       The size of buffer to cache the header message.
+  @param[in, out]  Capacity         The allocated size of the header buffer, not
+                                    including the Null-terminator.
+
+  @retval EFI_SUCCESS               The fragment is appended.
+  @retval EFI_OUT_OF_RESOURCES      Failed to grow the header buffer.
+
+**/
+EFI_STATUS
+HttpAppendHeaderFragment (
+  IN     HTTP_PROTOCOL  *HttpInstance,
+  IN     NET_FRAGMENT   *Fragment,
+  IN OUT UINTN          *SizeofHeaders,
+  IN OUT UINTN          *BufferSize,
+  IN OUT UINTN          *Capacity
+  );
+
 /**
   Receive the HTTP header by processing the associated HTTP token.
 
@@ -2533,7 +2533,9 @@ ON_EXIT:
 }
 
 /**
-  Send the Data in a sequence of Data Out PDUs one by one.
+  Send the Data in a sequence of Data Out PDUs. The PDUs are handed to TCP
+  in a single transmit request, so that the whole burst is queued without
+  waiting for each PDU to complete.
 
   @param[in]  Data            The data to carry by Data Out PDUs.
   @param[in]  Lun             The LUN the data will be sent to.
@@ -2552,8 +2554,7 @@ IScsiSendDataOutPduSequence (
   )
 {
   LIST_ENTRY  *DataOutPduList;
-  LIST_ENTRY  *Entry;
-  NET_BUF     *Pdu;
+  NET_BUF     *Burst;
   EFI_STATUS  Status;
 
   //
@@ -2564,19 +2565,15 @@ IScsiSendDataOutPduSequence (
     return EFI_OUT_OF_RESOURCES;
   }
 
-  Status = EFI_SUCCESS;
-
   //
-  // Send the Data Out PDU's one by one.
+  // Chain the Data Out PDUs into one net buffer and send them together.
   //
-  NET_LIST_FOR_EACH (Entry, DataOutPduList) {
-    Pdu = NET_LIST_USER_STRUCT (Entry, NET_BUF, List);
-
-    Status = TcpIoTransmit (&Tcb->Conn->TcpIo, Pdu);
-
-    if (EFI_ERROR (Status)) {
-      break;
-    }
+  Burst = NetbufFromBufList (DataOutPduList, 0, 0, IScsiNbufExtFree, NULL);
+  if (Burst == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+  } else {
+    Status = TcpIoTransmit (&Tcb->Conn->TcpIo, Burst);
+    NetbufFree (Burst);
   }
 
   IScsiFreeNbufList (DataOutPduList);
@@ -3011,11 +3008,12 @@ IScsiExecuteScsiCommand (
   {
     //
     // Unsolicited Data-Out sequence is allowed. There is remaining SCSI
-    // OUT data, and the limit of FirstBurstLength is not reached.
+    // OUT data, and the limit of FirstBurstLength is not reached. The
+    // immediate data already sent counts against FirstBurstLength.
     //
     XferContext->TargetTransferTag = ISCSI_RESERVED_TAG;
     XferContext->DesiredLength     = MIN (
-                                       Session->FirstBurstLength,
+                                       Session->FirstBurstLength - XferContext->Offset,
                                        Packet->OutTransferLength - XferContext->Offset
                                        );
 
@@ -3170,8 +3168,8 @@ IScsiSessionInit (
   Session->MaxConnections       = ISCSI_MAX_CONNS_PER_SESSION;
   Session->InitialR2T           = FALSE;
   Session->ImmediateData        = TRUE;
-  Session->MaxBurstLength       = 262144;
-  Session->FirstBurstLength     = MAX_RECV_DATA_SEG_LEN_IN_FFP;
+  Session->MaxBurstLength       = ISCSI_MAX_BURST_LENGTH;
+  Session->FirstBurstLength     = ISCSI_MAX_BURST_LENGTH;
   Session->DefaultTime2Wait     = 2;
   Session->DefaultTime2Retain   = 20;
   Session->MaxOutstandingR2T    = DEFAULT_MAX_OUTSTANDING_R2T;
@@ -28,9 +28,16 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define ISCSI_MAX_CONNS_PER_SESSION  1
 
 #define DEFAULT_MAX_RECV_DATA_SEG_LEN  8192
-#define MAX_RECV_DATA_SEG_LEN_IN_FFP   65536
+#define MAX_RECV_DATA_SEG_LEN_IN_FFP   262144
 #define DEFAULT_MAX_OUTSTANDING_R2T    1
 
+//
+// The largest value allowed for MaxBurstLength and FirstBurstLength (RFC 7143).
+// Both use the Minimum result function, so proposing it lets the target's
+// limits decide the negotiated values.
+//
+#define ISCSI_MAX_BURST_LENGTH  0xFFFFFF
+
 #define ISCSI_VERSION_MAX  0x00
 #define ISCSI_VERSION_MIN  0x00
 
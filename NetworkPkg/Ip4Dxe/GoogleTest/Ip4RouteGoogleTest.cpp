@@ -0,0 +1,197 @@
+/** @file
+  Tests for the route lookup in Ip4Route.c.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <Library/GoogleTestLib.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include "../Ip4Impl.h"
+  #include "Ip4RouteGoogleTest.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////
+
+#define IP4(a, b, c, d)  (((IP4_ADDR)(a) << 24) | ((IP4_ADDR)(b) << 16) | ((IP4_ADDR)(c) << 8) | (IP4_ADDR)(d))
+
+#define GATEWAY_8        IP4 (192, 168, 0, 8)
+#define GATEWAY_16       IP4 (192, 168, 0, 16)
+#define GATEWAY_24       IP4 (192, 168, 0, 24)
+#define GATEWAY_DEFAULT  IP4 (192, 168, 0, 1)
+#define SOURCE           IP4 (192, 168, 0, 100)
+
+////////////////////////////////////////////////////////////////////////
+// Ip4FindRouteEntry and Ip4Route Tests
+////////////////////////////////////////////////////////////////////////
+
+class Ip4RouteTest : public ::testing::Test {
+public:
+  IP4_ROUTE_TABLE *RtTable;
+  IP4_ROUTE_TABLE *DefaultTable;
+
+protected:
+  virtual void
+  SetUp (
+    )
+  {
+    RtTable      = Ip4CreateRouteTable ();
+    DefaultTable = Ip4CreateRouteTable ();
+    ASSERT_NE (RtTable, (IP4_ROUTE_TABLE *)NULL);
+    ASSERT_NE (DefaultTable, (IP4_ROUTE_TABLE *)NULL);
+
+    //
+    // Chain the instance table to the default table as Ip4Config does.
+    //
+    RtTable->Next = DefaultTable;
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    Ip4FreeRouteTable (RtTable);
+    Ip4FreeRouteTable (DefaultTable);
+  }
+
+  //
+  // Return the next hop of the most specific route to Dst, or 0 if none.
+  //
+  IP4_ADDR
+  FindNextHop (
+    IP4_ROUTE_TABLE  *Table,
+    IP4_ADDR         Dst
+    )
+  {
+    IP4_ROUTE_ENTRY  *RtEntry;
+    IP4_ADDR         NextHop;
+
+    RtEntry = Ip4FindRouteEntry (Table, Dst);
+    if (RtEntry == NULL) {
+      return 0;
+    }
+
+    NextHop = RtEntry->NextHop;
+    Ip4FreeRouteEntry (RtEntry);
+    return NextHop;
+  }
+
+  //
+  // Route a packet through the route cache and return its next hop.
+  //
+  IP4_ADDR
+  RouteNextHop (
+    IP4_ADDR  Dst
+    )
+  {
+    IP4_ROUTE_CACHE_ENTRY  *RtCacheEntry;
+    IP4_ADDR               NextHop;
+
+    RtCacheEntry = Ip4Route (RtTable, Dst, SOURCE, IP4_ALLZERO_ADDRESS, FALSE);
+    if (RtCacheEntry == NULL) {
+      return 0;
+    }
+
+    NextHop = RtCacheEntry->NextHop;
+    Ip4FreeRouteCacheEntry (RtCacheEntry);
+    return NextHop;
+  }
+
+  VOID
+  AddOverlappingRoutes (
+    )
+  {
+    ASSERT_EQ (Ip4AddRoute (RtTable, IP4 (10, 0, 0, 0), IP4 (255, 0, 0, 0), GATEWAY_8), EFI_SUCCESS);
+    ASSERT_EQ (Ip4AddRoute (RtTable, IP4 (10, 1, 0, 0), IP4 (255, 255, 0, 0), GATEWAY_16), EFI_SUCCESS);
+    ASSERT_EQ (Ip4AddRoute (RtTable, IP4 (10, 1, 2, 0), IP4 (255, 255, 255, 0), GATEWAY_24), EFI_SUCCESS);
+  }
+};
+
+// Test Description:
+// The longest of several overlapping prefixes is chosen.
+TEST_F (Ip4RouteTest, OverlappingPrefixesLongestWins) {
+  AddOverlappingRoutes ();
+
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 1, 2, 3)), GATEWAY_24);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 1, 3, 3)), GATEWAY_16);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 2, 2, 3)), GATEWAY_8);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (11, 1, 2, 3)), (IP4_ADDR)0);
+}
+
+// Test Description:
+// The default route matches any destination without a more specific route,
+// and local routes take precedence over the chained default table.
+TEST_F (Ip4RouteTest, DefaultRoute) {
+  ASSERT_EQ (Ip4AddRoute (DefaultTable, IP4_ALLZERO_ADDRESS, IP4_ALLZERO_ADDRESS, GATEWAY_DEFAULT), EFI_SUCCESS);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (8, 8, 8, 8)), GATEWAY_DEFAULT);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 1, 2, 3)), GATEWAY_DEFAULT);
+
+  AddOverlappingRoutes ();
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (8, 8, 8, 8)), GATEWAY_DEFAULT);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 1, 2, 3)), GATEWAY_24);
+
+  //
+  // A /16 in the default table does not override the instance's /16.
+  //
+  ASSERT_EQ (Ip4AddRoute (DefaultTable, IP4 (10, 1, 0, 0), IP4 (255, 255, 0, 0), GATEWAY_DEFAULT), EFI_SUCCESS);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 1, 3, 3)), GATEWAY_16);
+
+  //
+  // A prefix only populated in the default table is still visited.
+  //
+  ASSERT_EQ (Ip4AddRoute (DefaultTable, IP4 (10, 2, 3, 0), IP4 (255, 255, 255, 0), GATEWAY_DEFAULT), EFI_SUCCESS);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 2, 3, 4)), GATEWAY_DEFAULT);
+}
+
+// Test Description:
+// Removing a route while cached lookups spawned from it exist purges them,
+// and the next lookup falls back to the next longest prefix.
+TEST_F (Ip4RouteTest, RemoveRouteWhileCacheIsLive) {
+  AddOverlappingRoutes ();
+
+  EXPECT_EQ (RouteNextHop (IP4 (10, 1, 2, 3)), GATEWAY_24);
+  EXPECT_EQ (RouteNextHop (IP4 (10, 1, 3, 3)), GATEWAY_16);
+
+  ASSERT_EQ (Ip4DelRoute (RtTable, IP4 (10, 1, 2, 0), IP4 (255, 255, 255, 0), GATEWAY_24), EFI_SUCCESS);
+  EXPECT_EQ (Ip4FindRouteCache (RtTable, IP4 (10, 1, 2, 3), SOURCE), (IP4_ROUTE_CACHE_ENTRY *)NULL);
+  EXPECT_EQ (RtTable->RouteAreaMap & LShiftU64 (1, 24), 0ULL);
+  EXPECT_EQ (RouteNextHop (IP4 (10, 1, 2, 3)), GATEWAY_16);
+
+  ASSERT_EQ (Ip4DelRoute (RtTable, IP4 (10, 1, 0, 0), IP4 (255, 255, 0, 0), GATEWAY_16), EFI_SUCCESS);
+  EXPECT_EQ (RouteNextHop (IP4 (10, 1, 2, 3)), GATEWAY_8);
+  EXPECT_EQ (RouteNextHop (IP4 (10, 1, 3, 3)), GATEWAY_8);
+
+  EXPECT_EQ (Ip4DelRoute (RtTable, IP4 (10, 1, 0, 0), IP4 (255, 255, 0, 0), GATEWAY_16), EFI_NOT_FOUND);
+}
+
+// Test Description:
+// A route added while the cache is live is found for new destinations, and
+// removing one of two routes of the same length keeps the area searched.
+TEST_F (Ip4RouteTest, AddRouteWhileCacheIsLive) {
+  ASSERT_EQ (Ip4AddRoute (RtTable, IP4 (10, 0, 0, 0), IP4 (255, 0, 0, 0), GATEWAY_8), EFI_SUCCESS);
+  EXPECT_EQ (RouteNextHop (IP4 (10, 1, 2, 3)), GATEWAY_8);
+
+  ASSERT_EQ (Ip4AddRoute (RtTable, IP4 (10, 1, 2, 0), IP4 (255, 255, 255, 0), GATEWAY_24), EFI_SUCCESS);
+  ASSERT_EQ (Ip4AddRoute (RtTable, IP4 (10, 1, 4, 0), IP4 (255, 255, 255, 0), GATEWAY_16), EFI_SUCCESS);
+  EXPECT_EQ (RouteNextHop (IP4 (10, 1, 2, 4)), GATEWAY_24);
+  EXPECT_EQ (RouteNextHop (IP4 (10, 1, 4, 4)), GATEWAY_16);
+
+  ASSERT_EQ (Ip4DelRoute (RtTable, IP4 (10, 1, 2, 0), IP4 (255, 255, 255, 0), GATEWAY_24), EFI_SUCCESS);
+  EXPECT_NE (RtTable->RouteAreaMap & LShiftU64 (1, 24), 0ULL);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 1, 4, 5)), GATEWAY_16);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 1, 2, 5)), GATEWAY_8);
+}
+
+// Test Description:
+// Host routes (/32) are the most specific prefixes.
+TEST_F (Ip4RouteTest, HostRoute) {
+  AddOverlappingRoutes ();
+  ASSERT_EQ (Ip4AddRoute (RtTable, IP4 (10, 1, 2, 3), IP4_ALLONE_ADDRESS, GATEWAY_DEFAULT), EFI_SUCCESS);
+
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 1, 2, 3)), GATEWAY_DEFAULT);
+  EXPECT_EQ (FindNextHop (RtTable, IP4 (10, 1, 2, 4)), GATEWAY_24);
+}
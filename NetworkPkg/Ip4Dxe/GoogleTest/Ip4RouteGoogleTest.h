@@ -0,0 +1,40 @@
+/** @file
+  Exposes the functions needed to test the Ip4Route module.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef IP4_ROUTE_GOOGLE_TEST_H_
+#define IP4_ROUTE_GOOGLE_TEST_H_
+
+#include <Uefi.h>
+#include "../Ip4Impl.h"
+
+/**
+  Search the route table for a most specific match to the Dst.
+
+  @param[in]  RtTable               The route table to search from
+  @param[in]  Dst                   The destination address to search
+
+  @return NULL if no route matches the Dst, otherwise the point to the
+          most specific route to the Dst.
+
+**/
+IP4_ROUTE_ENTRY *
+Ip4FindRouteEntry (
+  IN IP4_ROUTE_TABLE  *RtTable,
+  IN IP4_ADDR         Dst
+  );
+
+/**
+  Free the route table entry. It is reference counted.
+
+  @param  RtEntry               The route entry to free.
+
+**/
+VOID
+Ip4FreeRouteEntry (
+  IN IP4_ROUTE_ENTRY  *RtEntry
+  );
+
+#endif // IP4_ROUTE_GOOGLE_TEST_H_
@@ -187,8 +187,9 @@ Ip4CreateRouteTable (
     return NULL;
   }
 
-  RtTable->RefCnt   = 1;
-  RtTable->TotalNum = 0;
+  RtTable->RefCnt       = 1;
+  RtTable->TotalNum     = 0;
+  RtTable->RouteAreaMap = 0;
 
   for (Index = 0; Index <= IP4_MASK_MAX; Index++) {
     InitializeListHead (&(RtTable->RouteArea[Index]));
@@ -298,12 +299,14 @@ Ip4AddRoute (
   LIST_ENTRY       *Head;
   LIST_ENTRY       *Entry;
   IP4_ROUTE_ENTRY  *RtEntry;
+  INTN             Len;
 
   //
   // All the route entries with the same netmask length are
   // linke to the same route area
   //
-  Head = &(RtTable->RouteArea[NetGetMaskLength (Netmask)]);
+  Len  = NetGetMaskLength (Netmask);
+  Head = &(RtTable->RouteArea[Len]);
 
   //
   // First check whether the route exists
@@ -330,6 +333,7 @@ Ip4AddRoute (
   }
 
   InsertHeadList (Head, &RtEntry->Link);
+  RtTable->RouteAreaMap |= LShiftU64 (1, Len);
   RtTable->TotalNum++;
 
   return EFI_SUCCESS;
@@ -360,8 +364,10 @@ Ip4DelRoute (
   LIST_ENTRY       *Entry;
   LIST_ENTRY       *Next;
   IP4_ROUTE_ENTRY  *RtEntry;
+  INTN             Len;
 
-  Head = &(RtTable->RouteArea[NetGetMaskLength (Netmask)]);
+  Len  = NetGetMaskLength (Netmask);
+  Head = &(RtTable->RouteArea[Len]);
 
   NET_LIST_FOR_EACH_SAFE (Entry, Next, Head) {
     RtEntry = NET_LIST_USER_STRUCT (Entry, IP4_ROUTE_ENTRY, Link);
@@ -371,6 +377,10 @@ Ip4DelRoute (
       RemoveEntryList (Entry);
       Ip4FreeRouteEntry (RtEntry);
 
+      if (IsListEmpty (Head)) {
+        RtTable->RouteAreaMap &= ~LShiftU64 (1, Len);
+      }
+
       RtTable->TotalNum--;
       return EFI_SUCCESS;
     }
@@ -422,7 +432,8 @@ Ip4FindRouteCache (
   Search the route table for a most specific match to the Dst. It searches
   from the longest route area (mask length == 32) to the shortest route area
   (default routes). In each route area, it will first search the instance's
-  route table, then the default route table. This is required by the following
+  route table, then the default route table. Only the route areas populated in
+  at least one of the chained tables are visited. This is required by the following
   requirements:
   1. IP search the route table for a most specific match
   2. The local route entries have precedence over the default route entry.
@@ -443,11 +454,19 @@ Ip4FindRouteEntry (
   LIST_ENTRY       *Entry;
   IP4_ROUTE_ENTRY  *RtEntry;
   IP4_ROUTE_TABLE  *Table;
+  UINT64           Map;
   INTN             Index;
 
   RtEntry = NULL;
+  Map     = 0;
+
+  for (Table = RtTable; Table != NULL; Table = Table->Next) {
+    Map |= Table->RouteAreaMap;
+  }
+
+  for (Index = HighBitSet64 (Map); Index >= 0; Index = HighBitSet64 (Map)) {
+    Map &= ~LShiftU64 (1, Index);
 
-  for (Index = IP4_MASK_MAX; Index >= 0; Index--) {
     for (Table = RtTable; Table != NULL; Table = Table->Next) {
       NET_LIST_FOR_EACH (Entry, &Table->RouteArea[Index]) {
         RtEntry = NET_LIST_USER_STRUCT (Entry, IP4_ROUTE_ENTRY, Link);
@@ -71,6 +71,8 @@ typedef struct {
 /// All the route table entries with the same mask are linked
 /// together in one route area. For example, RouteArea[0] contains
 /// the default routes. A route table also contains a route cache.
+/// RouteAreaMap has bit N set when RouteArea[N] is not empty, so
+/// that the lookup only visits the populated mask lengths.
 ///
 typedef struct _IP4_ROUTE_TABLE IP4_ROUTE_TABLE;
 
@@ -78,6 +80,7 @@ struct _IP4_ROUTE_TABLE {
   INTN               RefCnt;
   UINT32             TotalNum;
   LIST_ENTRY         RouteArea[IP4_MASK_NUM];
+  UINT64             RouteAreaMap;
   IP4_ROUTE_TABLE    *Next;
   IP4_ROUTE_CACHE    Cache;
 };
@@ -0,0 +1,266 @@
+/** @file
+  Tests for the route lookup in Ip6Route.c.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <Library/GoogleTestLib.h>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include "../Ip6Impl.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These functions are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+
+VOID
+Ip6CopyAddressByPrefix (
+  OUT EFI_IPv6_ADDRESS  *Dest,
+  IN  EFI_IPv6_ADDRESS  *Src,
+  IN  UINT8             PrefixLength
+  )
+{
+  UINT8  Byte;
+  UINT8  Bit;
+
+  ZeroMem (Dest, sizeof (EFI_IPv6_ADDRESS));
+  Byte = PrefixLength / 8;
+  Bit  = PrefixLength % 8;
+
+  CopyMem (Dest, Src, Byte);
+  if (Bit != 0) {
+    Dest->Addr[Byte] = (UINT8)(Src->Addr[Byte] & (0xFF << (8 - Bit)));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////
+// Ip6FindRouteEntry and Ip6Route Tests
+////////////////////////////////////////////////////////////////////////
+
+class Ip6RouteTest : public ::testing::Test {
+public:
+  IP6_SERVICE IpSb;
+  IP6_ROUTE_TABLE *RtTable;
+  EFI_IPv6_ADDRESS Source;
+  EFI_IPv6_ADDRESS Gateway[4];
+
+protected:
+  virtual void
+  SetUp (
+    )
+  {
+    UINT8  Index;
+
+    RtTable = Ip6CreateRouteTable ();
+    ASSERT_NE (RtTable, (IP6_ROUTE_TABLE *)NULL);
+
+    ZeroMem (&IpSb, sizeof (IpSb));
+    IpSb.RouteTable = RtTable;
+
+    Source = Address (0xfe80, 0, 0x100);
+    for (Index = 0; Index < ARRAY_SIZE (Gateway); Index++) {
+      Gateway[Index] = Address (0xfe80, 0, Index + 1);
+    }
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    Ip6CleanRouteTable (RtTable);
+  }
+
+  //
+  // Build the address Prefix:Subnet::Host.
+  //
+  EFI_IPv6_ADDRESS
+  Address (
+    UINT16  Prefix,
+    UINT16  Subnet,
+    UINT16  Host
+    )
+  {
+    EFI_IPv6_ADDRESS  Ip;
+
+    ZeroMem (&Ip, sizeof (Ip));
+    Ip.Addr[0]  = (UINT8)(Prefix >> 8);
+    Ip.Addr[1]  = (UINT8)Prefix;
+    Ip.Addr[2]  = (UINT8)(Subnet >> 8);
+    Ip.Addr[3]  = (UINT8)Subnet;
+    Ip.Addr[14] = (UINT8)(Host >> 8);
+    Ip.Addr[15] = (UINT8)Host;
+    return Ip;
+  }
+
+  EFI_STATUS
+  AddRoute (
+    EFI_IPv6_ADDRESS  Destination,
+    UINT8             PrefixLength,
+    EFI_IPv6_ADDRESS  *NextHop
+    )
+  {
+    return Ip6AddRoute (RtTable, &Destination, PrefixLength, NextHop);
+  }
+
+  EFI_STATUS
+  DelRoute (
+    EFI_IPv6_ADDRESS  Destination,
+    UINT8             PrefixLength,
+    EFI_IPv6_ADDRESS  *NextHop
+    )
+  {
+    return Ip6DelRoute (RtTable, &Destination, PrefixLength, NextHop);
+  }
+
+  //
+  // Return the index in Gateway of the next hop of the most specific route
+  // to Dst, or -1 if none.
+  //
+  INTN
+  FindGateway (
+    EFI_IPv6_ADDRESS  Dst
+    )
+  {
+    IP6_ROUTE_ENTRY  *RtEntry;
+    INTN             Index;
+
+    RtEntry = Ip6FindRouteEntry (RtTable, &Dst, NULL);
+    if (RtEntry == NULL) {
+      return -1;
+    }
+
+    for (Index = 0; Index < (INTN)ARRAY_SIZE (Gateway); Index++) {
+      if (EFI_IP6_EQUAL (&RtEntry->NextHop, &Gateway[Index])) {
+        break;
+      }
+    }
+
+    Ip6FreeRouteEntry (RtEntry);
+    return Index;
+  }
+
+  //
+  // Route a packet through the route cache and return the index in Gateway
+  // of its next hop, or -1 if none.
+  //
+  INTN
+  RouteGateway (
+    EFI_IPv6_ADDRESS  Dst
+    )
+  {
+    IP6_ROUTE_CACHE_ENTRY  *RtCacheEntry;
+    INTN                   Index;
+
+    RtCacheEntry = Ip6Route (&IpSb, &Dst, &Source);
+    if (RtCacheEntry == NULL) {
+      return -1;
+    }
+
+    for (Index = 0; Index < (INTN)ARRAY_SIZE (Gateway); Index++) {
+      if (EFI_IP6_EQUAL (&RtCacheEntry->NextHop, &Gateway[Index])) {
+        break;
+      }
+    }
+
+    Ip6FreeRouteCacheEntry (RtCacheEntry);
+    return Index;
+  }
+
+  VOID
+  AddOverlappingRoutes (
+    )
+  {
+    //
+    // 2001::/16 via 0, 2001:db8::/32 via 1, 2001:db8::/100 via 2
+    //
+    ASSERT_EQ (AddRoute (Address (0x2001, 0, 0), 16, &Gateway[0]), EFI_SUCCESS);
+    ASSERT_EQ (AddRoute (Address (0x2001, 0xdb8, 0), 32, &Gateway[1]), EFI_SUCCESS);
+    ASSERT_EQ (AddRoute (Address (0x2001, 0xdb8, 0), 100, &Gateway[2]), EFI_SUCCESS);
+  }
+};
+
+// Test Description:
+// The longest of several overlapping prefixes is chosen, including prefixes
+// in different words of the route area map.
+TEST_F (Ip6RouteTest, OverlappingPrefixesLongestWins) {
+  AddOverlappingRoutes ();
+
+  EXPECT_EQ (FindGateway (Address (0x2001, 0xdb8, 5)), 2);
+  EXPECT_EQ (FindGateway (Address (0x2001, 0xdb9, 5)), 0);
+
+  //
+  // Differs from the /100 route in a bit beyond the first 64.
+  //
+  EFI_IPv6_ADDRESS  Dst = Address (0x2001, 0xdb8, 5);
+
+  Dst.Addr[8] = 0x80;
+  EXPECT_EQ (FindGateway (Dst), 1);
+
+  EXPECT_EQ (FindGateway (Address (0x2002, 0, 5)), -1);
+}
+
+// Test Description:
+// The default route matches any destination without a more specific route.
+TEST_F (Ip6RouteTest, DefaultRoute) {
+  ASSERT_EQ (AddRoute (Address (0, 0, 0), 0, &Gateway[3]), EFI_SUCCESS);
+  EXPECT_EQ (FindGateway (Address (0x2002, 0, 5)), 3);
+
+  AddOverlappingRoutes ();
+  EXPECT_EQ (FindGateway (Address (0x2002, 0, 5)), 3);
+  EXPECT_EQ (FindGateway (Address (0x2001, 0xdb8, 5)), 2);
+
+  ASSERT_EQ (DelRoute (Address (0, 0, 0), 0, &Gateway[3]), EFI_SUCCESS);
+  EXPECT_EQ (FindGateway (Address (0x2002, 0, 5)), -1);
+}
+
+// Test Description:
+// Removing a route while cached lookups spawned from it exist purges them,
+// and the next lookup falls back to the next longest prefix.
+TEST_F (Ip6RouteTest, RemoveRouteWhileCacheIsLive) {
+  EFI_IPv6_ADDRESS  Dst;
+
+  AddOverlappingRoutes ();
+  Dst = Address (0x2001, 0xdb8, 5);
+
+  EXPECT_EQ (RouteGateway (Dst), 2);
+
+  ASSERT_EQ (DelRoute (Address (0x2001, 0xdb8, 0), 100, &Gateway[2]), EFI_SUCCESS);
+  EXPECT_EQ (Ip6FindRouteCache (RtTable, &Dst, &Source), (IP6_ROUTE_CACHE_ENTRY *)NULL);
+  EXPECT_EQ (RouteGateway (Dst), 1);
+
+  ASSERT_EQ (DelRoute (Address (0x2001, 0xdb8, 0), 32, &Gateway[1]), EFI_SUCCESS);
+  EXPECT_EQ (RouteGateway (Dst), 0);
+
+  EXPECT_EQ (DelRoute (Address (0x2001, 0xdb8, 0), 32, &Gateway[1]), EFI_NOT_FOUND);
+}
+
+// Test Description:
+// A route added while the cache is live is found for new destinations.
+TEST_F (Ip6RouteTest, AddRouteWhileCacheIsLive) {
+  ASSERT_EQ (AddRoute (Address (0x2001, 0, 0), 16, &Gateway[0]), EFI_SUCCESS);
+  EXPECT_EQ (RouteGateway (Address (0x2001, 0xdb8, 5)), 0);
+
+  ASSERT_EQ (AddRoute (Address (0x2001, 0xdb8, 0), 100, &Gateway[2]), EFI_SUCCESS);
+  EXPECT_EQ (RouteGateway (Address (0x2001, 0xdb8, 6)), 2);
+}
+
+// Test Description:
+// A route area emptied without Ip6DelRoute, as the ND code does, is skipped
+// and dropped from the route area map on the next lookup.
+TEST_F (Ip6RouteTest, StaleRouteAreaIsTrimmed) {
+  IP6_ROUTE_ENTRY  *RtEntry;
+
+  AddOverlappingRoutes ();
+
+  RtEntry = NET_LIST_HEAD (&RtTable->RouteArea[100], IP6_ROUTE_ENTRY, Link);
+  RemoveEntryList (&RtEntry->Link);
+  Ip6FreeRouteEntry (RtEntry);
+
+  EXPECT_EQ (FindGateway (Address (0x2001, 0xdb8, 5)), 1);
+  EXPECT_EQ (RtTable->RouteAreaMap[100 / 64] & LShiftU64 (1, 100 % 64), 0ULL);
+}
@@ -246,6 +246,7 @@ Ip6ProcessPacketTooBig (
 
       RouteEntry->Flag = IP6_DIRECT_ROUTE | IP6_PACKET_TOO_BIG;
       InsertHeadList (&IpSb->RouteTable->RouteArea[128], &RouteEntry->Link);
+      IP6_ROUTE_AREA_MARK (IpSb->RouteTable, 128);
       IpSb->RouteTable->TotalNum++;
     } else {
       RouteEntry = Ip6FindRouteEntry (IpSb->RouteTable, DestAddress, NULL);
@@ -245,6 +245,7 @@ Ip6CreatePrefixListEntry (
 
     RtEntry->Flag = IP6_DIRECT_ROUTE;
     InsertHeadList (&IpSb->RouteTable->RouteArea[PrefixLength], &RtEntry->Link);
+    IP6_ROUTE_AREA_MARK (IpSb->RouteTable, PrefixLength);
     IpSb->RouteTable->TotalNum++;
   }
 
@@ -720,6 +721,7 @@ Ip6CreateDefaultRouter (
   }
 
   InsertHeadList (&IpSb->RouteTable->RouteArea[0], &RtEntry->Link);
+  IP6_ROUTE_AREA_MARK (IpSb->RouteTable, 0);
   IpSb->RouteTable->TotalNum++;
 
   InsertTailList (&IpSb->DefaultRouterList, &Entry->Link);
@@ -99,7 +99,8 @@ Ip6FreeRouteEntry (
   Search the route table for a most specific match to the Dst. It searches
   from the longest route area (prefix length == 128) to the shortest route area
   (default routes). In each route area, it will first search the instance's
-  route table, then the default route table. This is required per the following
+  route table, then the default route table. Route areas not marked in the
+  RouteAreaMap are skipped. This is required per the following
   requirements:
   1. IP search the route table for a most specific match.
   2. The local route entries have precedence over the default route entry.
@@ -123,25 +124,44 @@ Ip6FindRouteEntry (
 {
   LIST_ENTRY       *Entry;
   IP6_ROUTE_ENTRY  *RtEntry;
+  UINT64           Map;
+  INTN             Word;
+  INTN             Bit;
   INTN             Index;
 
   ASSERT (Destination != NULL || NextHop != NULL);
 
   RtEntry = NULL;
 
-  for (Index = IP6_PREFIX_MAX; Index >= 0; Index--) {
-    NET_LIST_FOR_EACH (Entry, &RtTable->RouteArea[Index]) {
-      RtEntry = NET_LIST_USER_STRUCT (Entry, IP6_ROUTE_ENTRY, Link);
+  for (Word = IP6_ROUTE_AREA_MAP_NUM - 1; Word >= 0; Word--) {
+    Map = RtTable->RouteAreaMap[Word];
 
-      if (Destination != NULL) {
-        if (NetIp6IsNetEqual (Destination, &RtEntry->Destination, RtEntry->PrefixLength)) {
-          NET_GET_REF (RtEntry);
-          return RtEntry;
-        }
-      } else if (NextHop != NULL) {
-        if (NetIp6IsNetEqual (NextHop, &RtEntry->NextHop, RtEntry->PrefixLength)) {
-          NET_GET_REF (RtEntry);
-          return RtEntry;
+    for (Bit = HighBitSet64 (Map); Bit >= 0; Bit = HighBitSet64 (Map)) {
+      Map   = Map & ~LShiftU64 (1, Bit);
+      Index = Word * 64 + Bit;
+
+      //
+      // Entries may be unlinked from a route area without going through
+      // Ip6DelRoute, so the map is trimmed here when an area turns out empty.
+      //
+      if (IsListEmpty (&RtTable->RouteArea[Index])) {
+        IP6_ROUTE_AREA_UNMARK (RtTable, Index);
+        continue;
+      }
+
+      NET_LIST_FOR_EACH (Entry, &RtTable->RouteArea[Index]) {
+        RtEntry = NET_LIST_USER_STRUCT (Entry, IP6_ROUTE_ENTRY, Link);
+
+        if (Destination != NULL) {
+          if (NetIp6IsNetEqual (Destination, &RtEntry->Destination, RtEntry->PrefixLength)) {
+            NET_GET_REF (RtEntry);
+            return RtEntry;
+          }
+        } else if (NextHop != NULL) {
+          if (NetIp6IsNetEqual (NextHop, &RtEntry->NextHop, RtEntry->PrefixLength)) {
+            NET_GET_REF (RtEntry);
+            return RtEntry;
+          }
         }
       }
     }
@@ -342,6 +362,10 @@ Ip6CreateRouteTable (
     InitializeListHead (&RtTable->RouteArea[Index]);
   }
 
+  for (Index = 0; Index < IP6_ROUTE_AREA_MAP_NUM; Index++) {
+    RtTable->RouteAreaMap[Index] = 0;
+  }
+
   for (Index = 0; Index < IP6_ROUTE_CACHE_HASH_SIZE; Index++) {
     InitializeListHead (&RtTable->Cache.CacheBucket[Index]);
     RtTable->Cache.CacheNum[Index] = 0;
@@ -483,6 +507,7 @@ Ip6AddRoute (
   }
 
   InsertHeadList (ListHead, &Route->Link);
+  IP6_ROUTE_AREA_MARK (RtTable, PrefixLength);
   RtTable->TotalNum++;
 
   return EFI_SUCCESS;
@@ -538,6 +563,10 @@ Ip6DelRoute (
     RtTable->TotalNum--;
   }
 
+  if (IsListEmpty (ListHead)) {
+    IP6_ROUTE_AREA_UNMARK (RtTable, PrefixLength);
+  }
+
   return TotalNum == RtTable->TotalNum ? EFI_NOT_FOUND : EFI_SUCCESS;
 }
 
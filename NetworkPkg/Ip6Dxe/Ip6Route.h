@@ -51,15 +51,26 @@ typedef struct {
 // All the route table entries with the same prefix length are linked
 // together in one route area. For example, RouteArea[0] contains
 // the default routes. A route table also contains a route cache.
+// RouteAreaMap has a bit set for each RouteArea that may be populated,
+// so that the lookup skips the empty prefix lengths.
 //
 
+#define IP6_ROUTE_AREA_MAP_NUM  ((IP6_PREFIX_NUM + 63) / 64)
+
 typedef struct _IP6_ROUTE_TABLE {
   INTN               RefCnt;
   UINT32             TotalNum;
   LIST_ENTRY         RouteArea[IP6_PREFIX_NUM];
+  UINT64             RouteAreaMap[IP6_ROUTE_AREA_MAP_NUM];
   IP6_ROUTE_CACHE    Cache;
 } IP6_ROUTE_TABLE;
 
+#define IP6_ROUTE_AREA_MARK(RtTable, PrefixLength) \
+  ((RtTable)->RouteAreaMap[(PrefixLength) / 64] |= LShiftU64 (1, (PrefixLength) % 64))
+
+#define IP6_ROUTE_AREA_UNMARK(RtTable, PrefixLength) \
+  ((RtTable)->RouteAreaMap[(PrefixLength) / 64] &= ~LShiftU64 (1, (PrefixLength) % 64))
+
 /**
   This is the worker function for IP6_ROUTE_CACHE_HASH(). It calculates the value
   as the index of the route cache bucket according to the prefix of two IPv6 addresses.
@@ -0,0 +1,261 @@
+/** @file
+  Tests for the windowed download (RFC7440) recovery in Mtftp4Rrq.c.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <Library/GoogleTestLib.h>
+#include <vector>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include "../Mtftp4Impl.h"
+  #include "Mtftp4RrqGoogleTest.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////
+
+#define TEST_BLOCK_SIZE   512
+#define TEST_WINDOW_SIZE  4
+#define TEST_FILE_BLOCKS  16
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These functions are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+
+//
+// The block numbers of the ACK packets sent, in order.
+//
+std::vector<UINT16>  mAckSent;
+
+VOID
+Mtftp4CleanOperation (
+  IN OUT MTFTP4_PROTOCOL  *Instance,
+  IN     EFI_STATUS       Result
+  )
+{
+}
+
+EFI_STATUS
+EFIAPI
+UdpIoSendDatagram (
+  IN  UDP_IO           *UdpIo,
+  IN  NET_BUF          *Packet,
+  IN  UDP_END_POINT    *EndPoint OPTIONAL,
+  IN  EFI_IP_ADDRESS   *Gateway  OPTIONAL,
+  IN  UDP_IO_CALLBACK  CallBack,
+  IN  VOID             *Context
+  )
+{
+  EFI_MTFTP4_PACKET  *Mtftp4Packet;
+
+  Mtftp4Packet = (EFI_MTFTP4_PACKET *)NetbufGetByte (Packet, 0, NULL);
+  if (NTOHS (Mtftp4Packet->OpCode) == EFI_MTFTP4_OPCODE_ACK) {
+    mAckSent.push_back (NTOHS (Mtftp4Packet->Ack.Block[0]));
+  }
+
+  //
+  // Drop the reference taken for the transmission as the sent callback would.
+  //
+  NetbufFree (Packet);
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+UdpIoRecvDatagram (
+  IN  UDP_IO           *UdpIo,
+  IN  UDP_IO_CALLBACK  CallBack,
+  IN  VOID             *Context,
+  IN  UINT32           HeadLen
+  )
+{
+  return EFI_SUCCESS;
+}
+
+UDP_IO *
+EFIAPI
+UdpIoCreateIo (
+  IN  EFI_HANDLE     Controller,
+  IN  EFI_HANDLE     ImageHandle,
+  IN  UDP_IO_CONFIG  Configure,
+  IN  UINT8          UdpVersion,
+  IN  VOID           *Context
+  )
+{
+  return NULL;
+}
+
+EFI_STATUS
+EFIAPI
+UdpIoFreeIo (
+  IN  UDP_IO  *UdpIo
+  )
+{
+  return EFI_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Mtftp4RrqHandleData Tests
+////////////////////////////////////////////////////////////////////////
+
+class Mtftp4RrqWindowTest : public ::testing::Test {
+public:
+  MTFTP4_PROTOCOL Instance;
+  EFI_MTFTP4_TOKEN Token;
+  UINT8 *FileBuffer;
+  UINT8 Packet[MTFTP4_DATA_HEAD_LEN + TEST_BLOCK_SIZE];
+
+protected:
+  virtual void
+  SetUp (
+    )
+  {
+    mAckSent.clear ();
+
+    FileBuffer = (UINT8 *)AllocateZeroPool (TEST_FILE_BLOCKS * TEST_BLOCK_SIZE);
+    ASSERT_NE (FileBuffer, (UINT8 *)NULL);
+
+    ZeroMem (&Token, sizeof (Token));
+    Token.Buffer     = FileBuffer;
+    Token.BufferSize = TEST_FILE_BLOCKS * TEST_BLOCK_SIZE;
+
+    ZeroMem (&Instance, sizeof (Instance));
+    InitializeListHead (&Instance.Blocks);
+    Instance.Token      = &Token;
+    Instance.Master     = TRUE;
+    Instance.BlkSize    = TEST_BLOCK_SIZE;
+    Instance.WindowSize = TEST_WINDOW_SIZE;
+    Instance.Timeout    = MTFTP4_DEFAULT_TIMEOUT;
+    Instance.MaxRetry   = MTFTP4_DEFAULT_RETRY;
+    ASSERT_EQ (Mtftp4InitBlockRange (&Instance.Blocks, 1, 0xffff), EFI_SUCCESS);
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    LIST_ENTRY  *Entry;
+
+    while (!IsListEmpty (&Instance.Blocks)) {
+      Entry = Instance.Blocks.ForwardLink;
+      RemoveEntryList (Entry);
+      FreePool (NET_LIST_USER_STRUCT (Entry, MTFTP4_BLOCK_RANGE, Link));
+    }
+
+    if (Instance.LastPacket != NULL) {
+      NetbufFree (Instance.LastPacket);
+    }
+
+    FreePool (FileBuffer);
+  }
+
+  //
+  // Deliver a full sized DATA block from the server.
+  //
+  EFI_STATUS
+  ReceiveBlock (
+    UINT16  BlockNum
+    )
+  {
+    EFI_MTFTP4_PACKET  *Data;
+    BOOLEAN            Completed;
+
+    Data              = (EFI_MTFTP4_PACKET *)Packet;
+    Data->Data.OpCode = HTONS (EFI_MTFTP4_OPCODE_DATA);
+    Data->Data.Block  = HTONS (BlockNum);
+    SetMem (Data->Data.Data, TEST_BLOCK_SIZE, (UINT8)BlockNum);
+
+    return Mtftp4RrqHandleData (&Instance, Data, sizeof (Packet), FALSE, &Completed);
+  }
+};
+
+// Test Description:
+// A window received in order is acknowledged once, with its last block.
+TEST_F (Mtftp4RrqWindowTest, InOrderWindowIsAckedOnce) {
+  for (UINT16 Block = 1; Block <= TEST_WINDOW_SIZE; Block++) {
+    ASSERT_EQ (ReceiveBlock (Block), EFI_SUCCESS);
+  }
+
+  ASSERT_EQ (mAckSent.size (), (size_t)1);
+  EXPECT_EQ (mAckSent[0], TEST_WINDOW_SIZE);
+}
+
+// Test Description:
+// Only the first block after a lost one is acknowledged, the rest of the
+// broken window in flight is not.
+TEST_F (Mtftp4RrqWindowTest, BrokenWindowIsAckedOnce) {
+  ASSERT_EQ (ReceiveBlock (1), EFI_SUCCESS);
+  ASSERT_EQ (ReceiveBlock (3), EFI_SUCCESS);
+  ASSERT_EQ (ReceiveBlock (4), EFI_SUCCESS);
+
+  ASSERT_EQ (mAckSent.size (), (size_t)1);
+  EXPECT_EQ (mAckSent[0], 1);
+}
+
+// Test Description:
+// When the first block of the window retransmitted by the server is lost
+// again, the recovery is restarted without waiting for the timeout.
+TEST_F (Mtftp4RrqWindowTest, LostFirstBlockOfRetransmittedWindowIsAcked) {
+  ASSERT_EQ (ReceiveBlock (1), EFI_SUCCESS);
+  ASSERT_EQ (ReceiveBlock (3), EFI_SUCCESS);
+  ASSERT_EQ (ReceiveBlock (4), EFI_SUCCESS);
+
+  //
+  // The server restarts from block 2, which is lost again.
+  //
+  ASSERT_EQ (ReceiveBlock (3), EFI_SUCCESS);
+  ASSERT_EQ (ReceiveBlock (4), EFI_SUCCESS);
+  ASSERT_EQ (ReceiveBlock (5), EFI_SUCCESS);
+
+  ASSERT_EQ (mAckSent.size (), (size_t)2);
+  EXPECT_EQ (mAckSent[0], 1);
+  EXPECT_EQ (mAckSent[1], 1);
+
+  //
+  // The next retransmission arrives intact.
+  //
+  for (UINT16 Block = 2; Block <= 5; Block++) {
+    ASSERT_EQ (ReceiveBlock (Block), EFI_SUCCESS);
+  }
+
+  ASSERT_EQ (mAckSent.size (), (size_t)3);
+  EXPECT_EQ (mAckSent[2], 5);
+}
+
+// Test Description:
+// A retransmission by the timer re-arms the recovery, so the next broken
+// window block is acknowledged even if it follows the last unexpected one.
+TEST_F (Mtftp4RrqWindowTest, RetransmitRearmsRecovery) {
+  ASSERT_EQ (ReceiveBlock (1), EFI_SUCCESS);
+  ASSERT_EQ (ReceiveBlock (3), EFI_SUCCESS);
+  ASSERT_EQ (mAckSent.size (), (size_t)1);
+
+  ASSERT_EQ (Mtftp4Retransmit (&Instance), EFI_SUCCESS);
+  ASSERT_EQ (mAckSent.size (), (size_t)2);
+
+  ASSERT_EQ (ReceiveBlock (4), EFI_SUCCESS);
+  ASSERT_EQ (mAckSent.size (), (size_t)3);
+  EXPECT_EQ (mAckSent[2], 1);
+}
+
+// Test Description:
+// Without a window, every unexpected block is acknowledged as before.
+TEST_F (Mtftp4RrqWindowTest, NoWindowAcksEveryUnexpectedBlock) {
+  Instance.WindowSize = 1;
+
+  ASSERT_EQ (ReceiveBlock (1), EFI_SUCCESS);
+  ASSERT_EQ (ReceiveBlock (3), EFI_SUCCESS);
+  ASSERT_EQ (ReceiveBlock (4), EFI_SUCCESS);
+
+  ASSERT_EQ (mAckSent.size (), (size_t)3);
+  EXPECT_EQ (mAckSent[0], 1);
+  EXPECT_EQ (mAckSent[1], 1);
+  EXPECT_EQ (mAckSent[2], 1);
+}
@@ -0,0 +1,52 @@
+/** @file
+  Exposes the functions needed to test the Mtftp4Rrq module.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef MTFTP4_RRQ_GOOGLE_TEST_H_
+#define MTFTP4_RRQ_GOOGLE_TEST_H_
+
+#include <Uefi.h>
+#include "../Mtftp4Impl.h"
+
+/**
+  Function to process the received data packets.
+
+  It will save the block then send back an ACK if it is active.
+
+  @param  Instance              The downloading MTFTP session
+  @param  Packet                The packet received
+  @param  Len                   The length of the packet
+  @param  Multicast             Whether this packet is multicast or unicast
+  @param  Completed             Return whether the download has completed
+
+  @retval EFI_SUCCESS           The data packet is successfully processed
+  @retval EFI_ABORTED           The download is aborted by the user
+  @retval EFI_BUFFER_TOO_SMALL  The user provided buffer is too small
+
+**/
+EFI_STATUS
+Mtftp4RrqHandleData (
+  IN     MTFTP4_PROTOCOL    *Instance,
+  IN     EFI_MTFTP4_PACKET  *Packet,
+  IN     UINT32             Len,
+  IN     BOOLEAN            Multicast,
+  OUT BOOLEAN               *Completed
+  );
+
+/**
+  Retransmit the last packet for the instance.
+
+  @param  Instance              The Mtftp instance
+
+  @retval EFI_SUCCESS           The last packet is retransmitted.
+  @retval Others                Failed to retransmit.
+
+**/
+EFI_STATUS
+Mtftp4Retransmit (
+  IN MTFTP4_PROTOCOL  *Instance
+  );
+
+#endif // MTFTP4_RRQ_GOOGLE_TEST_H_
@@ -87,6 +87,9 @@ Mtftp4CleanOperation (
   Instance->McastIp       = 0;
   Instance->McastPort     = 0;
   Instance->Master        = TRUE;
+
+  Instance->WindowRecoveryAcked = FALSE;
+  Instance->LastUnexpectedBlock = 0;
 }
 
 /**
@@ -126,6 +126,17 @@ struct _MTFTP4_PROTOCOL {
   //
   UINT64                    AckedBlock;
 
+  //
+  // Set once the ACK for the last in-order block has been sent in
+  // response to an unexpected block, and cleared when the next in-order
+  // block arrives or the ACK is retransmitted. RFC7440 only asks for one
+  // ACK per broken window. LastUnexpectedBlock is the last block of the
+  // broken window received, so that a retransmitted window whose first
+  // block is lost again is detected and acknowledged again.
+  //
+  BOOLEAN                   WindowRecoveryAcked;
+  UINT16                    LastUnexpectedBlock;
+
   //
   // The server's communication end point: IP and two ports. one for
   // initial request, one for its selected port.
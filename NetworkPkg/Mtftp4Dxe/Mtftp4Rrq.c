@@ -264,12 +264,32 @@ Mtftp4RrqHandleData (
   // expected one. If we are passive (Slave), save the block.
   //
   if (Instance->Master && (Expected != BlockNum)) {
+    //
+    // With a window larger than one block, the rest of a broken window is
+    // still in flight and every block of it is unexpected. Acknowledging
+    // each of them would make the server restart the window once per
+    // block, so only send the ACK for the first one. A block that does not
+    // follow the last unexpected one starts a window retransmitted by the
+    // server, whose first block is lost again, so acknowledge it again.
+    //
+    if (Instance->WindowRecoveryAcked && (BlockNum == (UINT16)(Instance->LastUnexpectedBlock + 1))) {
+      Instance->LastUnexpectedBlock = BlockNum;
+      return EFI_SUCCESS;
+    }
+
+    Instance->LastUnexpectedBlock = BlockNum;
+    if (Instance->WindowSize > 1) {
+      Instance->WindowRecoveryAcked = TRUE;
+    }
+
     //
     // If Expected is 0, (UINT16) (Expected - 1) is also the expected Ack number (65535).
     //
     return Mtftp4RrqSendAck (Instance, (UINT16)(Expected - 1));
   }
 
+  Instance->WindowRecoveryAcked = FALSE;
+
   Status = Mtftp4RrqSaveBlock (Instance, Packet, Len);
 
   if (EFI_ERROR (Status)) {
@@ -513,6 +513,12 @@ Mtftp4Retransmit (
 
   ASSERT (Instance->LastPacket != NULL);
 
+  //
+  // The server restarts the window on the retransmitted ACK, so the next
+  // unexpected block needs to be acknowledged again.
+  //
+  Instance->WindowRecoveryAcked = FALSE;
+
   ZeroMem (&UdpPoint, sizeof (UdpPoint));
   UdpPoint.RemoteAddr.Addr[0] = Instance->ServerIp;
 
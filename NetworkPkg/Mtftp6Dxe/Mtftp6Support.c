@@ -964,6 +964,9 @@ Mtftp6OperationClean (
   Instance->CurRetry       = 0;
   Instance->Timeout        = 0;
   Instance->IsMaster       = TRUE;
+
+  Instance->WindowRecoveryAcked = FALSE;
+  Instance->LastUnexpectedBlock = 0;
 }
 
 /**
@@ -1215,6 +1218,11 @@ Mtftp6OnTimerTick (
     // otherwise exit the transfer.
     //
     if (Instance->CurRetry < Instance->MaxRetry) {
+      //
+      // The server restarts the window on the retransmitted ACK, so the
+      // next unexpected block needs to be acknowledged again.
+      //
+      Instance->WindowRecoveryAcked = FALSE;
       Mtftp6TransmitPacket (Instance, Instance->LastPacket);
     } else {
       Mtftp6OperationClean (Instance, EFI_TIMEOUT);
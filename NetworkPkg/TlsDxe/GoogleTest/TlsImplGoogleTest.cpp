@@ -0,0 +1,409 @@
+/** @file
+  Tests for the session resumption cache and the record decryption in
+  TlsImpl.c.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+#include <Library/GoogleTestLib.h>
+#include <vector>
+
+extern "C" {
+  #include <Uefi.h>
+  #include <Library/BaseLib.h>
+  #include <Library/DebugLib.h>
+  #include <Library/BaseMemoryLib.h>
+  #include <Library/MemoryAllocationLib.h>
+  #include "../TlsImpl.h"
+  #include "TlsImplGoogleTest.h"
+}
+
+////////////////////////////////////////////////////////////////////////
+// Defines
+////////////////////////////////////////////////////////////////////////
+
+#define TEST_HOST_NAME  "www.example.com"
+
+////////////////////////////////////////////////////////////////////////
+// Symbol Definitions
+// These functions are not directly under test - but required to compile
+////////////////////////////////////////////////////////////////////////
+
+//
+// The session state handed out for a connection, and the one resumed. Like
+// TlsLib, the fake TLS object only hands out a session it received itself,
+// not the one it resumed.
+//
+UINT8    mSessionData[] = { 0x30, 0x82, 0x01, 0x02, 0x03 };
+UINTN    mResumeCount;
+BOOLEAN  mHasNewSession;
+
+//
+// Plain text the fake TLS object holds for TlsRead(). Like a stream, a read
+// is not bound to record boundaries: it returns up to mReadLimit bytes of
+// everything pending.
+//
+std::vector<UINT8>  mPlainText;
+UINTN               mReadLimit;
+UINTN               mTrafficInCount;
+
+EFI_STATUS
+EFIAPI
+TlsGetResumptionData (
+  IN     VOID   *Tls,
+  OUT    UINT8  *Data,
+  IN OUT UINTN  *DataSize
+  )
+{
+  if (!mHasNewSession) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (*DataSize < sizeof (mSessionData)) {
+    *DataSize = sizeof (mSessionData);
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  CopyMem (Data, mSessionData, sizeof (mSessionData));
+  *DataSize = sizeof (mSessionData);
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+TlsSetResumptionData (
+  IN     VOID         *Tls,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        DataSize
+  )
+{
+  mResumeCount++;
+  mHasNewSession = FALSE;
+  return EFI_SUCCESS;
+}
+
+INTN
+EFIAPI
+TlsCtrlTrafficIn (
+  IN     VOID   *Tls,
+  IN     VOID   *Buffer,
+  IN     UINTN  BufferSize
+  )
+{
+  UINT8  *Record;
+  UINT8  *End;
+  UINTN  Length;
+
+  mTrafficInCount++;
+
+  //
+  // "Decrypt" by dropping the record headers.
+  //
+  Record = (UINT8 *)Buffer;
+  End    = Record + BufferSize;
+  while (Record < End) {
+    Length = NTOHS (((TLS_RECORD_HEADER *)Record)->Length);
+    mPlainText.insert (mPlainText.end (), Record + TLS_RECORD_HEADER_LENGTH, Record + TLS_RECORD_HEADER_LENGTH + Length);
+    Record += TLS_RECORD_HEADER_LENGTH + Length;
+  }
+
+  return (INTN)BufferSize;
+}
+
+INTN
+EFIAPI
+TlsCtrlTrafficOut (
+  IN     VOID   *Tls,
+  IN OUT VOID   *Buffer,
+  IN     UINTN  BufferSize
+  )
+{
+  return -1;
+}
+
+INTN
+EFIAPI
+TlsRead (
+  IN     VOID   *Tls,
+  IN OUT VOID   *Buffer,
+  IN     UINTN  BufferSize
+  )
+{
+  UINTN  Size;
+
+  if (mPlainText.empty ()) {
+    return -1;
+  }
+
+  Size = MIN (MIN (BufferSize, mReadLimit), mPlainText.size ());
+  CopyMem (Buffer, mPlainText.data (), Size);
+  mPlainText.erase (mPlainText.begin (), mPlainText.begin () + Size);
+  return (INTN)Size;
+}
+
+INTN
+EFIAPI
+TlsWrite (
+  IN     VOID   *Tls,
+  IN     VOID   *Buffer,
+  IN     UINTN  BufferSize
+  )
+{
+  return -1;
+}
+
+////////////////////////////////////////////////////////////////////////
+// Session cache Tests
+////////////////////////////////////////////////////////////////////////
+
+class TlsSessionCacheTest : public ::testing::Test {
+public:
+  TLS_SERVICE Service;
+  TLS_INSTANCE Instance;
+
+protected:
+  virtual void
+  SetUp (
+    )
+  {
+    mResumeCount   = 0;
+    mHasNewSession = TRUE;
+
+    ZeroMem (&Service, sizeof (Service));
+    InitializeListHead (&Service.SessionCache);
+
+    ZeroMem (&Instance, sizeof (Instance));
+    Instance.Service         = &Service;
+    Instance.TlsConn         = (VOID *)&Instance;
+    Instance.HostName        = (CHAR8 *)AllocateCopyPool (sizeof (TEST_HOST_NAME), TEST_HOST_NAME);
+    Instance.VerifyMethod    = EFI_TLS_VERIFY_PEER;
+    Instance.VerifyHostFlags = EFI_TLS_VERIFY_FLAG_NONE;
+    ASSERT_NE (Instance.HostName, (CHAR8 *)NULL);
+  }
+
+  virtual void
+  TearDown (
+    )
+  {
+    TlsFlushSessionCache (&Service);
+    FreePool (Instance.HostName);
+  }
+};
+
+// Test Description:
+// A session is resumed by a connection with the same settings, once.
+TEST_F (TlsSessionCacheTest, SameSettingsResumeSession) {
+  TlsSaveSession (&Instance);
+  ASSERT_EQ (Service.SessionCacheNum, (UINTN)1);
+
+  TlsRestoreSession (&Instance);
+  EXPECT_EQ (mResumeCount, (UINTN)1);
+  EXPECT_EQ (Service.SessionCacheNum, (UINTN)0);
+
+  TlsRestoreSession (&Instance);
+  EXPECT_EQ (mResumeCount, (UINTN)1);
+}
+
+// Test Description:
+// A resumed session is not saved again when no new ticket was received, but
+// a new ticket is.
+TEST_F (TlsSessionCacheTest, OnlyNewTicketIsSaved) {
+  TlsSaveSession (&Instance);
+  TlsRestoreSession (&Instance);
+  ASSERT_EQ (mResumeCount, (UINTN)1);
+
+  TlsSaveSession (&Instance);
+  EXPECT_EQ (Service.SessionCacheNum, (UINTN)0);
+
+  mHasNewSession = TRUE;
+  TlsSaveSession (&Instance);
+  EXPECT_EQ (Service.SessionCacheNum, (UINTN)1);
+}
+
+// Test Description:
+// A session established without peer verification is not resumed by a
+// connection that requires it.
+TEST_F (TlsSessionCacheTest, VerifyMethodIsPartOfKey) {
+  Instance.VerifyMethod = EFI_TLS_VERIFY_NONE;
+  TlsSaveSession (&Instance);
+  ASSERT_EQ (Service.SessionCacheNum, (UINTN)1);
+
+  Instance.VerifyMethod = EFI_TLS_VERIFY_PEER;
+  EXPECT_EQ (TlsFindSession (&Service, &Instance), (TLS_SESSION_CACHE_ENTRY *)NULL);
+
+  TlsRestoreSession (&Instance);
+  EXPECT_EQ (mResumeCount, (UINTN)0);
+}
+
+// Test Description:
+// A session established with looser host name checks is not resumed by a
+// connection that uses stricter ones.
+TEST_F (TlsSessionCacheTest, VerifyHostFlagsArePartOfKey) {
+  TlsSaveSession (&Instance);
+  ASSERT_EQ (Service.SessionCacheNum, (UINTN)1);
+
+  Instance.VerifyHostFlags = EFI_TLS_VERIFY_FLAG_NO_WILDCARDS;
+  EXPECT_EQ (TlsFindSession (&Service, &Instance), (TLS_SESSION_CACHE_ENTRY *)NULL);
+
+  TlsRestoreSession (&Instance);
+  EXPECT_EQ (mResumeCount, (UINTN)0);
+
+  //
+  // Both sessions are kept side by side.
+  //
+  TlsSaveSession (&Instance);
+  EXPECT_EQ (Service.SessionCacheNum, (UINTN)2);
+}
+
+// Test Description:
+// A session is not resumed with a different set of trusted CA certificates.
+TEST_F (TlsSessionCacheTest, CaCertDigestIsPartOfKey) {
+  TlsSaveSession (&Instance);
+
+  Instance.CaCertDigest[0] ^= 0xFF;
+  TlsRestoreSession (&Instance);
+  EXPECT_EQ (mResumeCount, (UINTN)0);
+}
+
+// Test Description:
+// Saving a session again for the same settings replaces the old one.
+TEST_F (TlsSessionCacheTest, SaveReplacesSession) {
+  TlsSaveSession (&Instance);
+  TlsSaveSession (&Instance);
+  EXPECT_EQ (Service.SessionCacheNum, (UINTN)1);
+}
+
+////////////////////////////////////////////////////////////////////////
+// TlsDecryptPacket Tests
+////////////////////////////////////////////////////////////////////////
+
+class TlsDecryptPacketTest : public ::testing::Test {
+public:
+  TLS_INSTANCE Instance;
+  std::vector<UINT8> Packet;
+
+protected:
+  virtual void
+  SetUp (
+    )
+  {
+    mPlainText.clear ();
+    mReadLimit      = MAX_UINTN;
+    mTrafficInCount = 0;
+
+    ZeroMem (&Instance, sizeof (Instance));
+    Instance.TlsConn         = (VOID *)&Instance;
+    Instance.TlsSessionState = EfiTlsSessionDataTransferring;
+  }
+
+  //
+  // Append an application data record of Length bytes of Fill.
+  //
+  void
+  AddRecord (
+    UINT16  Length,
+    UINT8   Fill
+    )
+  {
+    TLS_RECORD_HEADER  Header;
+
+    Header.ContentType   = TlsContentTypeApplicationData;
+    Header.Version.Major = 3;
+    Header.Version.Minor = 3;
+    Header.Length        = HTONS (Length);
+    Packet.insert (Packet.end (), (UINT8 *)&Header, (UINT8 *)&Header + TLS_RECORD_HEADER_LENGTH);
+    Packet.insert (Packet.end (), Length, Fill);
+  }
+
+  //
+  // Decrypt Packet and check that the output holds Records records whose
+  // payloads are, in order, the Expected plain text.
+  //
+  void
+  DecryptAndCheck (
+    UINT32                     Records,
+    const std::vector<UINT8>  &Expected
+    )
+  {
+    EFI_TLS_FRAGMENT_DATA  Fragment;
+    EFI_TLS_FRAGMENT_DATA  *FragmentTable;
+    UINT32                 FragmentCount;
+    std::vector<UINT8>     PlainText;
+    TLS_RECORD_HEADER      *Header;
+    UINT8                  *Out;
+    UINT8                  *End;
+    UINT32                 Count;
+
+    Fragment.FragmentBuffer = Packet.data ();
+    Fragment.FragmentLength = (UINT32)Packet.size ();
+    FragmentTable           = &Fragment;
+    FragmentCount           = 1;
+
+    ASSERT_EQ (TlsDecryptPacket (&Instance, &FragmentTable, &FragmentCount), EFI_SUCCESS);
+    ASSERT_EQ (FragmentCount, (UINT32)1);
+    EXPECT_EQ (mTrafficInCount, (UINTN)1);
+
+    Out   = (UINT8 *)FragmentTable[0].FragmentBuffer;
+    End   = Out + FragmentTable[0].FragmentLength;
+    Count = 0;
+    while (Out < End) {
+      Header = (TLS_RECORD_HEADER *)Out;
+      EXPECT_EQ (Header->ContentType, TlsContentTypeApplicationData);
+      PlainText.insert (PlainText.end (), Out + TLS_RECORD_HEADER_LENGTH, Out + TLS_RECORD_HEADER_LENGTH + Header->Length);
+      Out += TLS_RECORD_HEADER_LENGTH + Header->Length;
+      Count++;
+    }
+
+    EXPECT_EQ (Out, End);
+    EXPECT_EQ (Count, Records);
+    EXPECT_TRUE (PlainText == Expected);
+
+    FreePool (FragmentTable[0].FragmentBuffer);
+    FreePool (FragmentTable);
+  }
+};
+
+// Test Description:
+// All records of a packet are handed to the TLS object at once, and their
+// plain text is returned in order.
+TEST_F (TlsDecryptPacketTest, RecordsAreDecryptedInOneBatch) {
+  std::vector<UINT8>  Expected;
+
+  AddRecord (100, 0xA1);
+  AddRecord (200, 0xB2);
+  AddRecord (50, 0xC3);
+  Expected.insert (Expected.end (), 100, 0xA1);
+  Expected.insert (Expected.end (), 200, 0xB2);
+  Expected.insert (Expected.end (), 50, 0xC3);
+
+  DecryptAndCheck (1, Expected);
+}
+
+// Test Description:
+// Reads returning less than a record lose no plain text.
+TEST_F (TlsDecryptPacketTest, ShortReadsLoseNoData) {
+  std::vector<UINT8>  Expected;
+
+  mReadLimit = 30;
+  AddRecord (100, 0xA1);
+  AddRecord (200, 0xB2);
+  Expected.insert (Expected.end (), 100, 0xA1);
+  Expected.insert (Expected.end (), 200, 0xB2);
+
+  DecryptAndCheck (1, Expected);
+}
+
+// Test Description:
+// Plain text beyond the maximum payload length of one record is split across
+// output records.
+TEST_F (TlsDecryptPacketTest, FullRecordsAreSplit) {
+  std::vector<UINT8>  Expected;
+
+  AddRecord (TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH, 0xA1);
+  AddRecord (TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH, 0xB2);
+  AddRecord (10, 0xC3);
+  Expected.insert (Expected.end (), TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH, 0xA1);
+  Expected.insert (Expected.end (), TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH, 0xB2);
+  Expected.insert (Expected.end (), 10, 0xC3);
+
+  DecryptAndCheck (3, Expected);
+}
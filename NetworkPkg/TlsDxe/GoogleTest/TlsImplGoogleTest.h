@@ -0,0 +1,28 @@
+/** @file
+  Exposes the functions needed to test the TlsImpl module.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef TLS_IMPL_GOOGLE_TEST_H_
+#define TLS_IMPL_GOOGLE_TEST_H_
+
+#include <Uefi.h>
+#include "../TlsImpl.h"
+
+/**
+  Find the session cache entry saved for the server of a TLS instance.
+
+  @param[in]  Service             The TLS service data.
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+  @return The cache entry, or NULL if there is none.
+
+**/
+TLS_SESSION_CACHE_ENTRY *
+TlsFindSession (
+  IN TLS_SERVICE   *Service,
+  IN TLS_INSTANCE  *TlsInstance
+  );
+
+#endif // TLS_IMPL_GOOGLE_TEST_H_
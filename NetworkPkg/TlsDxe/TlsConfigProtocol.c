@@ -60,6 +60,15 @@ TlsConfigurationSetData (
   switch (DataType) {
     case EfiTlsConfigDataTypeCACertificate:
       Status = TlsSetCaCertificate (Instance->TlsConn, Data, DataSize);
+      if (!EFI_ERROR (Status)) {
+        //
+        // A session is only resumed with the CA certificates it was verified with.
+        //
+        if (!Sha256HashAll (Data, DataSize, Instance->CaCertDigest)) {
+          Status = EFI_ABORTED;
+        }
+      }
+
       break;
     case EfiTlsConfigDataTypeHostPublicCert:
       Status = TlsSetHostPublicCert (Instance->TlsConn, Data, DataSize);
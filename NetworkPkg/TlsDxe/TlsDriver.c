@@ -27,9 +27,17 @@ TlsCleanInstance (
 {
   if (Instance != NULL) {
     if (Instance->TlsConn != NULL) {
+      if (Instance->TlsSessionState == EfiTlsSessionDataTransferring) {
+        TlsSaveSession (Instance);
+      }
+
       TlsFree (Instance->TlsConn);
     }
 
+    if (Instance->HostName != NULL) {
+      FreePool (Instance->HostName);
+    }
+
     FreePool (Instance);
   }
 }
@@ -86,6 +94,8 @@ TlsCleanService (
   )
 {
   if (Service != NULL) {
+    TlsFlushSessionCache (Service);
+
     if (Service->TlsCtx != NULL) {
       TlsCtxFree (Service->TlsCtx);
     }
@@ -132,6 +142,8 @@ TlsCreateService (
   TlsService->TlsChildrenNum = 0;
   InitializeListHead (&TlsService->TlsChildrenList);
   TlsService->ImageHandle = Image;
+  InitializeListHead (&TlsService->SessionCache);
+  TlsService->SessionCacheNum = 0;
 
   *Service = TlsService;
 
@@ -26,6 +26,11 @@
 
 #define TLS_INSTANCE_SIGNATURE  SIGNATURE_32 ('T', 'L', 'S', 'I')
 
+//
+// Maximum number of servers whose resumable session is kept by the service.
+//
+#define TLS_SESSION_CACHE_MAX_ENTRIES  8
+
 ///
 /// TLS Service Data
 ///
@@ -36,6 +41,19 @@ typedef struct _TLS_SERVICE TLS_SERVICE;
 ///
 typedef struct _TLS_INSTANCE TLS_INSTANCE;
 
+///
+/// Resumable session saved for one server.
+///
+typedef struct {
+  LIST_ENTRY                  Link;
+  CHAR8                       *HostName;
+  EFI_TLS_VERIFY              VerifyMethod;
+  EFI_TLS_VERIFY_HOST_FLAG    VerifyHostFlags;
+  UINT8                       CaCertDigest[SHA256_DIGEST_SIZE];
+  UINT8                       *Data;
+  UINTN                       DataSize;
+} TLS_SESSION_CACHE_ENTRY;
+
 struct _TLS_SERVICE {
   UINT32                          Signature;
   EFI_SERVICE_BINDING_PROTOCOL    ServiceBinding;
@@ -55,6 +73,14 @@ struct _TLS_SERVICE {
   // created for the connections.
   //
   VOID                            *TlsCtx;
+
+  //
+  // Resumable sessions of previous connections, most recently saved first.
+  // Entries are keyed on the verified host name, the verification settings
+  // and the CA certificates that were trusted for it, see TlsSaveSession ().
+  //
+  LIST_ENTRY                      SessionCache;
+  UINTN                           SessionCacheNum;
 };
 
 struct _TLS_INSTANCE {
@@ -76,6 +102,17 @@ struct _TLS_INSTANCE {
   // per established connection.
   //
   VOID                              *TlsConn;
+
+  //
+  // Host name and flags set through EfiTlsVerifyHost, method set through
+  // EfiTlsVerifyMethod and digest of the CA certificates set through
+  // EfiTlsConfigDataTypeCACertificate. All are used to look up a resumable
+  // session in the service's session cache.
+  //
+  CHAR8                             *HostName;
+  EFI_TLS_VERIFY                    VerifyMethod;
+  EFI_TLS_VERIFY_HOST_FLAG          VerifyHostFlags;
+  UINT8                             CaCertDigest[SHA256_DIGEST_SIZE];
 };
 
 #define TLS_SERVICE_FROM_THIS(a)   \
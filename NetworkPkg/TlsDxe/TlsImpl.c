@@ -9,6 +9,75 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "TlsImpl.h"
 
+/**
+  Get a linear view of the data listed in fragment.
+
+  A single fragment is used in place; multiple fragments are copied into a
+  newly allocated buffer, which the caller must free.
+
+  @param[in]   FragmentTable  Pointer to a list of fragment.
+  @param[in]   FragmentCount  Number of fragment.
+  @param[out]  Buffer         Pointer to the linear data.
+  @param[out]  BufferSize     Size of the linear data in bytes.
+  @param[out]  BufferCopy     Pointer to the allocated copy, or NULL if the
+                              fragment is used in place.
+
+  @retval EFI_SUCCESS             The operation completed successfully.
+  @retval EFI_OUT_OF_RESOURCES    Can't allocate memory resources.
+**/
+EFI_STATUS
+TlsGatherFragments (
+  IN     EFI_TLS_FRAGMENT_DATA  *FragmentTable,
+  IN     UINT32                 FragmentCount,
+  OUT    UINT8                  **Buffer,
+  OUT    UINT32                 *BufferSize,
+  OUT    UINT8                  **BufferCopy
+  )
+{
+  UINTN   Index;
+  UINT32  BytesCopied;
+
+  *Buffer     = NULL;
+  *BufferSize = 0;
+  *BufferCopy = NULL;
+
+  //
+  // Calculate the size according to the fragment table.
+  //
+  for (Index = 0; Index < FragmentCount; Index++) {
+    *BufferSize += FragmentTable[Index].FragmentLength;
+  }
+
+  if (FragmentCount == 1) {
+    *Buffer = FragmentTable[0].FragmentBuffer;
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Allocate buffer for processing data.
+  //
+  *BufferCopy = AllocatePool (*BufferSize);
+  if (*BufferCopy == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Copy all TLS record header and payload into the buffer.
+  //
+  BytesCopied = 0;
+  for (Index = 0; Index < FragmentCount; Index++) {
+    CopyMem (
+      (*BufferCopy + BytesCopied),
+      FragmentTable[Index].FragmentBuffer,
+      FragmentTable[Index].FragmentLength
+      );
+    BytesCopied += FragmentTable[Index].FragmentLength;
+  }
+
+  *Buffer = *BufferCopy;
+  return EFI_SUCCESS;
+}
+
 /**
   Encrypt the message listed in fragment.
 
@@ -33,60 +102,33 @@ TlsEncryptPacket (
   )
 {
   EFI_STATUS         Status;
-  UINTN              Index;
-  UINT32             BytesCopied;
   UINT32             BufferInSize;
   UINT8              *BufferIn;
+  UINT8              *BufferInCopy;
   UINT8              *BufferInPtr;
   TLS_RECORD_HEADER  *RecordHeaderIn;
   UINT16             ThisPlainMessageSize;
-  TLS_RECORD_HEADER  *TempRecordHeader;
-  UINT16             ThisMessageSize;
   UINT32             BufferOutSize;
   UINT8              *BufferOut;
   UINT32             RecordCount;
   INTN               Ret;
 
-  Status           = EFI_SUCCESS;
-  BytesCopied      = 0;
-  BufferInSize     = 0;
-  BufferIn         = NULL;
-  BufferInPtr      = NULL;
-  RecordHeaderIn   = NULL;
-  TempRecordHeader = NULL;
-  BufferOutSize    = 0;
-  BufferOut        = NULL;
-  RecordCount      = 0;
-  Ret              = 0;
-
-  //
-  // Calculate the size according to the fragment table.
-  //
-  for (Index = 0; Index < *FragmentCount; Index++) {
-    BufferInSize += (*FragmentTable)[Index].FragmentLength;
-  }
-
-  //
-  // Allocate buffer for processing data.
-  //
-  BufferIn = AllocateZeroPool (BufferInSize);
-  if (BufferIn == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
+  Status         = EFI_SUCCESS;
+  BufferInSize   = 0;
+  BufferIn       = NULL;
+  BufferInCopy   = NULL;
+  BufferInPtr    = NULL;
+  RecordHeaderIn = NULL;
+  BufferOutSize  = 0;
+  BufferOut      = NULL;
+  RecordCount    = 0;
+  Ret            = 0;
+
+  Status = TlsGatherFragments (*FragmentTable, *FragmentCount, &BufferIn, &BufferInSize, &BufferInCopy);
+  if (EFI_ERROR (Status)) {
     goto ERROR;
   }
 
-  //
-  // Copy all TLS plain record header and payload into BufferIn.
-  //
-  for (Index = 0; Index < *FragmentCount; Index++) {
-    CopyMem (
-      (BufferIn + BytesCopied),
-      (*FragmentTable)[Index].FragmentBuffer,
-      (*FragmentTable)[Index].FragmentLength
-      );
-    BytesCopied += (*FragmentTable)[Index].FragmentLength;
-  }
-
   //
   // Count TLS record number.
   //
@@ -105,7 +147,7 @@ TlsEncryptPacket (
   //
   // Allocate enough buffer to hold TLS Ciphertext.
   //
-  BufferOut = AllocateZeroPool (RecordCount * (TLS_RECORD_HEADER_LENGTH + TLS_CIPHERTEXT_RECORD_MAX_PAYLOAD_LENGTH));
+  BufferOut = AllocatePool (RecordCount * (TLS_RECORD_HEADER_LENGTH + TLS_CIPHERTEXT_RECORD_MAX_PAYLOAD_LENGTH));
   if (BufferOut == NULL) {
     Status = EFI_OUT_OF_RESOURCES;
     goto ERROR;
@@ -113,9 +155,9 @@ TlsEncryptPacket (
 
   //
   // Parsing buffer. Received packet may have multiple TLS record messages.
+  // Each one is sealed into its own record in the TLS object.
   //
-  BufferInPtr      = BufferIn;
-  TempRecordHeader = (TLS_RECORD_HEADER *)BufferOut;
+  BufferInPtr = BufferIn;
   while ((UINTN)BufferInPtr < (UINTN)BufferIn + BufferInSize) {
     RecordHeaderIn = (TLS_RECORD_HEADER *)BufferInPtr;
 
@@ -123,27 +165,26 @@ TlsEncryptPacket (
 
     TlsWrite (TlsInstance->TlsConn, (UINT8 *)(RecordHeaderIn + 1), ThisPlainMessageSize);
 
-    Ret = TlsCtrlTrafficOut (TlsInstance->TlsConn, (UINT8 *)(TempRecordHeader), TLS_RECORD_HEADER_LENGTH + TLS_CIPHERTEXT_RECORD_MAX_PAYLOAD_LENGTH);
-
-    if (Ret > 0) {
-      ThisMessageSize = (UINT16)Ret;
-    } else {
-      //
-      // No data was successfully encrypted, continue to encrypt other messages.
-      //
-      DEBUG ((DEBUG_WARN, "TlsEncryptPacket: No data read from TLS object.\n"));
-
-      ThisMessageSize = 0;
-    }
-
-    BufferOutSize += ThisMessageSize;
+    BufferInPtr += TLS_RECORD_HEADER_LENGTH + ThisPlainMessageSize;
+  }
 
-    BufferInPtr     += TLS_RECORD_HEADER_LENGTH + ThisPlainMessageSize;
-    TempRecordHeader = (TLS_RECORD_HEADER *)((UINT8 *)TempRecordHeader + ThisMessageSize);
+  //
+  // Collect the ciphertext of all records at once.
+  //
+  Ret = TlsCtrlTrafficOut (TlsInstance->TlsConn, BufferOut, RecordCount * (TLS_RECORD_HEADER_LENGTH + TLS_CIPHERTEXT_RECORD_MAX_PAYLOAD_LENGTH));
+  if (Ret > 0) {
+    BufferOutSize = (UINT32)Ret;
+  } else {
+    //
+    // No data was successfully encrypted.
+    //
+    DEBUG ((DEBUG_WARN, "TlsEncryptPacket: No data read from TLS object.\n"));
   }
 
-  FreePool (BufferIn);
-  BufferIn = NULL;
+  if (BufferInCopy != NULL) {
+    FreePool (BufferInCopy);
+    BufferInCopy = NULL;
+  }
 
   //
   // The caller will be responsible to handle the original fragment table.
@@ -162,9 +203,9 @@ TlsEncryptPacket (
 
 ERROR:
 
-  if (BufferIn != NULL) {
-    FreePool (BufferIn);
-    BufferIn = NULL;
+  if (BufferInCopy != NULL) {
+    FreePool (BufferInCopy);
+    BufferInCopy = NULL;
   }
 
   if (BufferOut != NULL) {
@@ -199,23 +240,22 @@ TlsDecryptPacket (
   )
 {
   EFI_STATUS         Status;
-  UINTN              Index;
-  UINT32             BytesCopied;
   UINT8              *BufferIn;
+  UINT8              *BufferInCopy;
   UINT32             BufferInSize;
   UINT8              *BufferInPtr;
   TLS_RECORD_HEADER  *RecordHeaderIn;
-  UINT16             ThisCipherMessageSize;
   TLS_RECORD_HEADER  *TempRecordHeader;
   UINT16             ThisPlainMessageSize;
   UINT8              *BufferOut;
   UINT32             BufferOutSize;
   UINT32             RecordCount;
+  UINT32             RecordCountOut;
   INTN               Ret;
 
   Status           = EFI_SUCCESS;
-  BytesCopied      = 0;
   BufferIn         = NULL;
+  BufferInCopy     = NULL;
   BufferInSize     = 0;
   BufferInPtr      = NULL;
   RecordHeaderIn   = NULL;
@@ -223,36 +263,14 @@ TlsDecryptPacket (
   BufferOut        = NULL;
   BufferOutSize    = 0;
   RecordCount      = 0;
+  RecordCountOut   = 0;
   Ret              = 0;
 
-  //
-  // Calculate the size according to the fragment table.
-  //
-  for (Index = 0; Index < *FragmentCount; Index++) {
-    BufferInSize += (*FragmentTable)[Index].FragmentLength;
-  }
-
-  //
-  // Allocate buffer for processing data
-  //
-  BufferIn = AllocateZeroPool (BufferInSize);
-  if (BufferIn == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
+  Status = TlsGatherFragments (*FragmentTable, *FragmentCount, &BufferIn, &BufferInSize, &BufferInCopy);
+  if (EFI_ERROR (Status)) {
     goto ERROR;
   }
 
-  //
-  // Copy all TLS plain record header and payload to BufferIn
-  //
-  for (Index = 0; Index < *FragmentCount; Index++) {
-    CopyMem (
-      (BufferIn + BytesCopied),
-      (*FragmentTable)[Index].FragmentBuffer,
-      (*FragmentTable)[Index].FragmentLength
-      );
-    BytesCopied += (*FragmentTable)[Index].FragmentLength;
-  }
-
   //
   // Count TLS record number.
   //
@@ -271,53 +289,71 @@ TlsDecryptPacket (
   //
   // Allocate enough buffer to hold TLS Plaintext.
   //
-  BufferOut = AllocateZeroPool (RecordCount * (TLS_RECORD_HEADER_LENGTH + TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH));
+  BufferOut = AllocatePool (RecordCount * (TLS_RECORD_HEADER_LENGTH + TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH));
   if (BufferOut == NULL) {
     Status = EFI_OUT_OF_RESOURCES;
     goto ERROR;
   }
 
   //
-  // Parsing buffer. Received packet may have multiple TLS record messages.
+  // Hand all TLS records to the TLS object at once.
   //
-  BufferInPtr      = BufferIn;
-  TempRecordHeader = (TLS_RECORD_HEADER *)BufferOut;
-  while ((UINTN)BufferInPtr < (UINTN)BufferIn + BufferInSize) {
-    RecordHeaderIn = (TLS_RECORD_HEADER *)BufferInPtr;
-
-    ThisCipherMessageSize = NTOHS (RecordHeaderIn->Length);
+  Ret = TlsCtrlTrafficIn (TlsInstance->TlsConn, BufferIn, BufferInSize);
+  if (Ret != (INTN)BufferInSize) {
+    TlsInstance->TlsSessionState = EfiTlsSessionError;
+    Status                       = EFI_ABORTED;
+    goto ERROR;
+  }
 
-    Ret = TlsCtrlTrafficIn (TlsInstance->TlsConn, (UINT8 *)(RecordHeaderIn), TLS_RECORD_HEADER_LENGTH + ThisCipherMessageSize);
-    if (Ret != TLS_RECORD_HEADER_LENGTH + ThisCipherMessageSize) {
-      TlsInstance->TlsSessionState = EfiTlsSessionError;
-      Status                       = EFI_ABORTED;
-      goto ERROR;
+  //
+  // Read the plain text back as a stream, as a read may return less or more
+  // than one record. Each output record is filled up to the maximum payload
+  // length, so no more output records than input records are needed.
+  //
+  RecordHeaderIn   = (TLS_RECORD_HEADER *)BufferIn;
+  TempRecordHeader = (TLS_RECORD_HEADER *)BufferOut;
+  while (RecordCountOut < RecordCount) {
+    ThisPlainMessageSize = 0;
+    while (ThisPlainMessageSize < TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH) {
+      Ret = TlsRead (
+              TlsInstance->TlsConn,
+              (UINT8 *)(TempRecordHeader + 1) + ThisPlainMessageSize,
+              TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH - ThisPlainMessageSize
+              );
+      if (Ret <= 0) {
+        break;
+      }
+
+      ThisPlainMessageSize = (UINT16)(ThisPlainMessageSize + Ret);
     }
 
-    Ret = 0;
-    Ret = TlsRead (TlsInstance->TlsConn, (UINT8 *)(TempRecordHeader + 1), TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH);
+    if (ThisPlainMessageSize == 0) {
+      if (RecordCountOut != 0) {
+        break;
+      }
 
-    if (Ret > 0) {
-      ThisPlainMessageSize = (UINT16)Ret;
-    } else {
       //
-      // No data was successfully decrypted, continue to decrypt other messages.
+      // No data was successfully decrypted, return an empty record.
       //
       DEBUG ((DEBUG_WARN, "TlsDecryptPacket: No data read from TLS object.\n"));
-
-      ThisPlainMessageSize = 0;
     }
 
     CopyMem (TempRecordHeader, RecordHeaderIn, TLS_RECORD_HEADER_LENGTH);
     TempRecordHeader->Length = ThisPlainMessageSize;
     BufferOutSize           += TLS_RECORD_HEADER_LENGTH + ThisPlainMessageSize;
+    RecordCountOut++;
+
+    if (ThisPlainMessageSize < TLS_PLAINTEXT_RECORD_MAX_PAYLOAD_LENGTH) {
+      break;
+    }
 
-    BufferInPtr     += TLS_RECORD_HEADER_LENGTH + ThisCipherMessageSize;
     TempRecordHeader = (TLS_RECORD_HEADER *)((UINT8 *)TempRecordHeader + TLS_RECORD_HEADER_LENGTH + ThisPlainMessageSize);
   }
 
-  FreePool (BufferIn);
-  BufferIn = NULL;
+  if (BufferInCopy != NULL) {
+    FreePool (BufferInCopy);
+    BufferInCopy = NULL;
+  }
 
   //
   // The caller will be responsible to handle the original fragment table
@@ -336,9 +372,9 @@ TlsDecryptPacket (
 
 ERROR:
 
-  if (BufferIn != NULL) {
-    FreePool (BufferIn);
-    BufferIn = NULL;
+  if (BufferInCopy != NULL) {
+    FreePool (BufferInCopy);
+    BufferInCopy = NULL;
   }
 
   if (BufferOut != NULL) {
@@ -348,3 +384,204 @@ ERROR:
 
   return Status;
 }
+
+/**
+  Find the session cache entry saved for the server of a TLS instance.
+
+  A session only matches if it was established with the same host name,
+  the same verification method and host flags and the same trusted CA
+  certificates, so that a session set up with weaker checks is never
+  resumed by a connection that requires stronger ones.
+
+  @param[in]  Service             The TLS service data.
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+  @return The cache entry, or NULL if there is none.
+
+**/
+TLS_SESSION_CACHE_ENTRY *
+TlsFindSession (
+  IN TLS_SERVICE   *Service,
+  IN TLS_INSTANCE  *TlsInstance
+  )
+{
+  LIST_ENTRY               *Entry;
+  TLS_SESSION_CACHE_ENTRY  *CacheEntry;
+
+  NET_LIST_FOR_EACH (Entry, &Service->SessionCache) {
+    CacheEntry = NET_LIST_USER_STRUCT (Entry, TLS_SESSION_CACHE_ENTRY, Link);
+    if ((AsciiStrCmp (CacheEntry->HostName, TlsInstance->HostName) == 0) &&
+        (CacheEntry->VerifyMethod == TlsInstance->VerifyMethod) &&
+        (CacheEntry->VerifyHostFlags == TlsInstance->VerifyHostFlags) &&
+        (CompareMem (CacheEntry->CaCertDigest, TlsInstance->CaCertDigest, SHA256_DIGEST_SIZE) == 0))
+    {
+      return CacheEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Remove a session cache entry and free it.
+
+  @param[in]  Service             The TLS service data.
+  @param[in]  CacheEntry          The cache entry to free.
+
+**/
+VOID
+TlsFreeSession (
+  IN TLS_SERVICE              *Service,
+  IN TLS_SESSION_CACHE_ENTRY  *CacheEntry
+  )
+{
+  RemoveEntryList (&CacheEntry->Link);
+  Service->SessionCacheNum--;
+
+  ZeroMem (CacheEntry->Data, CacheEntry->DataSize);
+  FreePool (CacheEntry->Data);
+  FreePool (CacheEntry->HostName);
+  FreePool (CacheEntry);
+}
+
+/**
+  Save the resumable session of a TLS instance in the service's session cache.
+
+  Only a session or session ticket newly received on the connection is saved.
+  Nothing is saved if no host name was set for the instance, since the
+  session could then not be matched to a server later.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsSaveSession (
+  IN TLS_INSTANCE  *TlsInstance
+  )
+{
+  TLS_SERVICE              *Service;
+  TLS_SESSION_CACHE_ENTRY  *CacheEntry;
+  UINT8                    *Data;
+  UINTN                    DataSize;
+  EFI_STATUS               Status;
+
+  Service = TlsInstance->Service;
+
+  if ((TlsInstance->HostName == NULL) || (TlsInstance->TlsConn == NULL)) {
+    return;
+  }
+
+  DataSize = 0;
+  Status   = TlsGetResumptionData (TlsInstance->TlsConn, NULL, &DataSize);
+  if (Status != EFI_BUFFER_TOO_SMALL) {
+    return;
+  }
+
+  Data = AllocatePool (DataSize);
+  if (Data == NULL) {
+    return;
+  }
+
+  Status = TlsGetResumptionData (TlsInstance->TlsConn, Data, &DataSize);
+  if (EFI_ERROR (Status)) {
+    FreePool (Data);
+    return;
+  }
+
+  CacheEntry = TlsFindSession (Service, TlsInstance);
+  if (CacheEntry != NULL) {
+    TlsFreeSession (Service, CacheEntry);
+  } else if (Service->SessionCacheNum >= TLS_SESSION_CACHE_MAX_ENTRIES) {
+    //
+    // Evict the oldest session.
+    //
+    TlsFreeSession (
+      Service,
+      NET_LIST_TAIL (&Service->SessionCache, TLS_SESSION_CACHE_ENTRY, Link)
+      );
+  }
+
+  CacheEntry = AllocateZeroPool (sizeof (TLS_SESSION_CACHE_ENTRY));
+  if (CacheEntry == NULL) {
+    FreePool (Data);
+    return;
+  }
+
+  CacheEntry->HostName = AllocateCopyPool (AsciiStrSize (TlsInstance->HostName), TlsInstance->HostName);
+  if (CacheEntry->HostName == NULL) {
+    FreePool (CacheEntry);
+    FreePool (Data);
+    return;
+  }
+
+  CacheEntry->VerifyMethod    = TlsInstance->VerifyMethod;
+  CacheEntry->VerifyHostFlags = TlsInstance->VerifyHostFlags;
+  CopyMem (CacheEntry->CaCertDigest, TlsInstance->CaCertDigest, SHA256_DIGEST_SIZE);
+  CacheEntry->Data     = Data;
+  CacheEntry->DataSize = DataSize;
+
+  InsertHeadList (&Service->SessionCache, &CacheEntry->Link);
+  Service->SessionCacheNum++;
+}
+
+/**
+  Resume a session saved for the same server, verification settings and
+  CA certificates, if any.
+
+  The session is removed from the cache, since a TLS 1.3 session ticket must
+  only be used once. This must be called before the ClientHello is built. A failure to resume
+  is not an error, the handshake then simply falls back to a full one.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsRestoreSession (
+  IN TLS_INSTANCE  *TlsInstance
+  )
+{
+  TLS_SERVICE              *Service;
+  TLS_SESSION_CACHE_ENTRY  *CacheEntry;
+  EFI_STATUS               Status;
+
+  Service = TlsInstance->Service;
+
+  if (TlsInstance->HostName == NULL) {
+    return;
+  }
+
+  CacheEntry = TlsFindSession (Service, TlsInstance);
+  if (CacheEntry == NULL) {
+    return;
+  }
+
+  //
+  // Whether or not the session can be resumed, it is not offered again. A new
+  // session or ticket received on this connection is saved when it is closed.
+  //
+  Status = TlsSetResumptionData (TlsInstance->TlsConn, CacheEntry->Data, CacheEntry->DataSize);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "TlsRestoreSession: Saved session is unusable - %r\n", Status));
+  }
+
+  TlsFreeSession (Service, CacheEntry);
+}
+
+/**
+  Release all the sessions saved in the service's session cache.
+
+  @param[in]  Service             The TLS service data.
+
+**/
+VOID
+TlsFlushSessionCache (
+  IN TLS_SERVICE  *Service
+  )
+{
+  while (!IsListEmpty (&Service->SessionCache)) {
+    TlsFreeSession (
+      Service,
+      NET_LIST_HEAD (&Service->SessionCache, TLS_SESSION_CACHE_ENTRY, Link)
+      );
+  }
+}
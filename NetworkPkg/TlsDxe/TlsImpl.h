@@ -40,6 +40,31 @@ extern EFI_SERVICE_BINDING_PROTOCOL    mTlsServiceBinding;
 extern EFI_TLS_PROTOCOL                mTlsProtocol;
 extern EFI_TLS_CONFIGURATION_PROTOCOL  mTlsConfigurationProtocol;
 
+/**
+  Get a linear view of the data listed in fragment.
+
+  A single fragment is used in place; multiple fragments are copied into a
+  newly allocated buffer, which the caller must free.
+
+  @param[in]   FragmentTable  Pointer to a list of fragment.
+  @param[in]   FragmentCount  Number of fragment.
+  @param[out]  Buffer         Pointer to the linear data.
+  @param[out]  BufferSize     Size of the linear data in bytes.
+  @param[out]  BufferCopy     Pointer to the allocated copy, or NULL if the
+                              fragment is used in place.
+
+  @retval EFI_SUCCESS             The operation completed successfully.
+  @retval EFI_OUT_OF_RESOURCES    Can't allocate memory resources.
+**/
+EFI_STATUS
+TlsGatherFragments (
+  IN     EFI_TLS_FRAGMENT_DATA  *FragmentTable,
+  IN     UINT32                 FragmentCount,
+  OUT    UINT8                  **Buffer,
+  OUT    UINT32                 *BufferSize,
+  OUT    UINT8                  **BufferCopy
+  );
+
 /**
   Encrypt the message listed in fragment.
 
@@ -86,6 +111,47 @@ TlsDecryptPacket (
   IN     UINT32                 *FragmentCount
   );
 
+/**
+  Save the resumable session of a TLS instance in the service's session cache.
+
+  Only a session or session ticket newly received on the connection is saved.
+  Nothing is saved if no host name was set for the instance, since the
+  session could then not be matched to a server later.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsSaveSession (
+  IN TLS_INSTANCE  *TlsInstance
+  );
+
+/**
+  Resume a session saved for the same server and CA certificates, if any.
+
+  The session is removed from the cache, since a TLS 1.3 session ticket must
+  only be used once. This must be called before the ClientHello is built. A failure to resume
+  is not an error, the handshake then simply falls back to a full one.
+
+  @param[in]  TlsInstance         The pointer to the TLS instance.
+
+**/
+VOID
+TlsRestoreSession (
+  IN TLS_INSTANCE  *TlsInstance
+  );
+
+/**
+  Release all the sessions saved in the service's session cache.
+
+  @param[in]  Service             The TLS service data.
+
+**/
+VOID
+TlsFlushSessionCache (
+  IN TLS_SERVICE  *Service
+  );
+
 /**
   Set TLS session data.
 
@@ -152,6 +152,7 @@ TlsSetSessionData (
       }
 
       TlsSetVerify (Instance->TlsConn, *((UINT32 *)Data));
+      Instance->VerifyMethod = *((EFI_TLS_VERIFY *)Data);
       break;
     case EfiTlsVerifyHost:
       if (DataSize != sizeof (EFI_TLS_VERIFY_HOST)) {
@@ -192,6 +193,24 @@ TlsSetSessionData (
       }
 
       Status = TlsSetServerName (Instance->TlsConn, Instance->Service->TlsCtx, TlsVerifyHost->HostName);
+      if (EFI_ERROR (Status)) {
+        goto ON_EXIT;
+      }
+
+      //
+      // Remember the host name to look up a resumable session for it.
+      //
+      if (Instance->HostName != NULL) {
+        FreePool (Instance->HostName);
+      }
+
+      Instance->HostName = AllocateCopyPool (AsciiStrSize (TlsVerifyHost->HostName), TlsVerifyHost->HostName);
+      if (Instance->HostName == NULL) {
+        Status = EFI_OUT_OF_RESOURCES;
+      }
+
+      Instance->VerifyHostFlags = TlsVerifyHost->Flags;
+
       break;
     case EfiTlsSessionID:
       if (DataSize != sizeof (EFI_TLS_SESSION_ID)) {
@@ -489,8 +508,10 @@ TlsBuildResponsePacket (
     switch (Instance->TlsSessionState) {
       case EfiTlsSessionNotStarted:
         //
-        // ClientHello.
+        // ClientHello. Offer to resume the last session with the same server.
         //
+        TlsRestoreSession (Instance);
+
         Status = TlsDoHandshake (
                    Instance->TlsConn,
                    NULL,
@@ -514,6 +535,12 @@ TlsBuildResponsePacket (
 
         break;
       case EfiTlsSessionClosing:
+        //
+        // Save the session, including the tickets received since the handshake,
+        // before it is invalidated by the CloseNotify.
+        //
+        TlsSaveSession (Instance);
+
         //
         // TLS session will be closed and response packet needs to be CloseNotify.
         //
@@ -225,6 +225,12 @@ EfiPxeBcStart (
     Private->BlockSize = (UINTN)PcdGet64 (PcdTftpBlockSize);
   }
 
+  //
+  // PcdPxeTftpWindowSize is the largest window requested. The window used
+  // is shrunk on timeout and grown back on successful downloads.
+  //
+  Private->TftpWindowSize = (UINTN)PcdGet64 (PcdPxeTftpWindowSize);
+
   //
   // Create event for UdpRead/UdpWrite timeout since they are both blocking API.
   //
@@ -878,9 +884,9 @@ EfiPxeBcMtftp (
   Mode    = Private->PxeBc.Mode;
 
   //
-  // Get PcdPxeTftpWindowSize.
+  // Get the current adaptive window size, bounded by PcdPxeTftpWindowSize.
   //
-  WindowSize = (UINTN)PcdGet64 (PcdPxeTftpWindowSize);
+  WindowSize = Private->TftpWindowSize;
 
   if (Mode->UsingIpv6) {
     if (!NetIp6IsValidUnicast (&ServerIp->v6)) {
@@ -946,18 +952,39 @@ EfiPxeBcMtftp (
 
     case EFI_PXE_BASE_CODE_TFTP_READ_FILE:
       //
-      // Send TFTP request to read file.
+      // Send TFTP request to read file. A timeout after some data has been
+      // received with a window larger than one block usually means the path
+      // drops bursts, e.g. a relay with a small queue, so halve the window
+      // and try again. A timeout without any data means the server is not
+      // reachable, which a smaller window does not help.
       //
-      Status = PxeBcTftpReadFile (
-                 Private,
-                 Config,
-                 Filename,
-                 BlockSize,
-                 (WindowSize > 1) ? &WindowSize : NULL,
-                 BufferPtr,
-                 BufferSize,
-                 DontUseBuffer
-                 );
+      while (TRUE) {
+        Private->TftpDataReceived = FALSE;
+        Status                    = PxeBcTftpReadFile (
+                                      Private,
+                                      Config,
+                                      Filename,
+                                      BlockSize,
+                                      (WindowSize > 1) ? &WindowSize : NULL,
+                                      BufferPtr,
+                                      BufferSize,
+                                      DontUseBuffer
+                                      );
+        if ((Status != EFI_TIMEOUT) || (WindowSize <= 1) || !Private->TftpDataReceived) {
+          break;
+        }
+
+        WindowSize              = WindowSize / 2;
+        Private->TftpWindowSize = WindowSize;
+        DEBUG ((DEBUG_INFO, "PxeBc: TFTP timeout, retry with windowsize %Lu\n", (UINT64)WindowSize));
+      }
+
+      //
+      // Grow the window back towards the configured size after a clean download.
+      //
+      if (!EFI_ERROR (Status) && (WindowSize < (UINTN)PcdGet64 (PcdPxeTftpWindowSize))) {
+        Private->TftpWindowSize = MIN (WindowSize << 1, (UINTN)PcdGet64 (PcdPxeTftpWindowSize));
+      }
 
       break;
 
@@ -180,6 +180,8 @@ struct _PXEBC_PRIVATE_DATA {
   UINT8                                        *BootFileName;
   UINTN                                        BootFileSize;
   UINTN                                        BlockSize;
+  UINTN                                        TftpWindowSize;
+  BOOLEAN                                      TftpDataReceived;
 
   PXEBC_DHCP_PACKET_CACHE                      ProxyOffer;
   PXEBC_DHCP_PACKET_CACHE                      DhcpAck;
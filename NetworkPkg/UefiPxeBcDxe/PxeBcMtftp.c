@@ -52,6 +52,13 @@ PxeBcMtftp6CheckPacket (
   Callback = Private->PxeBcCallback;
   Status   = EFI_SUCCESS;
 
+  if (NTOHS (Packet->OpCode) == EFI_MTFTP6_OPCODE_DATA) {
+    //
+    // Record that the server is reachable for the window size adaptation.
+    //
+    Private->TftpDataReceived = TRUE;
+  }
+
   if (NTOHS (Packet->OpCode) == EFI_MTFTP6_OPCODE_ERROR) {
     //
     // Store the tftp error message into mode data and set the received flag.
@@ -530,6 +537,13 @@ PxeBcMtftp4CheckPacket (
   Callback = Private->PxeBcCallback;
   Status   = EFI_SUCCESS;
 
+  if (NTOHS (Packet->OpCode) == EFI_MTFTP4_OPCODE_DATA) {
+    //
+    // Record that the server is reachable for the window size adaptation.
+    //
+    Private->TftpDataReceived = TRUE;
+  }
+
   if (NTOHS (Packet->OpCode) == EFI_MTFTP4_OPCODE_ERROR) {
     //
     // Store the tftp error message into mode data and set the received flag.
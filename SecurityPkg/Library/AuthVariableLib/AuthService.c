@@ -1041,9 +1041,256 @@ ProcessVariable (
   return Status;
 }
 
+//
+// One EFI_SIGNATURE_DATA of the original data, indexed by FilterSignatureList().
+//
+typedef struct {
+  EFI_GUID    *SignatureType;
+  UINT32      SignatureSize;
+  UINT8       *Signature;
+} SIGNATURE_DATA_INDEX_ENTRY;
+
+/**
+  Compare two SIGNATURE_DATA_INDEX_ENTRY by signature size, signature type
+  and signature content.
+
+  @param[in]  Buffer1   Pointer to the first SIGNATURE_DATA_INDEX_ENTRY.
+  @param[in]  Buffer2   Pointer to the second SIGNATURE_DATA_INDEX_ENTRY.
+
+  @retval 0       The two entries describe the same signature.
+  @retval <0      Buffer1 is less than Buffer2.
+  @retval >0      Buffer1 is greater than Buffer2.
+
+**/
+STATIC
+INTN
+EFIAPI
+CompareSignatureDataIndexEntry (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST SIGNATURE_DATA_INDEX_ENTRY  *Entry1;
+  CONST SIGNATURE_DATA_INDEX_ENTRY  *Entry2;
+  INTN                              Result;
+
+  Entry1 = (CONST SIGNATURE_DATA_INDEX_ENTRY *)Buffer1;
+  Entry2 = (CONST SIGNATURE_DATA_INDEX_ENTRY *)Buffer2;
+
+  if (Entry1->SignatureSize != Entry2->SignatureSize) {
+    return (Entry1->SignatureSize < Entry2->SignatureSize) ? -1 : 1;
+  }
+
+  Result = CompareMem (Entry1->SignatureType, Entry2->SignatureType, sizeof (EFI_GUID));
+  if (Result != 0) {
+    return Result;
+  }
+
+  return CompareMem (Entry1->Signature, Entry2->Signature, Entry1->SignatureSize);
+}
+
+/**
+  Count the EFI_SIGNATURE_DATA in a signature list database.
+
+  @param[in]  Data          Pointer to EFI_SIGNATURE_LIST database.
+  @param[in]  DataSize      Size of Data buffer.
+
+  @return The number of EFI_SIGNATURE_DATA in Data.
+
+**/
+STATIC
+UINTN
+CountSignatureData (
+  IN VOID   *Data,
+  IN UINTN  DataSize
+  )
+{
+  EFI_SIGNATURE_LIST  *CertList;
+  UINTN               Count;
+
+  Count    = 0;
+  CertList = (EFI_SIGNATURE_LIST *)Data;
+  while ((DataSize > 0) && (DataSize >= CertList->SignatureListSize)) {
+    Count    += (CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST) - CertList->SignatureHeaderSize) / CertList->SignatureSize;
+    DataSize -= CertList->SignatureListSize;
+    CertList  = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
+  }
+
+  return Count;
+}
+
+/**
+  Build a sorted index of all EFI_SIGNATURE_DATA in a signature list database.
+
+  @param[in]   Data          Pointer to EFI_SIGNATURE_LIST database.
+  @param[in]   DataSize      Size of Data buffer.
+  @param[out]  IndexCount    Number of entries in the returned index.
+
+  @return Sorted index to be freed with FreePool(), or NULL if Data holds no
+          signature or memory could not be allocated.
+
+**/
+STATIC
+SIGNATURE_DATA_INDEX_ENTRY *
+BuildSignatureDataIndex (
+  IN  VOID   *Data,
+  IN  UINTN  DataSize,
+  OUT UINTN  *IndexCount
+  )
+{
+  SIGNATURE_DATA_INDEX_ENTRY  *Index;
+  SIGNATURE_DATA_INDEX_ENTRY  Swap;
+  EFI_SIGNATURE_LIST          *CertList;
+  UINT8                       *Cert;
+  UINTN                       CertCount;
+  UINTN                       Count;
+  UINTN                       Index2;
+
+  *IndexCount = 0;
+
+  Count = CountSignatureData (Data, DataSize);
+  if (Count == 0) {
+    return NULL;
+  }
+
+  Index = AllocatePool (Count * sizeof (SIGNATURE_DATA_INDEX_ENTRY));
+  if (Index == NULL) {
+    return NULL;
+  }
+
+  Count    = 0;
+  CertList = (EFI_SIGNATURE_LIST *)Data;
+  while ((DataSize > 0) && (DataSize >= CertList->SignatureListSize)) {
+    Cert      = (UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize;
+    CertCount = (CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST) - CertList->SignatureHeaderSize) / CertList->SignatureSize;
+    for (Index2 = 0; Index2 < CertCount; Index2++) {
+      Index[Count].SignatureType = &CertList->SignatureType;
+      Index[Count].SignatureSize = CertList->SignatureSize;
+      Index[Count].Signature     = Cert;
+      Count++;
+      Cert += CertList->SignatureSize;
+    }
+
+    DataSize -= CertList->SignatureListSize;
+    CertList  = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
+  }
+
+  QuickSort (Index, Count, sizeof (SIGNATURE_DATA_INDEX_ENTRY), CompareSignatureDataIndexEntry, &Swap);
+
+  *IndexCount = Count;
+  return Index;
+}
+
+/**
+  Search a sorted signature data index for one EFI_SIGNATURE_DATA.
+
+  @param[in]  Index          Sorted index built by BuildSignatureDataIndex().
+  @param[in]  IndexCount     Number of entries in Index.
+  @param[in]  SignatureType  Type of the signature list holding Signature.
+  @param[in]  SignatureSize  Size of Signature.
+  @param[in]  Signature      EFI_SIGNATURE_DATA to look for.
+
+  @retval TRUE    Signature is in the index.
+  @retval FALSE   Signature is not in the index.
+
+**/
+STATIC
+BOOLEAN
+IsSignatureDataInIndex (
+  IN SIGNATURE_DATA_INDEX_ENTRY  *Index,
+  IN UINTN                       IndexCount,
+  IN EFI_GUID                    *SignatureType,
+  IN UINT32                      SignatureSize,
+  IN UINT8                       *Signature
+  )
+{
+  SIGNATURE_DATA_INDEX_ENTRY  Key;
+  UINTN                       Low;
+  UINTN                       High;
+  UINTN                       Middle;
+  INTN                        Result;
+
+  Key.SignatureType = SignatureType;
+  Key.SignatureSize = SignatureSize;
+  Key.Signature     = Signature;
+
+  Low  = 0;
+  High = IndexCount;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    Result = CompareSignatureDataIndexEntry (&Key, &Index[Middle]);
+    if (Result == 0) {
+      return TRUE;
+    }
+
+    if (Result < 0) {
+      High = Middle;
+    } else {
+      Low = Middle + 1;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Search a signature list database for one EFI_SIGNATURE_DATA.
+
+  @param[in]  Data           Pointer to EFI_SIGNATURE_LIST database.
+  @param[in]  DataSize       Size of Data buffer.
+  @param[in]  SignatureType  Type of the signature list holding Signature.
+  @param[in]  SignatureSize  Size of Signature.
+  @param[in]  Signature      EFI_SIGNATURE_DATA to look for.
+
+  @retval TRUE    Signature is in Data.
+  @retval FALSE   Signature is not in Data.
+
+**/
+STATIC
+BOOLEAN
+IsSignatureDataInList (
+  IN VOID      *Data,
+  IN UINTN     DataSize,
+  IN EFI_GUID  *SignatureType,
+  IN UINT32    SignatureSize,
+  IN UINT8     *Signature
+  )
+{
+  EFI_SIGNATURE_LIST  *CertList;
+  UINT8               *Cert;
+  UINTN               CertCount;
+  UINTN               Index;
+
+  CertList = (EFI_SIGNATURE_LIST *)Data;
+  while ((DataSize > 0) && (DataSize >= CertList->SignatureListSize)) {
+    if (CompareGuid (&CertList->SignatureType, SignatureType) &&
+        (CertList->SignatureSize == SignatureSize))
+    {
+      Cert      = (UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize;
+      CertCount = (CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST) - CertList->SignatureHeaderSize) / CertList->SignatureSize;
+      for (Index = 0; Index < CertCount; Index++) {
+        if (CompareMem (Signature, Cert, SignatureSize) == 0) {
+          return TRUE;
+        }
+
+        Cert += SignatureSize;
+      }
+    }
+
+    DataSize -= CertList->SignatureListSize;
+    CertList  = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
+  }
+
+  return FALSE;
+}
+
 /**
   Filter out the duplicated EFI_SIGNATURE_DATA from the new data by comparing to the original data.
 
+  The original data is indexed once and sorted, so that each new EFI_SIGNATURE_DATA
+  is looked up by binary search. If the index cannot be allocated, the original
+  data is scanned linearly instead.
+
   @param[in]        Data          Pointer to original EFI_SIGNATURE_LIST.
   @param[in]        DataSize      Size of Data buffer.
   @param[in, out]   NewData       Pointer to new EFI_SIGNATURE_LIST.
@@ -1058,22 +1305,20 @@ FilterSignatureList (
   IN OUT UINTN  *NewDataSize
   )
 {
-  EFI_SIGNATURE_LIST  *CertList;
-  EFI_SIGNATURE_DATA  *Cert;
-  UINTN               CertCount;
-  EFI_SIGNATURE_LIST  *NewCertList;
-  EFI_SIGNATURE_DATA  *NewCert;
-  UINTN               NewCertCount;
-  UINTN               Index;
-  UINTN               Index2;
-  UINTN               Size;
-  UINT8               *Tail;
-  UINTN               CopiedCount;
-  UINTN               SignatureListSize;
-  BOOLEAN             IsNewCert;
-  UINT8               *TempData;
-  UINTN               TempDataSize;
-  EFI_STATUS          Status;
+  EFI_SIGNATURE_LIST          *CertList;
+  EFI_SIGNATURE_LIST          *NewCertList;
+  EFI_SIGNATURE_DATA          *NewCert;
+  UINTN                       NewCertCount;
+  UINTN                       Index;
+  UINT8                       *Tail;
+  UINTN                       CopiedCount;
+  UINTN                       SignatureListSize;
+  BOOLEAN                     IsNewCert;
+  UINT8                       *TempData;
+  UINTN                       TempDataSize;
+  EFI_STATUS                  Status;
+  SIGNATURE_DATA_INDEX_ENTRY  *SignatureIndex;
+  UINTN                       SignatureIndexCount;
 
   if (*NewDataSize == 0) {
     return EFI_SUCCESS;
@@ -1085,6 +1330,8 @@ FilterSignatureList (
     return EFI_OUT_OF_RESOURCES;
   }
 
+  SignatureIndex = BuildSignatureDataIndex (Data, DataSize, &SignatureIndexCount);
+
   Tail = TempData;
 
   NewCertList = (EFI_SIGNATURE_LIST *)NewData;
@@ -1094,35 +1341,22 @@ FilterSignatureList (
 
     CopiedCount = 0;
     for (Index = 0; Index < NewCertCount; Index++) {
-      IsNewCert = TRUE;
-
-      Size     = DataSize;
-      CertList = (EFI_SIGNATURE_LIST *)Data;
-      while ((Size > 0) && (Size >= CertList->SignatureListSize)) {
-        if (CompareGuid (&CertList->SignatureType, &NewCertList->SignatureType) &&
-            (CertList->SignatureSize == NewCertList->SignatureSize))
-        {
-          Cert      = (EFI_SIGNATURE_DATA *)((UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
-          CertCount = (CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST) - CertList->SignatureHeaderSize) / CertList->SignatureSize;
-          for (Index2 = 0; Index2 < CertCount; Index2++) {
-            //
-            // Iterate each Signature Data in this Signature List.
-            //
-            if (CompareMem (NewCert, Cert, CertList->SignatureSize) == 0) {
-              IsNewCert = FALSE;
-              break;
-            }
-
-            Cert = (EFI_SIGNATURE_DATA *)((UINT8 *)Cert + CertList->SignatureSize);
-          }
-        }
-
-        if (!IsNewCert) {
-          break;
-        }
-
-        Size    -= CertList->SignatureListSize;
-        CertList = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
+      if (SignatureIndex != NULL) {
+        IsNewCert = !IsSignatureDataInIndex (
+                       SignatureIndex,
+                       SignatureIndexCount,
+                       &NewCertList->SignatureType,
+                       NewCertList->SignatureSize,
+                       (UINT8 *)NewCert
+                       );
+      } else {
+        IsNewCert = !IsSignatureDataInList (
+                       Data,
+                       DataSize,
+                       &NewCertList->SignatureType,
+                       NewCertList->SignatureSize,
+                       (UINT8 *)NewCert
+                       );
       }
 
       if (IsNewCert) {
@@ -1158,6 +1392,10 @@ FilterSignatureList (
     NewCertList   = (EFI_SIGNATURE_LIST *)((UINT8 *)NewCertList + NewCertList->SignatureListSize);
   }
 
+  if (SignatureIndex != NULL) {
+    FreePool (SignatureIndex);
+  }
+
   TempDataSize = (Tail - (UINT8 *)TempData);
 
   CopyMem (NewData, TempData, TempDataSize);
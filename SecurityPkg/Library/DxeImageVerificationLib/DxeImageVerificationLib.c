@@ -36,6 +36,13 @@ UINT8  *mImageBase = NULL;
 UINT8  mImageDigest[MAX_DIGEST_SIZE];
 UINTN  mImageDigestSize;
 
+//
+// Digests of current PE/COFF image computed so far, indexed by hash algorithm
+// type. Bit N of mImageDigestMask is set when mImageDigests[N] is valid.
+//
+UINT8   mImageDigests[HASHALG_MAX][MAX_DIGEST_SIZE];
+UINT32  mImageDigestMask;
+
 //
 // Notify string for authorization UI.
 //
@@ -71,6 +78,14 @@ HASH_TABLE  mHash[] = {
 
 EFI_STRING  mHashTypeStr;
 
+//
+// Sorted indexes of the signature databases searched by image hash.
+//
+SIGNATURE_DATABASE_INDEX  mSignatureIndex[] = {
+  { EFI_IMAGE_SECURITY_DATABASE,  NULL, 0, 0, { 0 }, FALSE, NULL, 0 },
+  { EFI_IMAGE_SECURITY_DATABASE1, NULL, 0, 0, { 0 }, FALSE, NULL, 0 }
+};
+
 /**
   SecureBoot Hook for processing image verification.
 
@@ -271,9 +286,47 @@ GetImageType (
   return IMAGE_UNKNOWN;
 }
 
+/**
+  Feed a block of image data into the hash context of each selected algorithm.
+
+  @param[in]  HashCtx       Hash contexts, indexed by hash algorithm type.
+  @param[in]  HashAlgMask   Bit mask of the hash algorithm types to update.
+  @param[in]  HashBase      Pointer to the data to hash.
+  @param[in]  HashSize      Size of the data to hash in bytes.
+
+  @retval TRUE            All the hash contexts were updated.
+  @retval FALSE           Fail in updating a hash context.
+
+**/
+BOOLEAN
+HashPeImageUpdate (
+  IN VOID    **HashCtx,
+  IN UINT32  HashAlgMask,
+  IN UINT8   *HashBase,
+  IN UINTN   HashSize
+  )
+{
+  UINT32  HashAlg;
+
+  for (HashAlg = 0; HashAlg < HASHALG_MAX; HashAlg++) {
+    if ((HashAlgMask & (1U << HashAlg)) == 0) {
+      continue;
+    }
+
+    if (!mHash[HashAlg].HashUpdate (HashCtx[HashAlg], HashBase, HashSize)) {
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 /**
   Calculate hash of Pe/Coff image based on the authenticode image hashing in
-  PE/COFF Specification 8.0 Appendix A
+  PE/COFF Specification 8.0 Appendix A, for several hash algorithms at once.
+  The image is walked a single time and every data block is fed to all the
+  selected algorithms. The digests are kept in mImageDigests for the current
+  image and marked in mImageDigestMask.
 
   Caution: This function may receive untrusted input.
   PE/COFF image is external input, so this function will validate its data structure
@@ -282,21 +335,21 @@ GetImageType (
   Notes: PE/COFF image has been checked by BasePeCoffLib PeCoffLoaderGetImageInfo() in
   its caller function DxeImageVerificationHandler().
 
-  @param[in]    HashAlg   Hash algorithm type.
+  @param[in]    HashAlgMask   Bit mask of the hash algorithm types.
 
   @retval TRUE            Successfully hash image.
   @retval FALSE           Fail in hash image.
 
 **/
 BOOLEAN
-HashPeImage (
-  IN  UINT32  HashAlg
+HashPeImageWithAlgorithms (
+  IN  UINT32  HashAlgMask
   )
 {
   BOOLEAN                   Status;
   EFI_IMAGE_SECTION_HEADER  *Section;
-  VOID                      *HashCtx;
-  UINTN                     CtxSize;
+  VOID                      *HashCtx[HASHALG_MAX];
+  UINT32                    HashAlg;
   UINT8                     *HashBase;
   UINTN                     HashSize;
   UINTN                     SumOfBytesHashed;
@@ -306,61 +359,34 @@ HashPeImage (
   UINT32                    CertSize;
   UINT32                    NumberOfRvaAndSizes;
 
-  HashCtx       = NULL;
+  ZeroMem (HashCtx, sizeof (HashCtx));
   SectionHeader = NULL;
   Status        = FALSE;
 
-  if ((HashAlg >= HASHALG_MAX)) {
+  if ((HashAlgMask == 0) || (HashAlgMask >= (1U << HASHALG_MAX))) {
     return FALSE;
   }
 
-  //
-  // Initialize context of hash.
-  //
-  ZeroMem (mImageDigest, MAX_DIGEST_SIZE);
-
-  switch (HashAlg) {
- #ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
-    case HASHALG_SHA1:
-      mImageDigestSize = SHA1_DIGEST_SIZE;
-      mCertType        = gEfiCertSha1Guid;
-      break;
- #endif
-
-    case HASHALG_SHA256:
-      mImageDigestSize = SHA256_DIGEST_SIZE;
-      mCertType        = gEfiCertSha256Guid;
-      break;
-
-    case HASHALG_SHA384:
-      mImageDigestSize = SHA384_DIGEST_SIZE;
-      mCertType        = gEfiCertSha384Guid;
-      break;
-
-    case HASHALG_SHA512:
-      mImageDigestSize = SHA512_DIGEST_SIZE;
-      mCertType        = gEfiCertSha512Guid;
-      break;
-
-    default:
-      return FALSE;
-  }
-
-  mHashTypeStr = mHash[HashAlg].Name;
-  CtxSize      = mHash[HashAlg].GetContextSize ();
+  // 1.  Load the image header into memory.
 
-  HashCtx = AllocatePool (CtxSize);
-  if (HashCtx == NULL) {
-    return FALSE;
-  }
+  // 2.  Initialize a SHA hash context for each algorithm.
+  for (HashAlg = 0; HashAlg < HASHALG_MAX; HashAlg++) {
+    if ((HashAlgMask & (1U << HashAlg)) == 0) {
+      continue;
+    }
 
-  // 1.  Load the image header into memory.
+    if (mHash[HashAlg].GetContextSize == NULL) {
+      goto Done;
+    }
 
-  // 2.  Initialize a SHA hash context.
-  Status = mHash[HashAlg].HashInit (HashCtx);
+    HashCtx[HashAlg] = AllocatePool (mHash[HashAlg].GetContextSize ());
+    if (HashCtx[HashAlg] == NULL) {
+      goto Done;
+    }
 
-  if (!Status) {
-    goto Done;
+    if (!mHash[HashAlg].HashInit (HashCtx[HashAlg])) {
+      goto Done;
+    }
   }
 
   //
@@ -393,7 +419,7 @@ HashPeImage (
     goto Done;
   }
 
-  Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
+  Status = HashPeImageUpdate (HashCtx, HashAlgMask, HashBase, HashSize);
   if (!Status) {
     goto Done;
   }
@@ -421,7 +447,7 @@ HashPeImage (
     }
 
     if (HashSize != 0) {
-      Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
+      Status = HashPeImageUpdate (HashCtx, HashAlgMask, HashBase, HashSize);
       if (!Status) {
         goto Done;
       }
@@ -445,7 +471,7 @@ HashPeImage (
     }
 
     if (HashSize != 0) {
-      Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
+      Status = HashPeImageUpdate (HashCtx, HashAlgMask, HashBase, HashSize);
       if (!Status) {
         goto Done;
       }
@@ -470,7 +496,7 @@ HashPeImage (
     }
 
     if (HashSize != 0) {
-      Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
+      Status = HashPeImageUpdate (HashCtx, HashAlgMask, HashBase, HashSize);
       if (!Status) {
         goto Done;
       }
@@ -545,7 +571,7 @@ HashPeImage (
     HashBase = mImageBase + Section->PointerToRawData;
     HashSize = (UINTN)Section->SizeOfRawData;
 
-    Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
+    Status = HashPeImageUpdate (HashCtx, HashAlgMask, HashBase, HashSize);
     if (!Status) {
       goto Done;
     }
@@ -581,7 +607,7 @@ HashPeImage (
     if (mImageSize > CertSize + SumOfBytesHashed) {
       HashSize = (UINTN)(mImageSize - CertSize - SumOfBytesHashed);
 
-      Status = mHash[HashAlg].HashUpdate (HashCtx, HashBase, HashSize);
+      Status = HashPeImageUpdate (HashCtx, HashAlgMask, HashBase, HashSize);
       if (!Status) {
         goto Done;
       }
@@ -591,11 +617,24 @@ HashPeImage (
     }
   }
 
-  Status = mHash[HashAlg].HashFinal (HashCtx, mImageDigest);
+  for (HashAlg = 0; HashAlg < HASHALG_MAX; HashAlg++) {
+    if ((HashAlgMask & (1U << HashAlg)) == 0) {
+      continue;
+    }
+
+    Status = mHash[HashAlg].HashFinal (HashCtx[HashAlg], mImageDigests[HashAlg]);
+    if (!Status) {
+      goto Done;
+    }
+
+    mImageDigestMask |= 1U << HashAlg;
+  }
 
 Done:
-  if (HashCtx != NULL) {
-    FreePool (HashCtx);
+  for (HashAlg = 0; HashAlg < HASHALG_MAX; HashAlg++) {
+    if (HashCtx[HashAlg] != NULL) {
+      FreePool (HashCtx[HashAlg]);
+    }
   }
 
   if (SectionHeader != NULL) {
@@ -605,6 +644,70 @@ Done:
   return Status;
 }
 
+/**
+  Get the hash of Pe/Coff image for one hash algorithm into mImageDigest, and set
+  mImageDigestSize, mCertType and mHashTypeStr accordingly. The image is only
+  hashed if the digest of this algorithm is not known yet for the current image.
+
+  @param[in]    HashAlg   Hash algorithm type.
+
+  @retval TRUE            Successfully hash image.
+  @retval FALSE           Fail in hash image.
+
+**/
+BOOLEAN
+HashPeImage (
+  IN  UINT32  HashAlg
+  )
+{
+  if ((HashAlg >= HASHALG_MAX)) {
+    return FALSE;
+  }
+
+  //
+  // Initialize context of hash.
+  //
+  ZeroMem (mImageDigest, MAX_DIGEST_SIZE);
+
+  switch (HashAlg) {
+ #ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
+    case HASHALG_SHA1:
+      mImageDigestSize = SHA1_DIGEST_SIZE;
+      mCertType        = gEfiCertSha1Guid;
+      break;
+ #endif
+
+    case HASHALG_SHA256:
+      mImageDigestSize = SHA256_DIGEST_SIZE;
+      mCertType        = gEfiCertSha256Guid;
+      break;
+
+    case HASHALG_SHA384:
+      mImageDigestSize = SHA384_DIGEST_SIZE;
+      mCertType        = gEfiCertSha384Guid;
+      break;
+
+    case HASHALG_SHA512:
+      mImageDigestSize = SHA512_DIGEST_SIZE;
+      mCertType        = gEfiCertSha512Guid;
+      break;
+
+    default:
+      return FALSE;
+  }
+
+  mHashTypeStr = mHash[HashAlg].Name;
+
+  if ((mImageDigestMask & (1U << HashAlg)) == 0) {
+    if (!HashPeImageWithAlgorithms (1U << HashAlg)) {
+      return FALSE;
+    }
+  }
+
+  CopyMem (mImageDigest, mImageDigests[HashAlg], mImageDigestSize);
+  return TRUE;
+}
+
 /**
   Recognize the Hash algorithm in PE/COFF Authenticode and calculate hash of
   Pe/Coff image based on the authenticode image hashing in PE/COFF Specification
@@ -859,7 +962,8 @@ IsCertHashFoundInDbx (
   UINTN               Index;
   UINT32              HashAlg;
   VOID                *HashCtx;
-  UINT8               CertDigest[MAX_DIGEST_SIZE];
+  UINT8               CertDigest[HASHALG_MAX][MAX_DIGEST_SIZE];
+  BOOLEAN             DigestReady[HASHALG_MAX];
   UINT8               *DbxCertHash;
   UINTN               SiglistHeaderSize;
   UINT8               *TBSCert;
@@ -883,6 +987,8 @@ IsCertHashFoundInDbx (
     return Status;
   }
 
+  ZeroMem (DigestReady, sizeof (DigestReady));
+
   while ((DbxSize > 0) && (SignatureListSize >= DbxList->SignatureListSize)) {
     //
     // Determine Hash Algorithm of Certificate in the forbidden database.
@@ -900,32 +1006,36 @@ IsCertHashFoundInDbx (
     }
 
     //
-    // Calculate the hash value of current TBSCertificate for comparision.
+    // Calculate the hash value of current TBSCertificate for comparision. It is
+    // computed once per hash algorithm and reused for the following lists.
     //
-    if (mHash[HashAlg].GetContextSize == NULL) {
-      goto Done;
-    }
+    if (!DigestReady[HashAlg]) {
+      if (mHash[HashAlg].GetContextSize == NULL) {
+        goto Done;
+      }
 
-    ZeroMem (CertDigest, MAX_DIGEST_SIZE);
-    HashCtx = AllocatePool (mHash[HashAlg].GetContextSize ());
-    if (HashCtx == NULL) {
-      goto Done;
-    }
+      ZeroMem (CertDigest[HashAlg], MAX_DIGEST_SIZE);
+      HashCtx = AllocatePool (mHash[HashAlg].GetContextSize ());
+      if (HashCtx == NULL) {
+        goto Done;
+      }
 
-    if (!mHash[HashAlg].HashInit (HashCtx)) {
-      goto Done;
-    }
+      if (!mHash[HashAlg].HashInit (HashCtx)) {
+        goto Done;
+      }
 
-    if (!mHash[HashAlg].HashUpdate (HashCtx, TBSCert, TBSCertSize)) {
-      goto Done;
-    }
+      if (!mHash[HashAlg].HashUpdate (HashCtx, TBSCert, TBSCertSize)) {
+        goto Done;
+      }
 
-    if (!mHash[HashAlg].HashFinal (HashCtx, CertDigest)) {
-      goto Done;
-    }
+      if (!mHash[HashAlg].HashFinal (HashCtx, CertDigest[HashAlg])) {
+        goto Done;
+      }
 
-    FreePool (HashCtx);
-    HashCtx = NULL;
+      FreePool (HashCtx);
+      HashCtx              = NULL;
+      DigestReady[HashAlg] = TRUE;
+    }
 
     SiglistHeaderSize = sizeof (EFI_SIGNATURE_LIST) + DbxList->SignatureHeaderSize;
     CertHash          = (EFI_SIGNATURE_DATA *)((UINT8 *)DbxList + SiglistHeaderSize);
@@ -935,7 +1045,7 @@ IsCertHashFoundInDbx (
       // Iterate each Signature Data Node within this CertList for verify.
       //
       DbxCertHash = CertHash->SignatureData;
-      if (CompareMem (DbxCertHash, CertDigest, mHash[HashAlg].DigestLength) == 0) {
+      if (CompareMem (DbxCertHash, CertDigest[HashAlg], mHash[HashAlg].DigestLength) == 0) {
         //
         // Hash of Certificate is found in forbidden database.
         //
@@ -966,6 +1076,276 @@ Done:
   return Status;
 }
 
+/**
+  Compare a signature data node in the index with a signature key. Nodes are
+  ordered by signature type, signature size and signature data.
+
+  @param[in]  Entry           Pointer to the index entry.
+  @param[in]  SignatureType   Pointer to the signature type of the key.
+  @param[in]  SignatureSize   Size of the EFI_SIGNATURE_DATA of the key.
+  @param[in]  SignatureData   Pointer to the signature data of the key.
+
+  @retval 0     The entry matches the key.
+  @retval <0    The entry is ordered before the key.
+  @retval >0    The entry is ordered after the key.
+
+**/
+INTN
+CompareSignatureIndexKey (
+  IN CONST SIGNATURE_INDEX_ENTRY  *Entry,
+  IN CONST EFI_GUID               *SignatureType,
+  IN UINT32                       SignatureSize,
+  IN CONST UINT8                  *SignatureData
+  )
+{
+  INTN  Result;
+
+  Result = CompareMem (&Entry->CertList->SignatureType, SignatureType, sizeof (EFI_GUID));
+  if (Result != 0) {
+    return Result;
+  }
+
+  if (Entry->CertList->SignatureSize != SignatureSize) {
+    return (Entry->CertList->SignatureSize < SignatureSize) ? -1 : 1;
+  }
+
+  return CompareMem (Entry->Cert->SignatureData, SignatureData, SignatureSize - sizeof (EFI_GUID));
+}
+
+/**
+  QuickSort() callback ordering two signature index entries. Equal signatures
+  keep the order they have in the database, so a lookup finds the same node a
+  linear scan would.
+
+  @param[in]  Buffer1   Pointer to the first SIGNATURE_INDEX_ENTRY.
+  @param[in]  Buffer2   Pointer to the second SIGNATURE_INDEX_ENTRY.
+
+  @retval 0     The entries are the same node.
+  @retval <0    Buffer1 is ordered before Buffer2.
+  @retval >0    Buffer1 is ordered after Buffer2.
+
+**/
+INTN
+EFIAPI
+CompareSignatureIndexEntry (
+  IN CONST VOID  *Buffer1,
+  IN CONST VOID  *Buffer2
+  )
+{
+  CONST SIGNATURE_INDEX_ENTRY  *Entry1;
+  CONST SIGNATURE_INDEX_ENTRY  *Entry2;
+  INTN                         Result;
+
+  Entry1 = (CONST SIGNATURE_INDEX_ENTRY *)Buffer1;
+  Entry2 = (CONST SIGNATURE_INDEX_ENTRY *)Buffer2;
+
+  Result = CompareSignatureIndexKey (
+             Entry1,
+             &Entry2->CertList->SignatureType,
+             Entry2->CertList->SignatureSize,
+             Entry2->Cert->SignatureData
+             );
+  if (Result != 0) {
+    return Result;
+  }
+
+  if (Entry1->Cert == Entry2->Cert) {
+    return 0;
+  }
+
+  return ((UINTN)Entry1->Cert < (UINTN)Entry2->Cert) ? -1 : 1;
+}
+
+/**
+  Release the signature data and the sorted entries held by an index.
+
+  @param[in, out]  Index   The signature database index to empty.
+
+**/
+VOID
+FreeSignatureDatabaseIndex (
+  IN OUT SIGNATURE_DATABASE_INDEX  *Index
+  )
+{
+  if (Index->Data != NULL) {
+    FreePool (Index->Data);
+  }
+
+  if (Index->Entries != NULL) {
+    FreePool (Index->Entries);
+  }
+
+  Index->Data       = NULL;
+  Index->DataSize   = 0;
+  Index->BufferSize = 0;
+  Index->Entries    = NULL;
+  Index->EntryCount = 0;
+  ZeroMem (Index->Digest, sizeof (Index->Digest));
+}
+
+/**
+  Mark all the signature database indexes as to be checked against their
+  variables again. This is done once per image verification, so that an
+  update of db or dbx is effective for the next image.
+
+**/
+VOID
+InvalidateSignatureDatabaseIndexes (
+  VOID
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (mSignatureIndex); Index++) {
+    mSignatureIndex[Index].IsCurrent = FALSE;
+  }
+}
+
+/**
+  Make the index reflect the current content of its signature database
+  variable. The variable is read once after InvalidateSignatureDatabaseIndexes()
+  into the buffer of the index, and the sorted entries are only rebuilt when
+  the size or the digest of the content changed.
+
+  @param[in, out]  Index   The signature database index to refresh.
+
+  @retval EFI_SUCCESS           The index matches the signature database.
+  @retval EFI_OUT_OF_RESOURCES  Failed to allocate memory for the index.
+  @retval Others                Error occurred in reading the database.
+
+**/
+EFI_STATUS
+RefreshSignatureDatabaseIndex (
+  IN OUT SIGNATURE_DATABASE_INDEX  *Index
+  )
+{
+  EFI_STATUS             Status;
+  EFI_SIGNATURE_LIST     *CertList;
+  EFI_SIGNATURE_DATA     *Cert;
+  UINTN                  DataSize;
+  UINTN                  ListSize;
+  UINTN                  CertCount;
+  UINTN                  EntryCount;
+  UINTN                  Pass;
+  UINT8                  Digest[SHA256_DIGEST_SIZE];
+  BOOLEAN                IsDigestValid;
+  SIGNATURE_INDEX_ENTRY  Swap;
+
+  if (Index->IsCurrent) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Read the variable straight into the buffer of the index. The entries are
+  // only valid again once the content is known to be unchanged.
+  //
+  DataSize = Index->BufferSize;
+  Status   = gRT->GetVariable (Index->VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, Index->Data);
+  if (Status == EFI_BUFFER_TOO_SMALL) {
+    //
+    // The database grew, whatever was built from the old content is stale.
+    //
+    FreeSignatureDatabaseIndex (Index);
+    Index->Data = (UINT8 *)AllocatePool (DataSize);
+    if (Index->Data == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Index->BufferSize = DataSize;
+    Status            = gRT->GetVariable (Index->VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, Index->Data);
+  }
+
+  if (Status == EFI_NOT_FOUND) {
+    //
+    // No database, nothing to index.
+    //
+    FreeSignatureDatabaseIndex (Index);
+    Index->IsCurrent = TRUE;
+    return EFI_SUCCESS;
+  }
+
+  if (EFI_ERROR (Status)) {
+    FreeSignatureDatabaseIndex (Index);
+    return Status;
+  }
+
+  IsDigestValid = Sha256HashAll (Index->Data, DataSize, Digest);
+  if (IsDigestValid && (Index->DataSize == DataSize) && (CompareMem (Index->Digest, Digest, SHA256_DIGEST_SIZE) == 0)) {
+    //
+    // The database is unchanged since the index was built.
+    //
+    Index->IsCurrent = TRUE;
+    return EFI_SUCCESS;
+  }
+
+  if (Index->Entries != NULL) {
+    FreePool (Index->Entries);
+    Index->Entries = NULL;
+  }
+
+  Index->EntryCount = 0;
+  Index->DataSize   = DataSize;
+  if (IsDigestValid) {
+    CopyMem (Index->Digest, Digest, SHA256_DIGEST_SIZE);
+  } else {
+    ZeroMem (Index->Digest, SHA256_DIGEST_SIZE);
+  }
+
+  //
+  // Count the signature data nodes in the first pass, collect them in the
+  // second pass, then sort them.
+  //
+  EntryCount = 0;
+  for (Pass = 0; Pass < 2; Pass++) {
+    if (Pass == 1) {
+      if (EntryCount == 0) {
+        break;
+      }
+
+      Index->Entries = AllocatePool (EntryCount * sizeof (SIGNATURE_INDEX_ENTRY));
+      if (Index->Entries == NULL) {
+        FreeSignatureDatabaseIndex (Index);
+        return EFI_OUT_OF_RESOURCES;
+      }
+    }
+
+    CertList = (EFI_SIGNATURE_LIST *)Index->Data;
+    ListSize = DataSize;
+    while ((ListSize >= sizeof (EFI_SIGNATURE_LIST)) && (ListSize >= CertList->SignatureListSize)) {
+      if ((CertList->SignatureListSize < sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize) ||
+          (CertList->SignatureSize <= sizeof (EFI_GUID)))
+      {
+        break;
+      }
+
+      CertCount = (CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST) - CertList->SignatureHeaderSize) / CertList->SignatureSize;
+      Cert      = (EFI_SIGNATURE_DATA *)((UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
+      while (CertCount > 0) {
+        if (Pass == 0) {
+          EntryCount++;
+        } else {
+          Index->Entries[Index->EntryCount].CertList = CertList;
+          Index->Entries[Index->EntryCount].Cert     = Cert;
+          Index->EntryCount++;
+        }
+
+        Cert = (EFI_SIGNATURE_DATA *)((UINT8 *)Cert + CertList->SignatureSize);
+        CertCount--;
+      }
+
+      ListSize -= CertList->SignatureListSize;
+      CertList  = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
+    }
+  }
+
+  if (Index->EntryCount > 1) {
+    QuickSort (Index->Entries, Index->EntryCount, sizeof (SIGNATURE_INDEX_ENTRY), CompareSignatureIndexEntry, &Swap);
+  }
+
+  Index->IsCurrent = TRUE;
+  return EFI_SUCCESS;
+}
+
 /**
   Check whether signature is in specified database.
 
@@ -988,81 +1368,66 @@ IsSignatureFoundInDatabase (
   OUT BOOLEAN   *IsFound
   )
 {
-  EFI_STATUS          Status;
-  EFI_SIGNATURE_LIST  *CertList;
-  EFI_SIGNATURE_DATA  *Cert;
-  UINTN               DataSize;
-  UINT8               *Data;
-  UINTN               Index;
-  UINTN               CertCount;
+  EFI_STATUS                Status;
+  SIGNATURE_DATABASE_INDEX  *DbIndex;
+  SIGNATURE_INDEX_ENTRY     *Entry;
+  UINT32                    CertSize;
+  UINTN                     Index;
+  UINTN                     Low;
+  UINTN                     High;
+  UINTN                     Mid;
 
-  //
-  // Read signature database variable.
-  //
   *IsFound = FALSE;
-  Data     = NULL;
-  DataSize = 0;
-  Status   = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    if (Status == EFI_NOT_FOUND) {
-      //
-      // No database, no need to search.
-      //
-      Status = EFI_SUCCESS;
-    }
+  DbIndex  = NULL;
 
-    return Status;
+  for (Index = 0; Index < ARRAY_SIZE (mSignatureIndex); Index++) {
+    if (StrCmp (VariableName, mSignatureIndex[Index].VariableName) == 0) {
+      DbIndex = &mSignatureIndex[Index];
+      break;
+    }
   }
 
-  Data = (UINT8 *)AllocateZeroPool (DataSize);
-  if (Data == NULL) {
-    return EFI_OUT_OF_RESOURCES;
+  if (DbIndex == NULL) {
+    ASSERT (DbIndex != NULL);
+    return EFI_UNSUPPORTED;
   }
 
-  Status = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, Data);
+  //
+  // Read signature database variable and update its index if needed. This
+  // only happens on the first lookup after InvalidateSignatureDatabaseIndexes().
+  //
+  Status = RefreshSignatureDatabaseIndex (DbIndex);
   if (EFI_ERROR (Status)) {
-    goto Done;
+    return Status;
   }
 
   //
-  // Enumerate all signature data in SigDB to check if signature exists for executable.
+  // Binary search for the first node matching the signature.
   //
-  CertList = (EFI_SIGNATURE_LIST *)Data;
-  while ((DataSize > 0) && (DataSize >= CertList->SignatureListSize)) {
-    CertCount = (CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST) - CertList->SignatureHeaderSize) / CertList->SignatureSize;
-    Cert      = (EFI_SIGNATURE_DATA *)((UINT8 *)CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
-    if ((CertList->SignatureSize == sizeof (EFI_SIGNATURE_DATA) - 1 + SignatureSize) && (CompareGuid (&CertList->SignatureType, CertType))) {
-      for (Index = 0; Index < CertCount; Index++) {
-        if (CompareMem (Cert->SignatureData, Signature, SignatureSize) == 0) {
-          //
-          // Find the signature in database.
-          //
-          *IsFound = TRUE;
-          //
-          // Entries in UEFI_IMAGE_SECURITY_DATABASE that are used to validate image should be measured
-          //
-          if (StrCmp (VariableName, EFI_IMAGE_SECURITY_DATABASE) == 0) {
-            SecureBootHook (VariableName, &gEfiImageSecurityDatabaseGuid, CertList->SignatureSize, Cert);
-          }
-
-          break;
-        }
-
-        Cert = (EFI_SIGNATURE_DATA *)((UINT8 *)Cert + CertList->SignatureSize);
-      }
-
-      if (*IsFound) {
-        break;
-      }
+  CertSize = (UINT32)(sizeof (EFI_SIGNATURE_DATA) - 1 + SignatureSize);
+  Low      = 0;
+  High     = DbIndex->EntryCount;
+  while (Low < High) {
+    Mid = Low + (High - Low) / 2;
+    if (CompareSignatureIndexKey (&DbIndex->Entries[Mid], CertType, CertSize, Signature) < 0) {
+      Low = Mid + 1;
+    } else {
+      High = Mid;
     }
-
-    DataSize -= CertList->SignatureListSize;
-    CertList  = (EFI_SIGNATURE_LIST *)((UINT8 *)CertList + CertList->SignatureListSize);
   }
 
-Done:
-  if (Data != NULL) {
-    FreePool (Data);
+  if ((Low < DbIndex->EntryCount) && (CompareSignatureIndexKey (&DbIndex->Entries[Low], CertType, CertSize, Signature) == 0)) {
+    //
+    // Find the signature in database.
+    //
+    Entry    = &DbIndex->Entries[Low];
+    *IsFound = TRUE;
+    //
+    // Entries in UEFI_IMAGE_SECURITY_DATABASE that are used to validate image should be measured
+    //
+    if (StrCmp (VariableName, EFI_IMAGE_SECURITY_DATABASE) == 0) {
+      SecureBootHook (VariableName, &gEfiImageSecurityDatabaseGuid, Entry->CertList->SignatureSize, Entry->Cert);
+    }
   }
 
   return Status;
@@ -1692,6 +2057,7 @@ DxeImageVerificationHandler (
   UINT32                        VarAttr;
   BOOLEAN                       IsFound;
   UINT8                         HashAlg;
+  UINT32                        HashAlgMask;
   BOOLEAN                       IsFoundInDatabase;
 
   SignatureList     = NULL;
@@ -1783,8 +2149,15 @@ DxeImageVerificationHandler (
     return EFI_ACCESS_DENIED;
   }
 
-  mImageBase = (UINT8 *)FileBuffer;
-  mImageSize = FileSize;
+  //
+  // Check db and dbx for updates once for this image, rather than on each
+  // lookup.
+  //
+  InvalidateSignatureDatabaseIndexes ();
+
+  mImageBase       = (UINT8 *)FileBuffer;
+  mImageSize       = FileSize;
+  mImageDigestMask = 0;
 
   ZeroMem (&ImageContext, sizeof (ImageContext));
   ImageContext.Handle    = (VOID *)FileBuffer;
@@ -1851,6 +2224,17 @@ DxeImageVerificationHandler (
     // This image is not signed. The hash value of the image must match a record in the security database "db",
     // and not be reflected in the security data base "dbx".
     //
+    // Compute the digests of all supported algorithms in a single pass over the image.
+    //
+    HashAlgMask = 0;
+    for (HashAlg = 0; HashAlg < HASHALG_MAX; HashAlg++) {
+      if ((mHash[HashAlg].GetContextSize != NULL) && (mHash[HashAlg].HashInit != NULL) && (mHash[HashAlg].HashUpdate != NULL) && (mHash[HashAlg].HashFinal != NULL)) {
+        HashAlgMask |= 1U << HashAlg;
+      }
+    }
+
+    HashPeImageWithAlgorithms (HashAlgMask);
+
     HashAlg = sizeof (mHash) / sizeof (HASH_TABLE);
     while (HashAlg > 0) {
       HashAlg--;
@@ -195,4 +195,30 @@ typedef struct {
   HASH_FINAL               HashFinal;
 } HASH_TABLE;
 
+//
+// Reference to one signature data node in a signature database.
+//
+typedef struct {
+  EFI_SIGNATURE_LIST    *CertList;
+  EFI_SIGNATURE_DATA    *Cert;
+} SIGNATURE_INDEX_ENTRY;
+
+//
+// Sorted index over all signature data in a signature database variable.
+// Data holds the variable content the entries point into, BufferSize is the
+// size allocated for it. The variable is read again into Data once per image
+// verification, and the entries are only rebuilt when its size or its
+// SHA-256 Digest differs from the ones the index was built from.
+//
+typedef struct {
+  CHAR16                   *VariableName;
+  UINT8                    *Data;
+  UINTN                    DataSize;
+  UINTN                    BufferSize;
+  UINT8                    Digest[SHA256_DIGEST_SIZE];
+  BOOLEAN                  IsCurrent;
+  SIGNATURE_INDEX_ENTRY    *Entries;
+  UINTN                    EntryCount;
+} SIGNATURE_DATABASE_INDEX;
+
 #endif
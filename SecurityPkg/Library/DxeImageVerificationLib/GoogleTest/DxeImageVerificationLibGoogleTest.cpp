@@ -14,7 +14,10 @@
 extern "C" {
   #include <Uefi.h>
   #include <Library/BaseLib.h>
+  #include <Library/BaseMemoryLib.h>
   #include <Library/DebugLib.h>
+  #include <Library/BaseCryptLib.h>
+  #include <Guid/ImageAuthentication.h>
 
   #include "DxeImageVerificationLibGoogleTest.h"
 }
@@ -126,6 +129,186 @@ TEST_F (CheckImageTypeResult, ImageTypeVerifyImageFromFixedMedia) {
   TestFunc (EFI_ACCESS_DENIED);
 }
 
+//////////////////////////////////////////////////////////////////////////////
+class SignatureDatabaseLookup : public ::testing::Test {
+protected:
+  MockUefiRuntimeServicesTableLib RtServicesMock;
+
+  EFI_STATUS Status;
+  BOOLEAN IsFound;
+  std::vector<UINT8> Dbx;
+  UINTN ReadCount;
+
+  static void
+  MakeDigest (
+    UINT32  Seed,
+    UINT8   *Digest
+    )
+  {
+    for (UINTN Index = 0; Index < SHA256_DIGEST_SIZE; Index++) {
+      Digest[Index] = (UINT8)(0xA5 ^ Index);
+    }
+
+    Digest[0] = (UINT8)(Seed >> 24);
+    Digest[1] = (UINT8)(Seed >> 16);
+    Digest[2] = (UINT8)(Seed >> 8);
+    Digest[3] = (UINT8)Seed;
+  }
+
+  //
+  // Build a dbx with one SHA-256 signature list of Count hashes, stored out
+  // of order so that the lookup has to rely on the sorted index.
+  //
+  void
+  BuildDbx (
+    UINT32  Count,
+    UINT32  First
+    )
+  {
+    UINT32              SignatureSize;
+    EFI_SIGNATURE_LIST  *CertList;
+    EFI_SIGNATURE_DATA  *Cert;
+
+    SignatureSize = sizeof (EFI_GUID) + SHA256_DIGEST_SIZE;
+    Dbx.assign (sizeof (EFI_SIGNATURE_LIST) + Count * SignatureSize, 0);
+
+    CertList                      = (EFI_SIGNATURE_LIST *)Dbx.data ();
+    CertList->SignatureType       = gEfiCertSha256Guid;
+    CertList->SignatureListSize   = (UINT32)Dbx.size ();
+    CertList->SignatureHeaderSize = 0;
+    CertList->SignatureSize       = SignatureSize;
+
+    for (UINT32 Index = 0; Index < Count; Index++) {
+      Cert = (EFI_SIGNATURE_DATA *)(Dbx.data () + sizeof (EFI_SIGNATURE_LIST) + Index * SignatureSize);
+      MakeDigest (First + (Index * 7919) % Count, Cert->SignatureData);
+    }
+  }
+
+  //
+  // Stand-in for gRT->GetVariable() returning the current content of Dbx.
+  //
+  EFI_STATUS
+  GetDbx (
+    CHAR16    *VariableName,
+    EFI_GUID  *VendorGuid,
+    UINT32    *Attributes,
+    UINTN     *DataSize,
+    VOID      *Data
+    )
+  {
+    ReadCount++;
+    if (Dbx.empty ()) {
+      return EFI_NOT_FOUND;
+    }
+
+    if (*DataSize < Dbx.size ()) {
+      *DataSize = Dbx.size ();
+      return EFI_BUFFER_TOO_SMALL;
+    }
+
+    *DataSize = Dbx.size ();
+    memcpy (Data, Dbx.data (), Dbx.size ());
+    return EFI_SUCCESS;
+  }
+
+  virtual void
+  SetUp (
+    )
+  {
+    //
+    // The index is global, start every test from a fresh read of dbx.
+    //
+    InvalidateSignatureDatabaseIndexes ();
+    ReadCount = 0;
+
+    EXPECT_CALL (RtServicesMock, gRT_GetVariable)
+      .WillRepeatedly (testing::Invoke (this, &SignatureDatabaseLookup::GetDbx));
+  }
+};
+
+TEST_F (SignatureDatabaseLookup, FindsEveryHashInLargeDbx) {
+  UINT8  Digest[SHA256_DIGEST_SIZE];
+
+  BuildDbx (1000, 0);
+
+  for (UINT32 Seed = 0; Seed < 2000; Seed++) {
+    MakeDigest (Seed, Digest);
+    Status = IsSignatureFoundInDatabase ((CHAR16 *)EFI_IMAGE_SECURITY_DATABASE1, Digest, &gEfiCertSha256Guid, sizeof (Digest), &IsFound);
+    ASSERT_EQ (Status, EFI_SUCCESS);
+    EXPECT_EQ (IsFound, Seed < 1000);
+  }
+
+  //
+  // The same bytes under another signature type must not match.
+  //
+  MakeDigest (1, Digest);
+  Status = IsSignatureFoundInDatabase ((CHAR16 *)EFI_IMAGE_SECURITY_DATABASE1, Digest, &gEfiCertSha384Guid, sizeof (Digest), &IsFound);
+  ASSERT_EQ (Status, EFI_SUCCESS);
+  EXPECT_FALSE (IsFound);
+}
+
+TEST_F (SignatureDatabaseLookup, RebuildsIndexWhenDbxChanges) {
+  UINT8  Digest[SHA256_DIGEST_SIZE];
+
+  BuildDbx (1000, 0);
+  MakeDigest (5, Digest);
+  Status = IsSignatureFoundInDatabase ((CHAR16 *)EFI_IMAGE_SECURITY_DATABASE1, Digest, &gEfiCertSha256Guid, sizeof (Digest), &IsFound);
+  ASSERT_EQ (Status, EFI_SUCCESS);
+  EXPECT_TRUE (IsFound);
+
+  //
+  // Same size, different content: only the digest tells them apart.
+  //
+  BuildDbx (1000, 1000);
+  InvalidateSignatureDatabaseIndexes ();
+  Status = IsSignatureFoundInDatabase ((CHAR16 *)EFI_IMAGE_SECURITY_DATABASE1, Digest, &gEfiCertSha256Guid, sizeof (Digest), &IsFound);
+  ASSERT_EQ (Status, EFI_SUCCESS);
+  EXPECT_FALSE (IsFound);
+
+  MakeDigest (1005, Digest);
+  Status = IsSignatureFoundInDatabase ((CHAR16 *)EFI_IMAGE_SECURITY_DATABASE1, Digest, &gEfiCertSha256Guid, sizeof (Digest), &IsFound);
+  ASSERT_EQ (Status, EFI_SUCCESS);
+  EXPECT_TRUE (IsFound);
+
+  Dbx.clear ();
+  InvalidateSignatureDatabaseIndexes ();
+  Status = IsSignatureFoundInDatabase ((CHAR16 *)EFI_IMAGE_SECURITY_DATABASE1, Digest, &gEfiCertSha256Guid, sizeof (Digest), &IsFound);
+  ASSERT_EQ (Status, EFI_SUCCESS);
+  EXPECT_FALSE (IsFound);
+}
+
+TEST_F (SignatureDatabaseLookup, ReadsDatabaseOncePerVerification) {
+  UINT8  Digest[SHA256_DIGEST_SIZE];
+
+  BuildDbx (1000, 0);
+
+  //
+  // Within one image verification the variable is read once (twice when the
+  // first read only learns the size), however many lookups are made.
+  //
+  for (UINT32 Seed = 0; Seed < 2000; Seed++) {
+    MakeDigest (Seed, Digest);
+    Status = IsSignatureFoundInDatabase ((CHAR16 *)EFI_IMAGE_SECURITY_DATABASE1, Digest, &gEfiCertSha256Guid, sizeof (Digest), &IsFound);
+    ASSERT_EQ (Status, EFI_SUCCESS);
+  }
+
+  EXPECT_LE (ReadCount, (UINTN)2);
+
+  //
+  // The next verification reads it again, into the buffer already sized.
+  //
+  ReadCount = 0;
+  InvalidateSignatureDatabaseIndexes ();
+  for (UINT32 Seed = 0; Seed < 2000; Seed++) {
+    MakeDigest (Seed, Digest);
+    Status = IsSignatureFoundInDatabase ((CHAR16 *)EFI_IMAGE_SECURITY_DATABASE1, Digest, &gEfiCertSha256Guid, sizeof (Digest), &IsFound);
+    ASSERT_EQ (Status, EFI_SUCCESS);
+    EXPECT_EQ (IsFound, Seed < 1000);
+  }
+
+  EXPECT_EQ (ReadCount, (UINTN)1);
+}
+
 int
 main (
   int   argc,
@@ -65,6 +65,38 @@ DxeImageVerificationHandler (
   IN  BOOLEAN                         BootPolicy
   );
 
+/**
+  Check whether signature is in specified database.
+
+  @param[in]  VariableName        Name of database variable that is searched in.
+  @param[in]  Signature           Pointer to signature that is searched for.
+  @param[in]  CertType            Pointer to hash algorithm.
+  @param[in]  SignatureSize       Size of Signature.
+  @param[out] IsFound             Search result. Only valid if EFI_SUCCESS returned
+
+  @retval EFI_SUCCESS             Finished the search without any error.
+  @retval Others                  Error occurred in the search of database.
+
+**/
+EFI_STATUS
+IsSignatureFoundInDatabase (
+  IN  CHAR16    *VariableName,
+  IN  UINT8     *Signature,
+  IN  EFI_GUID  *CertType,
+  IN  UINTN     SignatureSize,
+  OUT BOOLEAN   *IsFound
+  );
+
+/**
+  Mark the signature database indexes stale, so that each database is read
+  again by the next lookup.
+
+**/
+VOID
+InvalidateSignatureDatabaseIndexes (
+  VOID
+  );
+
 //
 // The DxeImageVerificationLib.h file has dependencies on Pi/PiFirmwareVolume.h and Pi/PiFirmwareFile.h.
 // These macros are copied from the header file to prevent PiPei.h from being included in HOST_APPLICATION.
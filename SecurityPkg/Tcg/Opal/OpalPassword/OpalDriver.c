@@ -865,6 +865,53 @@ OpalGetPopUpString (
   return mPopUpString;
 }
 
+/**
+  Try a password which unlocked another device in this boot on a locked device.
+
+  Only the first known password is tried. A failed attempt counts against the
+  device's try limit, so it is not followed by further guesses and the caller
+  deducts it from the attempts left to the user.
+
+  @param[in]  Dev           The locked device.
+  @param[in]  Session       The session info for the device.
+  @param[out] TryCount      The number of passwords tried on the device.
+
+  @retval TcgResultSuccess             The known password unlocked the device.
+  @retval TcgResultFailureInvalidType  The device is locked out, stop trying.
+  @retval TcgResultFailure             No known password unlocked the device.
+
+**/
+TCG_RESULT
+OpalDriverTryKnownPasswords (
+  IN  OPAL_DRIVER_DEVICE  *Dev,
+  IN  OPAL_SESSION        *Session,
+  OUT UINT8               *TryCount
+  )
+{
+  OPAL_DRIVER_DEVICE  *Itr;
+  TCG_RESULT          Ret;
+
+  *TryCount = 0;
+
+  for (Itr = mOpalDriver.DeviceList; Itr != NULL; Itr = Itr->Next) {
+    if ((Itr != Dev) && (Itr->OpalDisk.PasswordLength != 0)) {
+      break;
+    }
+  }
+
+  if (Itr == NULL) {
+    return TcgResultFailure;
+  }
+
+  *TryCount = 1;
+  Ret       = OpalUtilUpdateGlobalLockingRange (Session, Itr->OpalDisk.Password, Itr->OpalDisk.PasswordLength, FALSE, FALSE);
+  if (Ret == TcgResultSuccess) {
+    OpalSupportUpdatePassword (&Dev->OpalDisk, Itr->OpalDisk.Password, Itr->OpalDisk.PasswordLength);
+  }
+
+  return Ret;
+}
+
 /**
   Check if disk is locked, show popup window and ask for password if it is.
 
@@ -924,6 +971,18 @@ OpalDriverRequestPassword (
       }
     }
 
+    if (IsLocked && PcdGetBool (PcdOpalPasswordReuse)) {
+      Ret = OpalDriverTryKnownPasswords (Dev, &Session, &Count);
+      if (Ret == TcgResultSuccess) {
+        DEBUG ((DEBUG_INFO, "%s Success with known password\n", RequestString));
+        return;
+      }
+
+      if (Ret == TcgResultFailureInvalidType) {
+        Count = MAX_PASSWORD_TRY_COUNT;
+      }
+    }
+
     while (Count < MAX_PASSWORD_TRY_COUNT) {
       Password = OpalDriverPopUpPasswordInput (Dev, PopUpString, NULL, NULL, &PressEsc);
       if (PressEsc) {
@@ -25,6 +25,7 @@ typedef struct {
 
   EFI_GUID      HandlerType; // Type of interrupt
   LIST_ENTRY    MmiHandlers; // All handlers
+  LIST_ENTRY    HashLink;    // Link on the hash bucket of HandlerType
 } MMI_ENTRY;
 
 #define MMI_HANDLER_SIGNATURE  SIGNATURE_32('m','m','i','h')
@@ -45,6 +46,52 @@ UINTN  mMmiManageCallingDepth = 0;
 LIST_ENTRY  mRootMmiHandlerList = INITIALIZE_LIST_HEAD_VARIABLE (mRootMmiHandlerList);
 LIST_ENTRY  mMmiEntryList       = INITIALIZE_LIST_HEAD_VARIABLE (mMmiEntryList);
 
+//
+// Number of hash buckets to look up MMI entries by handler type. Must be a power of 2.
+//
+#define MMI_ENTRY_HASH_BUCKETS  64
+
+//
+// MMI entries of mMmiEntryList hashed by handler type, so that MmiManage()
+// does not compare the GUID of every entry on each MMI.
+//
+LIST_ENTRY  mMmiEntryHash[MMI_ENTRY_HASH_BUCKETS];
+BOOLEAN     mMmiEntryHashInitialized = FALSE;
+
+/**
+  Get the hash bucket of an MMI handler type.
+
+  @param  HandlerType            The type of the interrupt
+
+  @return The list head of the hash bucket.
+
+**/
+LIST_ENTRY *
+MmiEntryHashBucket (
+  IN CONST EFI_GUID  *HandlerType
+  )
+{
+  UINTN   Index;
+  UINT32  Hash;
+
+  if (!mMmiEntryHashInitialized) {
+    for (Index = 0; Index < MMI_ENTRY_HASH_BUCKETS; Index++) {
+      InitializeListHead (&mMmiEntryHash[Index]);
+    }
+
+    mMmiEntryHashInitialized = TRUE;
+  }
+
+  Hash = ReadUnaligned32 ((CONST UINT32 *)HandlerType) ^
+         ReadUnaligned32 ((CONST UINT32 *)HandlerType + 1) ^
+         ReadUnaligned32 ((CONST UINT32 *)HandlerType + 2) ^
+         ReadUnaligned32 ((CONST UINT32 *)HandlerType + 3);
+  Hash ^= Hash >> 16;
+  Hash ^= Hash >> 8;
+
+  return &mMmiEntryHash[Hash & (MMI_ENTRY_HASH_BUCKETS - 1)];
+}
+
 /**
   Remove MmiHandler and free the memory it used.
   If MmiEntry is empty, remove MmiEntry and free the memory it used.
@@ -71,6 +118,7 @@ RemoveMmiHandler (
   if (MmiEntry != NULL) {
     if (IsListEmpty (&MmiEntry->MmiHandlers)) {
       RemoveEntryList (&MmiEntry->AllEntries);
+      RemoveEntryList (&MmiEntry->HashLink);
       FreePool (MmiEntry);
       return TRUE;
     }
@@ -95,19 +143,21 @@ MmCoreFindMmiEntry (
   IN BOOLEAN   Create
   )
 {
+  LIST_ENTRY  *Bucket;
   LIST_ENTRY  *Link;
   MMI_ENTRY   *Item;
   MMI_ENTRY   *MmiEntry;
 
   //
-  // Search the MMI entry list for the matching GUID
+  // Search the hash bucket of the GUID for the matching MMI entry
   //
   MmiEntry = NULL;
-  for (Link = mMmiEntryList.ForwardLink;
-       Link != &mMmiEntryList;
+  Bucket   = MmiEntryHashBucket (HandlerType);
+  for (Link = Bucket->ForwardLink;
+       Link != Bucket;
        Link = Link->ForwardLink)
   {
-    Item = CR (Link, MMI_ENTRY, AllEntries, MMI_ENTRY_SIGNATURE);
+    Item = CR (Link, MMI_ENTRY, HashLink, MMI_ENTRY_SIGNATURE);
     if (CompareGuid (&Item->HandlerType, HandlerType)) {
       //
       // This is the MMI entry
@@ -135,6 +185,7 @@ MmCoreFindMmiEntry (
       // Add it to MMI entry list
       //
       InsertTailList (&mMmiEntryList, &MmiEntry->AllEntries);
+      InsertTailList (Bucket, &MmiEntry->HashLink);
     }
   }
 
@@ -767,21 +767,26 @@ MmInternalFreePagesEx (
     return EFI_INVALID_PARAMETER;
   }
 
-  Pages = NULL;
-  Node  = mMmMemoryMap.ForwardLink;
-  while (Node != &mMmMemoryMap) {
-    Pages = BASE_CR (Node, FREE_PAGE_LIST, Link);
-    if (Memory < (UINTN)Pages) {
+  //
+  // Pages are allocated from the top of the free list, so the freed range
+  // usually sits close to the tail. Search the insertion point backward to
+  // find the first node above Memory.
+  //
+  Node = &mMmMemoryMap;
+  while (Node->BackLink != &mMmMemoryMap) {
+    Pages = BASE_CR (Node->BackLink, FREE_PAGE_LIST, Link);
+    if (Memory >= (UINTN)Pages) {
       break;
     }
 
-    Node = Node->ForwardLink;
+    Node = Node->BackLink;
   }
 
-  if ((Node != &mMmMemoryMap) &&
-      (Memory + EFI_PAGES_TO_SIZE (NumberOfPages) > (UINTN)Pages))
-  {
-    return EFI_INVALID_PARAMETER;
+  if (Node != &mMmMemoryMap) {
+    Pages = BASE_CR (Node, FREE_PAGE_LIST, Link);
+    if (Memory + EFI_PAGES_TO_SIZE (NumberOfPages) > (UINTN)Pages) {
+      return EFI_INVALID_PARAMETER;
+    }
   }
 
   if (Node->BackLink != &mMmMemoryMap) {
@@ -117,6 +117,56 @@ typedef struct {
   IA32_MAP_ATTRIBUTE    Attribute;
 } IA32_MAP_ENTRY;
 
+typedef struct {
+  UINT64                LinearAddress;
+  UINT64                Length;
+  IA32_MAP_ATTRIBUTE    Attribute;
+  IA32_MAP_ATTRIBUTE    Mask;
+} IA32_MAP_REQUEST;
+
+/**
+  Create or update page table to map multiple linear address ranges with their specified attributes.
+
+  The requests are sorted by linear address, and adjacent requests with the same mask and compatible attributes
+  are merged before the page table is updated. The caller only needs to flush TLB once when IsModified is TRUE.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+                                 The required size is calculated for each merged request separately, so it may be larger than
+                                 what is finally consumed.
+  @param[in, out] Requests       Array of the linear address ranges and their attributes and masks.
+                                 On return, the array is sorted and merged in place, even when an error is returned.
+  @param[in, out] RequestCount   On input, the number of entries in Requests.
+                                 On output, the number of entries in Requests after merging.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Requests or RequestCount is NULL.
+  @retval RETURN_INVALID_PARAMETER  Two requests overlap.
+  @retval RETURN_INVALID_PARAMETER  One request is rejected by PageTableMap().
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    The page table is not modified.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMapBatch (
+  IN OUT UINTN             *PageTable     OPTIONAL,
+  IN     PAGING_MODE       PagingMode,
+  IN     VOID              *Buffer,
+  IN OUT UINTN             *BufferSize,
+  IN OUT IA32_MAP_REQUEST  *Requests,
+  IN OUT UINTN             *RequestCount,
+  OUT    BOOLEAN           *IsModified    OPTIONAL
+  );
+
 /**
   Parse page table.
 
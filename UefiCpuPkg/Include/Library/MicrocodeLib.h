@@ -12,6 +12,17 @@
 #include <Register/Intel/Microcode.h>
 #include <Ppi/ShadowMicrocode.h>
 
+///
+/// Entry of the microcode patch index. A patch has one entry for the processor
+/// signature in its primary header and one for each extended signature.
+///
+typedef struct {
+  UINT32    ProcessorSignature;
+  UINT32    ProcessorFlags;
+  UINT32    UpdateRevision;
+  UINT32    Offset;             ///< Offset of the patch from the start of the patch region.
+} MICROCODE_PATCH_INDEX_ENTRY;
+
 /**
   Get microcode update signature of currently loaded microcode update.
 
@@ -117,4 +128,63 @@ IsValidMicrocode (
   IN BOOLEAN                     VerifyChecksum
   );
 
+/**
+  Build the index of the microcode patches in a microcode patch region.
+
+  Only the patch headers are parsed. The checksum of a patch is verified when
+  the patch is returned by FindMicrocodeInIndex(). The entries are sorted by
+  processor signature, then from the newest revision to the oldest, then by
+  offset.
+
+  @param MicrocodePatchAddress     Start address of the microcode patch region.
+  @param MicrocodePatchRegionSize  Size in bytes of the microcode patch region.
+  @param Index                     Buffer to receive the index entries.
+                                   It can be NULL when *IndexCount is 0.
+  @param IndexCount                On input, the number of entries Index can hold.
+                                   On output, the number of entries of the whole index.
+
+  @retval RETURN_SUCCESS            The index is built.
+  @retval RETURN_BUFFER_TOO_SMALL   Index is too small. IndexCount is updated with the required number.
+  @retval RETURN_INVALID_PARAMETER  IndexCount is NULL, or Index is NULL while *IndexCount is not 0.
+  @retval RETURN_UNSUPPORTED        MicrocodePatchRegionSize exceeds MAX_UINT32.
+**/
+RETURN_STATUS
+EFIAPI
+BuildMicrocodePatchIndex (
+  IN     VOID                         *MicrocodePatchAddress,
+  IN     UINTN                        MicrocodePatchRegionSize,
+  OUT    MICROCODE_PATCH_INDEX_ENTRY  *Index OPTIONAL,
+  IN OUT UINTN                        *IndexCount
+  );
+
+/**
+  Find the latest valid microcode patch for a processor with the microcode patch index.
+
+  The index entries of the processor signature are located by binary search,
+  and the candidates are verified by IsValidMicrocode() with checksum from the
+  newest revision to the oldest. An index that does not describe the patch
+  region, e.g. it is out of date, can therefore only cause a patch to be missed,
+  never an invalid patch to be returned. Caller can fall back to scanning the
+  patch region when NULL is returned.
+
+  @param MicrocodePatchAddress     Start address of the microcode patch region.
+  @param MicrocodePatchRegionSize  Size in bytes of the microcode patch region.
+  @param Index                     The index built by BuildMicrocodePatchIndex().
+  @param IndexCount                The number of entries in Index.
+  @param MicrocodeCpuId            The processor signature and platform ID of the processor.
+  @param MinimumRevision           The microcode whose revision <= MinimumRevision is skipped.
+
+  @return The latest valid microcode patch, or NULL if no valid patch is found.
+**/
+CPU_MICROCODE_HEADER *
+EFIAPI
+FindMicrocodeInIndex (
+  IN VOID                               *MicrocodePatchAddress,
+  IN UINTN                              MicrocodePatchRegionSize,
+  IN CONST MICROCODE_PATCH_INDEX_ENTRY  *Index,
+  IN UINTN                              IndexCount,
+  IN EDKII_PEI_MICROCODE_CPU_ID         *MicrocodeCpuId,
+  IN UINT32                             MinimumRevision
+  );
+
 #endif
@@ -0,0 +1,84 @@
+/** @file
+  Provides a pool of processors to run fine-grained tasks in parallel.
+
+  A batch of TaskCount tasks is split across the enabled processors. Each
+  processor runs the tasks of its own range and steals half of the remaining
+  range of a busier processor when it runs out of tasks, so batches of uneven
+  tasks keep every processor busy until the batch is done.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef TASK_POOL_LIB_H_
+#define TASK_POOL_LIB_H_
+
+/**
+  Run one task of a batch.
+
+  The function runs on the BSP or on an AP. It must only use services which
+  are safe to call from an AP, as for EFI_AP_PROCEDURE.
+
+  @param[in] Context    The context passed to TaskPoolParallelFor() or
+                        TaskPoolParallelForAsync().
+  @param[in] Index      The index of the task, from 0 to TaskCount - 1.
+
+**/
+typedef
+VOID
+(EFIAPI *TASK_POOL_PROCEDURE)(
+  IN VOID   *Context,
+  IN UINTN  Index
+  );
+
+/**
+  Run TaskCount tasks on all enabled processors and wait for them to finish.
+
+  The BSP runs tasks together with the APs. When there is no AP, or the APs
+  are busy with other work, all tasks run on the BSP.
+
+  @param[in] TaskCount    The number of tasks in the batch.
+  @param[in] Procedure    The function run for each task.
+  @param[in] Context      The context passed to Procedure.
+
+  @retval EFI_SUCCESS            All tasks have run.
+  @retval EFI_INVALID_PARAMETER  Procedure is NULL.
+  @retval EFI_OUT_OF_RESOURCES   Failed to allocate the batch.
+
+**/
+EFI_STATUS
+EFIAPI
+TaskPoolParallelFor (
+  IN UINTN                TaskCount,
+  IN TASK_POOL_PROCEDURE  Procedure,
+  IN VOID                 *Context
+  );
+
+/**
+  Start TaskCount tasks on the APs and return without waiting for them.
+
+  CompletionEvent is signaled at TPL_CALLBACK once all tasks have run. When
+  there is no AP, or the APs are busy with other work, all tasks run on the
+  BSP before this function returns and CompletionEvent is signaled.
+
+  @param[in] TaskCount        The number of tasks in the batch.
+  @param[in] Procedure        The function run for each task.
+  @param[in] Context          The context passed to Procedure. It must stay
+                              valid until CompletionEvent is signaled.
+  @param[in] CompletionEvent  The event signaled when all tasks have run.
+
+  @retval EFI_SUCCESS            The batch is started or done.
+  @retval EFI_INVALID_PARAMETER  Procedure or CompletionEvent is NULL.
+  @retval EFI_OUT_OF_RESOURCES   Failed to allocate the batch.
+
+**/
+EFI_STATUS
+EFIAPI
+TaskPoolParallelForAsync (
+  IN UINTN                TaskCount,
+  IN TASK_POOL_PROCEDURE  Procedure,
+  IN VOID                 *Context,
+  IN EFI_EVENT            CompletionEvent
+  );
+
+#endif
@@ -230,4 +230,40 @@ PageTableLibGetPnleMapAttribute (
   IN IA32_MAP_ATTRIBUTE        *ParentMapAttribute
   );
 
+/**
+  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute,
+  or only calculate the buffer size required to do so.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Modify         FALSE to only return the required buffer size in BufferSize without modifying the page table.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size when Modify is TRUE, or the required buffer size
+                                 when Modify is FALSE.
+  @param[in]      LinearAddress  The start of the linear address range.
+  @param[in]      Length         The length of the linear address range.
+  @param[in]      Attribute      The attribute of the linear address range.
+  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware.
+
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+                                    Or the required buffer size is returned when Modify is FALSE.
+  @retval others                    See PageTableMap().
+**/
+RETURN_STATUS
+PageTableLibMap (
+  IN OUT UINTN               *PageTable  OPTIONAL,
+  IN     PAGING_MODE         PagingMode,
+  IN     BOOLEAN             Modify,
+  IN     VOID                *Buffer,
+  IN OUT UINTN               *BufferSize,
+  IN     UINT64              LinearAddress,
+  IN     UINT64              Length,
+  IN     IA32_MAP_ATTRIBUTE  *Attribute,
+  IN     IA32_MAP_ATTRIBUTE  *Mask,
+  OUT    BOOLEAN             *IsModified   OPTIONAL
+  );
+
 #endif
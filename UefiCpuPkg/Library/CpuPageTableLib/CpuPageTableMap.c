@@ -648,14 +648,17 @@ PageTableLibMapInLevel (
 }
 
 /**
-  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
+  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute,
+  or only calculate the buffer size required to do so.
 
   @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
                                  If not pointer to NULL, the value it points to won't be changed in this function.
   @param[in]      PagingMode     The paging mode.
+  @param[in]      Modify         FALSE to only return the required buffer size in BufferSize without modifying the page table.
   @param[in]      Buffer         The free buffer to be used for page table creation/updating.
   @param[in, out] BufferSize     The buffer size.
-                                 On return, the remaining buffer size.
+                                 On return, the remaining buffer size when Modify is TRUE, or the required buffer size
+                                 when Modify is FALSE.
                                  The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
                                  BufferSize in the second call to this API.
   @param[in]      LinearAddress  The start of the linear address range.
@@ -680,12 +683,13 @@ PageTableLibMapInLevel (
                                     BufferSize is updated to indicate the expected buffer size.
                                     Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
   @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+                                    Or the required buffer size is returned when Modify is FALSE.
 **/
 RETURN_STATUS
-EFIAPI
-PageTableMap (
+PageTableLibMap (
   IN OUT UINTN               *PageTable  OPTIONAL,
   IN     PAGING_MODE         PagingMode,
+  IN     BOOLEAN             Modify,
   IN     VOID                *Buffer,
   IN OUT UINTN               *BufferSize,
   IN     UINT64              LinearAddress,
@@ -821,6 +825,11 @@ PageTableMap (
 
   RequiredSize = -RequiredSize;
 
+  if (!Modify) {
+    *BufferSize = RequiredSize;
+    return RETURN_SUCCESS;
+  }
+
   if ((UINTN)RequiredSize > *BufferSize) {
     *BufferSize = RequiredSize;
     return RETURN_BUFFER_TOO_SMALL;
@@ -881,3 +890,54 @@ PageTableMap (
 
   return Status;
 }
+
+/**
+  Create or update page table to map [LinearAddress, LinearAddress + Length) with specified attribute.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+  @param[in]      LinearAddress  The start of the linear address range.
+  @param[in]      Length         The length of the linear address range.
+  @param[in]      Attribute      The attribute of the linear address range.
+                                 All non-reserved fields in IA32_MAP_ATTRIBUTE are supported to set in the page table.
+                                 Page table entries that map the linear address range are reset to 0 before set to the new attribute
+                                 when a new physical base address is set.
+  @param[in]      Mask           The mask used for attribute. The corresponding field in Attribute is ignored if that in Mask is 0.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+                                 If the output IsModified is FALSE, there is possibility that the page table is changed by hardware. It is ok
+                                 because page table can be changed by hardware anytime, and caller don't need to Flush TLB.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Attribute or Mask is NULL.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 1 but some other attributes are not provided.
+  @retval RETURN_INVALID_PARAMETER  For non-present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  For present range, Mask->Bits.Present is 1, Attribute->Bits.Present is 0 but some other attributes are provided.
+  @retval RETURN_INVALID_PARAMETER  *BufferSize is not multiple of 4KB.
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    Caller may still get RETURN_BUFFER_TOO_SMALL with the new BufferSize.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully or the input Length is 0.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMap (
+  IN OUT UINTN               *PageTable  OPTIONAL,
+  IN     PAGING_MODE         PagingMode,
+  IN     VOID                *Buffer,
+  IN OUT UINTN               *BufferSize,
+  IN     UINT64              LinearAddress,
+  IN     UINT64              Length,
+  IN     IA32_MAP_ATTRIBUTE  *Attribute,
+  IN     IA32_MAP_ATTRIBUTE  *Mask,
+  OUT    BOOLEAN             *IsModified   OPTIONAL
+  )
+{
+  return PageTableLibMap (PageTable, PagingMode, TRUE, Buffer, BufferSize, LinearAddress, Length, Attribute, Mask, IsModified);
+}
@@ -0,0 +1,241 @@
+/** @file
+  Batched page table mapping for CpuPageTableLib.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "CpuPageTable.h"
+
+/**
+  Return TRUE when the request Next can be merged into the request Prev.
+
+  @param[in] Prev  Pointer to the request that ends where Next starts.
+  @param[in] Next  Pointer to the request that follows Prev.
+
+  @retval TRUE  Both requests can be applied as one.
+  @retval FALSE Both requests cannot be applied as one.
+**/
+STATIC
+BOOLEAN
+PageTableLibIsRequestMergeable (
+  IN IA32_MAP_REQUEST  *Prev,
+  IN IA32_MAP_REQUEST  *Next
+  )
+{
+  if ((Prev->LinearAddress + Prev->Length != Next->LinearAddress) || (Prev->Mask.Uint64 != Next->Mask.Uint64)) {
+    return FALSE;
+  }
+
+  if ((IA32_MAP_ATTRIBUTE_ATTRIBUTES (&Prev->Attribute) & Prev->Mask.Uint64) !=
+      (IA32_MAP_ATTRIBUTE_ATTRIBUTES (&Next->Attribute) & Next->Mask.Uint64))
+  {
+    return FALSE;
+  }
+
+  if ((Prev->Mask.Bits.PageTableBaseAddressLow == 0) && (Prev->Mask.Bits.PageTableBaseAddressHigh == 0)) {
+    return TRUE;
+  }
+
+  //
+  // The physical address should continue from Prev to Next.
+  //
+  return (BOOLEAN)(IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (&Prev->Attribute) + Prev->Length ==
+                   IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (&Next->Attribute));
+}
+
+/**
+  Sort the requests by linear address and merge the adjacent compatible requests in place.
+
+  @param[in, out] Requests      Array of the requests.
+  @param[in, out] RequestCount  On input, the number of entries in Requests.
+                                On output, the number of entries in Requests after merging.
+
+  @retval RETURN_INVALID_PARAMETER  Two requests overlap.
+  @retval RETURN_SUCCESS            The requests are sorted and merged.
+**/
+STATIC
+RETURN_STATUS
+PageTableLibSortAndMergeRequests (
+  IN OUT IA32_MAP_REQUEST  *Requests,
+  IN OUT UINTN             *RequestCount
+  )
+{
+  UINTN             Index;
+  UINTN             Count;
+  UINTN             Insert;
+  IA32_MAP_REQUEST  Request;
+
+  //
+  // Drop the empty requests and do an insertion sort on the rest.
+  // The number of requests from one caller is small and mostly sorted already.
+  //
+  for (Index = 0, Count = 0; Index < *RequestCount; Index++) {
+    if (Requests[Index].Length == 0) {
+      continue;
+    }
+
+    CopyMem (&Request, &Requests[Index], sizeof (Request));
+    for (Insert = Count; Insert > 0 && Requests[Insert - 1].LinearAddress > Request.LinearAddress; Insert--) {
+      CopyMem (&Requests[Insert], &Requests[Insert - 1], sizeof (Request));
+    }
+
+    CopyMem (&Requests[Insert], &Request, sizeof (Request));
+    Count++;
+  }
+
+  *RequestCount = Count;
+  if (Count == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  for (Index = 1, Count = 0; Index < *RequestCount; Index++) {
+    if (Requests[Index].LinearAddress < Requests[Count].LinearAddress + Requests[Count].Length) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    if (PageTableLibIsRequestMergeable (&Requests[Count], &Requests[Index])) {
+      Requests[Count].Length += Requests[Index].Length;
+    } else {
+      Count++;
+      if (Count != Index) {
+        CopyMem (&Requests[Count], &Requests[Index], sizeof (Request));
+      }
+    }
+  }
+
+  *RequestCount = Count + 1;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Create or update page table to map multiple linear address ranges with their specified attributes.
+
+  The requests are sorted by linear address, and adjacent requests with the same mask and compatible attributes
+  are merged before the page table is updated. The caller only needs to flush TLB once when IsModified is TRUE.
+
+  @param[in, out] PageTable      The pointer to the page table to update, or pointer to NULL if a new page table is to be created.
+                                 If not pointer to NULL, the value it points to won't be changed in this function.
+  @param[in]      PagingMode     The paging mode.
+  @param[in]      Buffer         The free buffer to be used for page table creation/updating.
+  @param[in, out] BufferSize     The buffer size.
+                                 On return, the remaining buffer size.
+                                 The free buffer is used from the end so caller can supply the same Buffer pointer with an updated
+                                 BufferSize in the second call to this API.
+                                 The required size is calculated for each merged request separately, so it may be larger than
+                                 what is finally consumed.
+  @param[in, out] Requests       Array of the linear address ranges and their attributes and masks.
+                                 On return, the array is sorted and merged in place, even when an error is returned.
+  @param[in, out] RequestCount   On input, the number of entries in Requests.
+                                 On output, the number of entries in Requests after merging.
+  @param[out]     IsModified     TRUE means page table is modified by software or hardware. FALSE means page table is not modified by software.
+
+  @retval RETURN_UNSUPPORTED        PagingMode is not supported.
+  @retval RETURN_INVALID_PARAMETER  PageTable, BufferSize, Requests or RequestCount is NULL.
+  @retval RETURN_INVALID_PARAMETER  Two requests overlap.
+  @retval RETURN_INVALID_PARAMETER  One request is rejected by PageTableMap().
+  @retval RETURN_BUFFER_TOO_SMALL   The buffer is too small for page table creation/updating.
+                                    BufferSize is updated to indicate the expected buffer size.
+                                    The page table is not modified.
+  @retval RETURN_SUCCESS            PageTable is created/updated successfully.
+**/
+RETURN_STATUS
+EFIAPI
+PageTableMapBatch (
+  IN OUT UINTN             *PageTable     OPTIONAL,
+  IN     PAGING_MODE       PagingMode,
+  IN     VOID              *Buffer,
+  IN OUT UINTN             *BufferSize,
+  IN OUT IA32_MAP_REQUEST  *Requests,
+  IN OUT UINTN             *RequestCount,
+  OUT    BOOLEAN           *IsModified    OPTIONAL
+  )
+{
+  RETURN_STATUS  Status;
+  UINTN          Index;
+  UINTN          RequiredSize;
+  UINTN          Size;
+  BOOLEAN        LocalIsModified;
+  BOOLEAN        RequestIsModified;
+
+  if ((PagingMode == Paging32bit) || (PagingMode >= PagingModeMax)) {
+    //
+    // 32bit paging is never supported.
+    //
+    return RETURN_UNSUPPORTED;
+  }
+
+  if ((PageTable == NULL) || (BufferSize == NULL) || (RequestCount == NULL) || ((*RequestCount != 0) && (Requests == NULL))) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  if (IsModified == NULL) {
+    IsModified = &LocalIsModified;
+  }
+
+  *IsModified = FALSE;
+
+  Status = PageTableLibSortAndMergeRequests (Requests, RequestCount);
+  if (RETURN_ERROR (Status) || (*RequestCount == 0)) {
+    return Status;
+  }
+
+  //
+  // Query the required buffer size of all requests without modifying the page table.
+  // Each request is checked against the current page table, so the sum doesn't count
+  // the page tables that one request creates and a following request reuses.
+  //
+  RequiredSize = 0;
+  for (Index = 0; Index < *RequestCount; Index++) {
+    Size   = 0;
+    Status = PageTableLibMap (
+               PageTable,
+               PagingMode,
+               FALSE,
+               NULL,
+               &Size,
+               Requests[Index].LinearAddress,
+               Requests[Index].Length,
+               &Requests[Index].Attribute,
+               &Requests[Index].Mask,
+               NULL
+               );
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+
+    RequiredSize += Size;
+  }
+
+  if (RequiredSize > *BufferSize) {
+    *BufferSize = RequiredSize;
+    return RETURN_BUFFER_TOO_SMALL;
+  }
+
+  if ((RequiredSize != 0) && (Buffer == NULL)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  for (Index = 0; Index < *RequestCount; Index++) {
+    Status = PageTableLibMap (
+               PageTable,
+               PagingMode,
+               TRUE,
+               Buffer,
+               BufferSize,
+               Requests[Index].LinearAddress,
+               Requests[Index].Length,
+               &Requests[Index].Attribute,
+               &Requests[Index].Mask,
+               &RequestIsModified
+               );
+    ASSERT_RETURN_ERROR (Status);
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+
+    *IsModified = (BOOLEAN)(*IsModified || RequestIsModified);
+  }
+
+  return RETURN_SUCCESS;
+}
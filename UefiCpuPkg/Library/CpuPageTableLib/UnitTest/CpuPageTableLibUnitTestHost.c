@@ -821,6 +821,186 @@ TestCaseToCheckMapMaskAndAttr (
   return UNIT_TEST_PASSED;
 }
 
+/**
+  Check PageTableMapBatch merges the requests and maps them with one buffer.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TestCaseManualBatchMap (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN               PageTable;
+  PAGING_MODE         PagingMode;
+  VOID                *Buffer;
+  UINTN               PageTableBufferSize;
+  IA32_MAP_ATTRIBUTE  MapAttribute;
+  IA32_MAP_ATTRIBUTE  ExpectedMapAttribute;
+  IA32_MAP_ATTRIBUTE  MapMask;
+  RETURN_STATUS       Status;
+  IA32_MAP_ENTRY      *Map;
+  UINTN               MapCount;
+  IA32_MAP_REQUEST    Requests[4];
+  UINTN               RequestCount;
+  BOOLEAN             IsModified;
+  IA32_PAGING_ENTRY   *PagingEntry;
+  UNIT_TEST_STATUS    TestStatus;
+
+  PagingMode                  = Paging4Level1GB;
+  PageTableBufferSize         = 0;
+  PageTable                   = 0;
+  Buffer                      = NULL;
+  MapAttribute.Uint64         = 0;
+  MapMask.Uint64              = MAX_UINT64;
+  MapAttribute.Bits.Present   = 1;
+  MapAttribute.Bits.ReadWrite = 1;
+
+  //
+  // Create Page table to cover [0,2G] with two 1G entries
+  //
+  Status = PageTableMap (&PageTable, PagingMode, Buffer, &PageTableBufferSize, (UINT64)0, (UINT64)SIZE_1GB * 2, &MapAttribute, &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+  Status = PageTableMap (&PageTable, PagingMode, Buffer, &PageTableBufferSize, (UINT64)0, (UINT64)SIZE_1GB * 2, &MapAttribute, &MapMask, NULL);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+
+  PagingEntry = (IA32_PAGING_ENTRY *)(UINTN)IA32_PNLE_PAGE_TABLE_BASE_ADDRESS (&((IA32_PAGING_ENTRY *)PageTable)->Pnle);
+  UT_ASSERT_TRUE (IsPle (&PagingEntry[0], Pdpte));
+  UT_ASSERT_TRUE (IsPle (&PagingEntry[1], Pdpte));
+
+  //
+  // Overlapped requests are rejected without touching the page table.
+  //
+  ZeroMem (Requests, sizeof (Requests));
+  Requests[0].LinearAddress = 0;
+  Requests[0].Length        = SIZE_8KB;
+  Requests[0].Mask.Bits.Nx  = 1;
+  Requests[1].LinearAddress = SIZE_4KB;
+  Requests[1].Length        = SIZE_4KB;
+  Requests[1].Mask.Bits.Nx  = 1;
+  RequestCount              = 2;
+  PageTableBufferSize       = 0;
+  Status                    = PageTableMapBatch (&PageTable, PagingMode, NULL, &PageTableBufferSize, Requests, &RequestCount, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_INVALID_PARAMETER);
+  UT_ASSERT_EQUAL (IsModified, FALSE);
+
+  //
+  // Mark [4K,12K] as Nx in two unsorted requests and [1G+2M,1G+4M] as read-only.
+  // The first two requests are merged, and the page table is not modified when the buffer is too small.
+  //
+  ZeroMem (Requests, sizeof (Requests));
+  Requests[0].LinearAddress            = SIZE_8KB;
+  Requests[0].Length                   = SIZE_4KB;
+  Requests[0].Attribute.Bits.Nx        = 1;
+  Requests[0].Mask.Bits.Nx             = 1;
+  Requests[1].LinearAddress            = SIZE_1GB + SIZE_2MB;
+  Requests[1].Length                   = SIZE_2MB;
+  Requests[1].Attribute.Bits.ReadWrite = 0;
+  Requests[1].Mask.Bits.ReadWrite      = 1;
+  Requests[2].LinearAddress            = SIZE_4KB;
+  Requests[2].Length                   = SIZE_4KB;
+  Requests[2].Attribute.Bits.Nx        = 1;
+  Requests[2].Mask.Bits.Nx             = 1;
+  RequestCount                         = 3;
+  PageTableBufferSize                  = 0;
+  Status                               = PageTableMapBatch (&PageTable, PagingMode, NULL, &PageTableBufferSize, Requests, &RequestCount, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  UT_ASSERT_EQUAL (RequestCount, 2);
+  UT_ASSERT_EQUAL (Requests[0].LinearAddress, SIZE_4KB);
+  UT_ASSERT_EQUAL (Requests[0].Length, SIZE_8KB);
+  UT_ASSERT_EQUAL (Requests[1].LinearAddress, SIZE_1GB + SIZE_2MB);
+  //
+  // [0,1G] needs one page directory and one page table, [1G,2G] needs one page directory.
+  //
+  UT_ASSERT_EQUAL (PageTableBufferSize, SIZE_4KB * 3);
+  UT_ASSERT_EQUAL (IsModified, FALSE);
+  UT_ASSERT_TRUE (IsPle (&PagingEntry[0], Pdpte));
+
+  Buffer = AllocatePages (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+  Status = PageTableMapBatch (&PageTable, PagingMode, Buffer, &PageTableBufferSize, Requests, &RequestCount, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (PageTableBufferSize, 0);
+  UT_ASSERT_EQUAL (IsModified, TRUE);
+  TestStatus = IsPageTableValid (PageTable, PagingMode);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  UT_ASSERT_FALSE (IsPle (&PagingEntry[0], Pdpte));
+  UT_ASSERT_FALSE (IsPle (&PagingEntry[1], Pdpte));
+
+  MapCount = 0;
+  Status   = PageTableParse (PageTable, PagingMode, NULL, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Map    = AllocatePages (EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+  Status = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (MapCount, 5);
+  UT_ASSERT_EQUAL (Map[1].LinearAddress, SIZE_4KB);
+  UT_ASSERT_EQUAL (Map[1].Length, SIZE_8KB);
+  ExpectedMapAttribute.Uint64  = MapAttribute.Uint64 | SIZE_4KB;
+  ExpectedMapAttribute.Bits.Nx = 1;
+  UT_ASSERT_EQUAL (Map[1].Attribute.Uint64, ExpectedMapAttribute.Uint64);
+  UT_ASSERT_EQUAL (Map[3].LinearAddress, SIZE_1GB + SIZE_2MB);
+  UT_ASSERT_EQUAL (Map[3].Length, SIZE_2MB);
+  ExpectedMapAttribute.Uint64         = MapAttribute.Uint64 | (SIZE_1GB + SIZE_2MB);
+  ExpectedMapAttribute.Bits.ReadWrite = 0;
+  UT_ASSERT_EQUAL (Map[3].Attribute.Uint64, ExpectedMapAttribute.Uint64);
+
+  //
+  // Restore [0,12K] and [1G+2M,1G+4M] with the page tables that are already split.
+  //
+  ZeroMem (Requests, sizeof (Requests));
+  Requests[0].LinearAddress            = 0;
+  Requests[0].Length                   = SIZE_16KB;
+  Requests[0].Mask.Bits.Nx             = 1;
+  Requests[1].LinearAddress            = SIZE_1GB;
+  Requests[1].Length                   = SIZE_1GB;
+  Requests[1].Attribute.Bits.ReadWrite = 1;
+  Requests[1].Mask.Bits.ReadWrite      = 1;
+  RequestCount                         = 2;
+  PageTableBufferSize                  = 0;
+  Status                               = PageTableMapBatch (&PageTable, PagingMode, NULL, &PageTableBufferSize, Requests, &RequestCount, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (IsModified, TRUE);
+  TestStatus = IsPageTableValid (PageTable, PagingMode);
+  if (TestStatus != UNIT_TEST_PASSED) {
+    return TestStatus;
+  }
+
+  MapCount = 0;
+  Status   = PageTableParse (PageTable, PagingMode, NULL, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_BUFFER_TOO_SMALL);
+  Map    = AllocatePages (EFI_SIZE_TO_PAGES (MapCount * sizeof (IA32_MAP_ENTRY)));
+  Status = PageTableParse (PageTable, PagingMode, Map, &MapCount);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (MapCount, 1);
+  UT_ASSERT_EQUAL (Map[0].LinearAddress, 0);
+  UT_ASSERT_EQUAL (Map[0].Length, SIZE_2GB);
+  UT_ASSERT_EQUAL (Map[0].Attribute.Uint64, MapAttribute.Uint64);
+
+  //
+  // Nothing is changed when applying the same requests again.
+  //
+  Status = PageTableMapBatch (&PageTable, PagingMode, NULL, &PageTableBufferSize, Requests, &RequestCount, &IsModified);
+  UT_ASSERT_EQUAL (Status, RETURN_SUCCESS);
+  UT_ASSERT_EQUAL (IsModified, FALSE);
+
+  return UNIT_TEST_PASSED;
+}
+
 /**
   Initialize the unit test framework, suite, and unit tests for the
   sample unit tests and run the unit tests.
@@ -872,6 +1052,7 @@ UefiTestMain (
   AddTestCase (ManualTestCase, "Check if the parent entry has different Nx attribute", "Manual Test Case6", TestCaseManualChangeNx, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check if the needed size is expected", "Manual Test Case7", TestCaseManualSizeNotMatch, NULL, NULL, NULL);
   AddTestCase (ManualTestCase, "Check MapMask when creating new page table or mapping not-present range", "Manual Test Case8", TestCaseToCheckMapMaskAndAttr, NULL, NULL, NULL);
+  AddTestCase (ManualTestCase, "Check PageTableMapBatch merges requests and maps them at once", "Manual Test Case9", TestCaseManualBatchMap, NULL, NULL, NULL);
   //
   // Populate the Random Test Cases.
   //
@@ -12,6 +12,7 @@
 #include <Register/Intel/Microcode.h>
 #include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
+#include <Library/MicrocodeLib.h>
 #include <Ppi/ShadowMicrocode.h>
 
 /**
@@ -248,17 +249,12 @@ IsValidMicrocode (
     return FALSE;
   }
 
-  //
-  // The summation of all DWORDs in microcode should be zero.
-  //
-  if (VerifyChecksum && (CalculateSum32 ((UINT32 *)Microcode, TotalSize) != 0)) {
-    return FALSE;
-  }
-
   Sum32 = Microcode->ProcessorSignature.Uint32 + Microcode->ProcessorFlags + Microcode->Checksum;
 
   //
   // Check the processor signature and platform ID in the primary header.
+  // The checksum is only verified for the microcode that matches, because
+  // summing up every microcode is slow when performing on flash.
   //
   Match = IsProcessorMatchedMicrocode (
             Microcode->ProcessorSignature.Uint32,
@@ -267,7 +263,10 @@ IsValidMicrocode (
             MicrocodeCpuIdCount
             );
   if (Match) {
-    return TRUE;
+    //
+    // The summation of all DWORDs in microcode should be zero.
+    //
+    return (BOOLEAN)(!VerifyChecksum || (CalculateSum32 ((UINT32 *)Microcode, TotalSize) == 0));
   }
 
   ExtendedTableLength = TotalSize - (DataSize + sizeof (CPU_MICROCODE_HEADER));
@@ -289,13 +288,6 @@ IsValidMicrocode (
     return FALSE;
   }
 
-  //
-  // Check the extended table checksum
-  //
-  if (VerifyChecksum && (CalculateSum32 ((UINT32 *)ExtendedTableHeader, ExtendedTableLength) != 0)) {
-    return FALSE;
-  }
-
   ExtendedTable = (CPU_MICROCODE_EXTENDED_TABLE *)(ExtendedTableHeader + 1);
   for (Index = 0; Index < ExtendedTableHeader->ExtendedSignatureCount; Index++) {
     if (VerifyChecksum &&
@@ -323,9 +315,256 @@ IsValidMicrocode (
               MicrocodeCpuIdCount
               );
     if (Match) {
-      return TRUE;
+      //
+      // The summation of all DWORDs in microcode should be zero, and so should
+      // the summation of all DWORDs in the extended table.
+      //
+      return (BOOLEAN)(!VerifyChecksum ||
+                       ((CalculateSum32 ((UINT32 *)Microcode, TotalSize) == 0) &&
+                        (CalculateSum32 ((UINT32 *)ExtendedTableHeader, ExtendedTableLength) == 0)));
     }
   }
 
   return FALSE;
 }
+
+/**
+  Insert an entry into the microcode patch index and keep the index sorted.
+
+  The entries are sorted by processor signature, then from the newest revision
+  to the oldest. An entry is inserted after the existing entries with the same
+  signature and revision, so the entries of the same key stay in offset order.
+
+  @param Index       The microcode patch index.
+  @param IndexCount  The number of entries in the index.
+  @param Entry       The entry to insert.
+**/
+STATIC
+VOID
+InsertMicrocodePatchIndexEntry (
+  IN OUT MICROCODE_PATCH_INDEX_ENTRY        *Index,
+  IN     UINTN                              IndexCount,
+  IN     CONST MICROCODE_PATCH_INDEX_ENTRY  *Entry
+  )
+{
+  UINTN  Position;
+
+  for (Position = IndexCount; Position > 0; Position--) {
+    if ((Index[Position - 1].ProcessorSignature < Entry->ProcessorSignature) ||
+        ((Index[Position - 1].ProcessorSignature == Entry->ProcessorSignature) &&
+         (Index[Position - 1].UpdateRevision >= Entry->UpdateRevision)))
+    {
+      break;
+    }
+
+    Index[Position] = Index[Position - 1];
+  }
+
+  Index[Position] = *Entry;
+}
+
+/**
+  Add an entry to the microcode patch index when there is room for it.
+
+  @param Index          The microcode patch index.
+  @param IndexCapacity  The number of entries Index can hold.
+  @param IndexCount     The number of entries of the whole index. It is increased by 1.
+  @param Entry          The entry to add.
+**/
+STATIC
+VOID
+AddMicrocodePatchIndexEntry (
+  IN OUT MICROCODE_PATCH_INDEX_ENTRY        *Index,
+  IN     UINTN                              IndexCapacity,
+  IN OUT UINTN                              *IndexCount,
+  IN     CONST MICROCODE_PATCH_INDEX_ENTRY  *Entry
+  )
+{
+  if (*IndexCount < IndexCapacity) {
+    InsertMicrocodePatchIndexEntry (Index, *IndexCount, Entry);
+  }
+
+  (*IndexCount)++;
+}
+
+/**
+  Build the index of the microcode patches in a microcode patch region.
+
+  Only the patch headers are parsed. The checksum of a patch is verified when
+  the patch is returned by FindMicrocodeInIndex(). The entries are sorted by
+  processor signature, then from the newest revision to the oldest, then by
+  offset.
+
+  @param MicrocodePatchAddress     Start address of the microcode patch region.
+  @param MicrocodePatchRegionSize  Size in bytes of the microcode patch region.
+  @param Index                     Buffer to receive the index entries.
+                                   It can be NULL when *IndexCount is 0.
+  @param IndexCount                On input, the number of entries Index can hold.
+                                   On output, the number of entries of the whole index.
+
+  @retval RETURN_SUCCESS            The index is built.
+  @retval RETURN_BUFFER_TOO_SMALL   Index is too small. IndexCount is updated with the required number.
+  @retval RETURN_INVALID_PARAMETER  IndexCount is NULL, or Index is NULL while *IndexCount is not 0.
+  @retval RETURN_UNSUPPORTED        MicrocodePatchRegionSize exceeds MAX_UINT32.
+**/
+RETURN_STATUS
+EFIAPI
+BuildMicrocodePatchIndex (
+  IN     VOID                         *MicrocodePatchAddress,
+  IN     UINTN                        MicrocodePatchRegionSize,
+  OUT    MICROCODE_PATCH_INDEX_ENTRY  *Index OPTIONAL,
+  IN OUT UINTN                        *IndexCount
+  )
+{
+  UINTN                                IndexCapacity;
+  UINTN                                Offset;
+  UINTN                                ExtendedIndex;
+  UINT32                               DataSize;
+  UINT32                               TotalSize;
+  UINT32                               ExtendedTableLength;
+  CPU_MICROCODE_HEADER                 *Microcode;
+  CPU_MICROCODE_EXTENDED_TABLE_HEADER  *ExtendedTableHeader;
+  CPU_MICROCODE_EXTENDED_TABLE         *ExtendedTable;
+  MICROCODE_PATCH_INDEX_ENTRY          Entry;
+
+  if ((IndexCount == NULL) || ((Index == NULL) && (*IndexCount != 0))) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  if (MicrocodePatchRegionSize > MAX_UINT32) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  IndexCapacity = *IndexCount;
+  *IndexCount   = 0;
+
+  Offset = 0;
+  while (Offset < MicrocodePatchRegionSize) {
+    Microcode = (CPU_MICROCODE_HEADER *)((UINTN)MicrocodePatchAddress + Offset);
+    if (!IsValidMicrocode (Microcode, MicrocodePatchRegionSize - Offset, 0, NULL, 0, FALSE)) {
+      //
+      // Padding data between the microcode patches, skip 1KB to check next entry.
+      //
+      Offset += SIZE_1KB;
+      continue;
+    }
+
+    TotalSize = GetMicrocodeLength (Microcode);
+
+    Entry.ProcessorSignature = Microcode->ProcessorSignature.Uint32;
+    Entry.ProcessorFlags     = Microcode->ProcessorFlags;
+    Entry.UpdateRevision     = Microcode->UpdateRevision;
+    Entry.Offset             = (UINT32)Offset;
+    AddMicrocodePatchIndexEntry (Index, IndexCapacity, IndexCount, &Entry);
+
+    //
+    // Index the extended signatures when the extended table is well-formed.
+    //
+    DataSize = Microcode->DataSize;
+    if (DataSize == 0) {
+      DataSize = 2000;
+    }
+
+    ExtendedTableLength = TotalSize - (DataSize + sizeof (CPU_MICROCODE_HEADER));
+    if ((TotalSize > DataSize + sizeof (CPU_MICROCODE_HEADER)) &&
+        (ExtendedTableLength >= sizeof (CPU_MICROCODE_EXTENDED_TABLE_HEADER)) &&
+        ((ExtendedTableLength % 4) == 0))
+    {
+      ExtendedTableHeader = (CPU_MICROCODE_EXTENDED_TABLE_HEADER *)((UINTN)(Microcode + 1) + DataSize);
+      if ((ExtendedTableHeader->ExtendedSignatureCount <= MAX_UINT32 / sizeof (CPU_MICROCODE_EXTENDED_TABLE)) &&
+          (ExtendedTableHeader->ExtendedSignatureCount * sizeof (CPU_MICROCODE_EXTENDED_TABLE)
+           <= ExtendedTableLength - sizeof (CPU_MICROCODE_EXTENDED_TABLE_HEADER)))
+      {
+        ExtendedTable = (CPU_MICROCODE_EXTENDED_TABLE *)(ExtendedTableHeader + 1);
+        for (ExtendedIndex = 0; ExtendedIndex < ExtendedTableHeader->ExtendedSignatureCount; ExtendedIndex++) {
+          Entry.ProcessorSignature = ExtendedTable[ExtendedIndex].ProcessorSignature.Uint32;
+          Entry.ProcessorFlags     = ExtendedTable[ExtendedIndex].ProcessorFlag;
+          AddMicrocodePatchIndexEntry (Index, IndexCapacity, IndexCount, &Entry);
+        }
+      }
+    }
+
+    Offset += TotalSize;
+  }
+
+  if (*IndexCount > IndexCapacity) {
+    return RETURN_BUFFER_TOO_SMALL;
+  }
+
+  return RETURN_SUCCESS;
+}
+
+/**
+  Find the latest valid microcode patch for a processor with the microcode patch index.
+
+  The index entries of the processor signature are located by binary search,
+  and the candidates are verified by IsValidMicrocode() with checksum from the
+  newest revision to the oldest. An index that does not describe the patch
+  region, e.g. it is out of date, can therefore only cause a patch to be missed,
+  never an invalid patch to be returned. Caller can fall back to scanning the
+  patch region when NULL is returned.
+
+  @param MicrocodePatchAddress     Start address of the microcode patch region.
+  @param MicrocodePatchRegionSize  Size in bytes of the microcode patch region.
+  @param Index                     The index built by BuildMicrocodePatchIndex().
+  @param IndexCount                The number of entries in Index.
+  @param MicrocodeCpuId            The processor signature and platform ID of the processor.
+  @param MinimumRevision           The microcode whose revision <= MinimumRevision is skipped.
+
+  @return The latest valid microcode patch, or NULL if no valid patch is found.
+**/
+CPU_MICROCODE_HEADER *
+EFIAPI
+FindMicrocodeInIndex (
+  IN VOID                               *MicrocodePatchAddress,
+  IN UINTN                              MicrocodePatchRegionSize,
+  IN CONST MICROCODE_PATCH_INDEX_ENTRY  *Index,
+  IN UINTN                              IndexCount,
+  IN EDKII_PEI_MICROCODE_CPU_ID         *MicrocodeCpuId,
+  IN UINT32                             MinimumRevision
+  )
+{
+  UINTN                 Low;
+  UINTN                 High;
+  UINTN                 Middle;
+  CPU_MICROCODE_HEADER  *Microcode;
+
+  ASSERT (MicrocodeCpuId != NULL);
+  ASSERT (Index != NULL || IndexCount == 0);
+
+  //
+  // Find the first entry of the processor signature.
+  //
+  Low  = 0;
+  High = IndexCount;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (Index[Middle].ProcessorSignature < MicrocodeCpuId->ProcessorSignature) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  for ( ; (Low < IndexCount) && (Index[Low].ProcessorSignature == MicrocodeCpuId->ProcessorSignature); Low++) {
+    if (Index[Low].UpdateRevision <= MinimumRevision) {
+      //
+      // The rest entries of the processor signature are older.
+      //
+      break;
+    }
+
+    if (((Index[Low].ProcessorFlags & (1 << MicrocodeCpuId->PlatformId)) == 0) ||
+        (Index[Low].Offset >= MicrocodePatchRegionSize))
+    {
+      continue;
+    }
+
+    Microcode = (CPU_MICROCODE_HEADER *)((UINTN)MicrocodePatchAddress + Index[Low].Offset);
+    if (IsValidMicrocode (Microcode, MicrocodePatchRegionSize - Index[Low].Offset, MinimumRevision, MicrocodeCpuId, 1, TRUE)) {
+      return Microcode;
+    }
+  }
+
+  return NULL;
+}
@@ -0,0 +1,390 @@
+/** @file
+  Unit tests of the microcode patch index of the microcode library.
+
+  The tests build a patch region in memory with the layout below:
+    0x0000  Patch A: signature 0x906A0, revision 5
+    0x0400  Patch B: signature 0x806C0, revision 7, extended signature 0x906A0
+    0x0C00  Padding
+    0x1000  Patch C: signature 0x906A0, revision 9
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/MicrocodeLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "MicrocodeLib Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define PATCH_A_OFFSET     0x0000
+#define PATCH_B_OFFSET     0x0400
+#define PATCH_C_OFFSET     0x1000
+#define PATCH_REGION_SIZE  0x1400
+
+#define SIGNATURE_ATOM  0x906A0
+#define SIGNATURE_CORE  0x806C0
+
+/**
+  Create a microcode patch with valid checksums in the buffer.
+
+  The update data is filled with a pattern derived from the revision.
+
+  @param[out] Microcode           Buffer of the microcode patch. It should be zeroed.
+  @param[in]  ProcessorSignature  Processor signature of the primary header.
+  @param[in]  ProcessorFlags      Processor flags of the primary header.
+  @param[in]  UpdateRevision      Revision of the microcode patch.
+  @param[in]  ExtendedTable       Extended signatures. NULL if the patch has no extended table.
+  @param[in]  ExtendedCount       Number of the extended signatures.
+
+  @return The total size of the microcode patch.
+**/
+STATIC
+UINT32
+CreateMicrocodePatch (
+  OUT CPU_MICROCODE_HEADER          *Microcode,
+  IN  UINT32                        ProcessorSignature,
+  IN  UINT32                        ProcessorFlags,
+  IN  UINT32                        UpdateRevision,
+  IN  CPU_MICROCODE_EXTENDED_TABLE  *ExtendedTable OPTIONAL,
+  IN  UINT32                        ExtendedCount
+  )
+{
+  UINT32                               *Data;
+  UINTN                                Index;
+  UINT32                               Sum32;
+  UINT32                               ExtendedTableLength;
+  CPU_MICROCODE_EXTENDED_TABLE_HEADER  *ExtendedTableHeader;
+  CPU_MICROCODE_EXTENDED_TABLE         *ExtendedEntry;
+
+  Microcode->HeaderVersion             = 1;
+  Microcode->UpdateRevision            = UpdateRevision;
+  Microcode->ProcessorSignature.Uint32 = ProcessorSignature;
+  Microcode->LoaderRevision            = 1;
+  Microcode->ProcessorFlags            = ProcessorFlags;
+  Microcode->DataSize                  = SIZE_1KB - sizeof (CPU_MICROCODE_HEADER);
+  Microcode->TotalSize                 = (ExtendedTable == NULL) ? SIZE_1KB : SIZE_2KB;
+
+  Data = (UINT32 *)(Microcode + 1);
+  for (Index = 0; Index < Microcode->DataSize / sizeof (UINT32); Index++) {
+    Data[Index] = (UINT32)(UpdateRevision * 0x10001 + Index);
+  }
+
+  //
+  // The summation of the header and the update data should be zero.
+  //
+  Microcode->Checksum = 0;
+  Microcode->Checksum = (UINT32)(0 - CalculateSum32 ((UINT32 *)Microcode, SIZE_1KB));
+
+  if (ExtendedTable != NULL) {
+    Sum32               = ProcessorSignature + ProcessorFlags + Microcode->Checksum;
+    ExtendedTableLength = Microcode->TotalSize - SIZE_1KB;
+    ExtendedTableHeader = (CPU_MICROCODE_EXTENDED_TABLE_HEADER *)((UINTN)Microcode + SIZE_1KB);
+    ExtendedEntry       = (CPU_MICROCODE_EXTENDED_TABLE *)(ExtendedTableHeader + 1);
+
+    ExtendedTableHeader->ExtendedSignatureCount = ExtendedCount;
+    for (Index = 0; Index < ExtendedCount; Index++) {
+      ExtendedEntry[Index].ProcessorSignature.Uint32 = ExtendedTable[Index].ProcessorSignature.Uint32;
+      ExtendedEntry[Index].ProcessorFlag             = ExtendedTable[Index].ProcessorFlag;
+      ExtendedEntry[Index].Checksum                  = Sum32 - ExtendedTable[Index].ProcessorSignature.Uint32
+                                                       - ExtendedTable[Index].ProcessorFlag;
+    }
+
+    //
+    // The summation of the extended table should be zero.
+    //
+    ExtendedTableHeader->ExtendedChecksum = 0;
+    ExtendedTableHeader->ExtendedChecksum = (UINT32)(0 - CalculateSum32 ((UINT32 *)ExtendedTableHeader, ExtendedTableLength));
+  }
+
+  return Microcode->TotalSize;
+}
+
+/**
+  Create the patch region described in the file header.
+
+  @return The patch region, or NULL when out of resources.
+**/
+STATIC
+VOID *
+CreatePatchRegion (
+  VOID
+  )
+{
+  UINT8                         *Region;
+  CPU_MICROCODE_EXTENDED_TABLE  ExtendedTable;
+
+  Region = AllocateZeroPool (PATCH_REGION_SIZE);
+  if (Region == NULL) {
+    return NULL;
+  }
+
+  CreateMicrocodePatch ((CPU_MICROCODE_HEADER *)(Region + PATCH_A_OFFSET), SIGNATURE_ATOM, BIT0, 5, NULL, 0);
+
+  ExtendedTable.ProcessorSignature.Uint32 = SIGNATURE_ATOM;
+  ExtendedTable.ProcessorFlag             = BIT0;
+  CreateMicrocodePatch ((CPU_MICROCODE_HEADER *)(Region + PATCH_B_OFFSET), SIGNATURE_CORE, BIT1, 7, &ExtendedTable, 1);
+
+  CreateMicrocodePatch ((CPU_MICROCODE_HEADER *)(Region + PATCH_C_OFFSET), SIGNATURE_ATOM, BIT0, 9, NULL, 0);
+
+  return Region;
+}
+
+/**
+  Check the size query, the sort order and BUFFER_TOO_SMALL of BuildMicrocodePatchIndex().
+
+  @param[in]  Context    The test context.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnitTestBuildPatchIndex (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  VOID                         *Region;
+  MICROCODE_PATCH_INDEX_ENTRY  Index[4];
+  UINTN                        IndexCount;
+
+  Region = CreatePatchRegion ();
+  UT_ASSERT_NOT_NULL (Region);
+
+  IndexCount = 0;
+  UT_ASSERT_STATUS_EQUAL (BuildMicrocodePatchIndex (Region, PATCH_REGION_SIZE, NULL, &IndexCount), RETURN_BUFFER_TOO_SMALL);
+  UT_ASSERT_EQUAL (IndexCount, 4);
+
+  IndexCount = 2;
+  UT_ASSERT_STATUS_EQUAL (BuildMicrocodePatchIndex (Region, PATCH_REGION_SIZE, Index, &IndexCount), RETURN_BUFFER_TOO_SMALL);
+  UT_ASSERT_EQUAL (IndexCount, 4);
+
+  IndexCount = ARRAY_SIZE (Index);
+  UT_ASSERT_NOT_EFI_ERROR (BuildMicrocodePatchIndex (Region, PATCH_REGION_SIZE, Index, &IndexCount));
+  UT_ASSERT_EQUAL (IndexCount, 4);
+
+  //
+  // Sorted by signature, then from the newest revision to the oldest.
+  //
+  UT_ASSERT_EQUAL (Index[0].ProcessorSignature, SIGNATURE_CORE);
+  UT_ASSERT_EQUAL (Index[0].ProcessorFlags, BIT1);
+  UT_ASSERT_EQUAL (Index[0].UpdateRevision, 7);
+  UT_ASSERT_EQUAL (Index[0].Offset, PATCH_B_OFFSET);
+
+  UT_ASSERT_EQUAL (Index[1].ProcessorSignature, SIGNATURE_ATOM);
+  UT_ASSERT_EQUAL (Index[1].UpdateRevision, 9);
+  UT_ASSERT_EQUAL (Index[1].Offset, PATCH_C_OFFSET);
+
+  UT_ASSERT_EQUAL (Index[2].ProcessorSignature, SIGNATURE_ATOM);
+  UT_ASSERT_EQUAL (Index[2].ProcessorFlags, BIT0);
+  UT_ASSERT_EQUAL (Index[2].UpdateRevision, 7);
+  UT_ASSERT_EQUAL (Index[2].Offset, PATCH_B_OFFSET);
+
+  UT_ASSERT_EQUAL (Index[3].ProcessorSignature, SIGNATURE_ATOM);
+  UT_ASSERT_EQUAL (Index[3].UpdateRevision, 5);
+  UT_ASSERT_EQUAL (Index[3].Offset, PATCH_A_OFFSET);
+
+  UT_ASSERT_STATUS_EQUAL (BuildMicrocodePatchIndex (Region, PATCH_REGION_SIZE, NULL, NULL), RETURN_INVALID_PARAMETER);
+
+  FreePool (Region);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that FindMicrocodeInIndex() returns the latest valid patch of the processor,
+  including the patches matched by the extended signatures.
+
+  @param[in]  Context    The test context.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnitTestFindInPatchIndex (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8                        *Region;
+  MICROCODE_PATCH_INDEX_ENTRY  Index[4];
+  UINTN                        IndexCount;
+  EDKII_PEI_MICROCODE_CPU_ID   MicrocodeCpuId;
+  CPU_MICROCODE_HEADER         *Microcode;
+
+  Region = CreatePatchRegion ();
+  UT_ASSERT_NOT_NULL (Region);
+
+  IndexCount = ARRAY_SIZE (Index);
+  UT_ASSERT_NOT_EFI_ERROR (BuildMicrocodePatchIndex (Region, PATCH_REGION_SIZE, Index, &IndexCount));
+
+  MicrocodeCpuId.ProcessorSignature = SIGNATURE_ATOM;
+  MicrocodeCpuId.PlatformId         = 0;
+  Microcode                         = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, Index, IndexCount, &MicrocodeCpuId, 0);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)(Region + PATCH_C_OFFSET));
+
+  Microcode = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, Index, IndexCount, &MicrocodeCpuId, 8);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)(Region + PATCH_C_OFFSET));
+
+  Microcode = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, Index, IndexCount, &MicrocodeCpuId, 9);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)NULL);
+
+  MicrocodeCpuId.ProcessorSignature = SIGNATURE_CORE;
+  MicrocodeCpuId.PlatformId         = 1;
+  Microcode                         = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, Index, IndexCount, &MicrocodeCpuId, 0);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)(Region + PATCH_B_OFFSET));
+
+  //
+  // Platform ID or processor signature mismatches.
+  //
+  MicrocodeCpuId.PlatformId = 0;
+  Microcode                 = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, Index, IndexCount, &MicrocodeCpuId, 0);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)NULL);
+
+  MicrocodeCpuId.ProcessorSignature = 0x906A1;
+  Microcode                         = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, Index, IndexCount, &MicrocodeCpuId, 0);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)NULL);
+
+  Microcode = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, NULL, 0, &MicrocodeCpuId, 0);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)NULL);
+
+  FreePool (Region);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that FindMicrocodeInIndex() verifies the checksum of the patch, so that
+  a corrupted patch or an out-of-date index never returns an invalid patch.
+
+  @param[in]  Context    The test context.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnitTestFindVerifiesChecksum (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8                        *Region;
+  MICROCODE_PATCH_INDEX_ENTRY  Index[4];
+  UINTN                        IndexCount;
+  EDKII_PEI_MICROCODE_CPU_ID   MicrocodeCpuId;
+  CPU_MICROCODE_HEADER         *Microcode;
+
+  Region = CreatePatchRegion ();
+  UT_ASSERT_NOT_NULL (Region);
+
+  IndexCount = ARRAY_SIZE (Index);
+  UT_ASSERT_NOT_EFI_ERROR (BuildMicrocodePatchIndex (Region, PATCH_REGION_SIZE, Index, &IndexCount));
+
+  MicrocodeCpuId.ProcessorSignature = SIGNATURE_ATOM;
+  MicrocodeCpuId.PlatformId         = 0;
+
+  //
+  // Corrupt the update data of patch C. The older patch B is returned, which
+  // matches by its extended signature.
+  //
+  Region[PATCH_C_OFFSET + sizeof (CPU_MICROCODE_HEADER)] ^= 0x5A;
+  Microcode = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, Index, IndexCount, &MicrocodeCpuId, 0);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)(Region + PATCH_B_OFFSET));
+
+  //
+  // Corrupt the extended table of patch B. The oldest patch A is returned.
+  //
+  Region[PATCH_B_OFFSET + SIZE_1KB + sizeof (CPU_MICROCODE_EXTENDED_TABLE_HEADER) + sizeof (CPU_MICROCODE_EXTENDED_TABLE)] ^= 0x5A;
+  Microcode = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, Index, IndexCount, &MicrocodeCpuId, 0);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)(Region + PATCH_A_OFFSET));
+
+  //
+  // Patch A is replaced by padding after the index is built.
+  //
+  ZeroMem (Region + PATCH_A_OFFSET, SIZE_1KB);
+  Microcode = FindMicrocodeInIndex (Region, PATCH_REGION_SIZE, Index, IndexCount, &MicrocodeCpuId, 0);
+  UT_ASSERT_EQUAL ((UINTN)Microcode, (UINTN)NULL);
+
+  FreePool (Region);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the
+  microcode patch index and run the unit tests.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      PatchIndexTests;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&PatchIndexTests, Framework, "MicrocodeLib Patch Index Tests", "MicrocodeLib.PatchIndex", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for MicrocodeLib Patch Index Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (PatchIndexTests, "Test BuildMicrocodePatchIndex", "BuildPatchIndex", UnitTestBuildPatchIndex, NULL, NULL, NULL);
+  AddTestCase (PatchIndexTests, "Test FindMicrocodeInIndex", "FindInPatchIndex", UnitTestFindInPatchIndex, NULL, NULL, NULL);
+  AddTestCase (PatchIndexTests, "Test FindMicrocodeInIndex verifies checksum", "FindVerifiesChecksum", UnitTestFindVerifiesChecksum, NULL, NULL, NULL);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param Argc  Number of arguments.
+  @param Argv  Array of arguments.
+
+  @return Test application exit code.
+**/
+INT32
+main (
+  INT32  Argc,
+  CHAR8  *Argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
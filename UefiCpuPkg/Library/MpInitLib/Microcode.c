@@ -8,6 +8,222 @@
 
 #include "MpLib.h"
 
+/**
+  Find the latest microcode patch matching the processor in the patch region.
+
+  @param[in]  CpuMpData        The pointer to CPU MP Data structure.
+  @param[in]  MicrocodeCpuId   The processor signature and platform ID to match.
+
+  @return The latest matching microcode patch, or NULL if none matches.
+**/
+STATIC
+CPU_MICROCODE_HEADER *
+FindLatestMicrocode (
+  IN CPU_MP_DATA                 *CpuMpData,
+  IN EDKII_PEI_MICROCODE_CPU_ID  *MicrocodeCpuId
+  )
+{
+  CPU_MICROCODE_HEADER  *Microcode;
+  UINTN                 MicrocodeEnd;
+  UINT32                LatestRevision;
+  CPU_MICROCODE_HEADER  *LatestMicrocode;
+
+  //
+  // Use 0 as the starting revision to search for microcode because MicrocodePatchInfo HOB needs
+  // the latest microcode location even it's loaded to the processor.
+  //
+  LatestRevision  = 0;
+  LatestMicrocode = NULL;
+  Microcode       = (CPU_MICROCODE_HEADER *)(UINTN)CpuMpData->MicrocodePatchAddress;
+  MicrocodeEnd    = (UINTN)Microcode + (UINTN)CpuMpData->MicrocodePatchRegionSize;
+
+  do {
+    if (!IsValidMicrocode (Microcode, MicrocodeEnd - (UINTN)Microcode, LatestRevision, MicrocodeCpuId, 1, TRUE)) {
+      //
+      // It is the padding data between the microcode patches for microcode patches alignment.
+      // Because the microcode patch is the multiple of 1-KByte, the padding data should not
+      // exist if the microcode patch alignment value is not larger than 1-KByte. So, the microcode
+      // alignment value should be larger than 1-KByte. We could skip SIZE_1KB padding data to
+      // find the next possible microcode patch header.
+      //
+      Microcode = (CPU_MICROCODE_HEADER *)((UINTN)Microcode + SIZE_1KB);
+      continue;
+    }
+
+    LatestMicrocode = Microcode;
+    LatestRevision  = LatestMicrocode->UpdateRevision;
+
+    Microcode = (CPU_MICROCODE_HEADER *)(((UINTN)Microcode) + GetMicrocodeLength (Microcode));
+  } while ((UINTN)Microcode < MicrocodeEnd);
+
+  return LatestMicrocode;
+}
+
+/**
+  Look up the microcode patch index built by the BSP.
+
+  @param[in]  CpuMpData        The pointer to CPU MP Data structure.
+  @param[in]  MicrocodeCpuId   The processor signature and platform ID to look up.
+
+  @return The index entry of the processor, or NULL if it is not indexed.
+**/
+STATIC
+MICROCODE_INDEX_ENTRY *
+LookupMicrocodeIndex (
+  IN CPU_MP_DATA                 *CpuMpData,
+  IN EDKII_PEI_MICROCODE_CPU_ID  *MicrocodeCpuId
+  )
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < CpuMpData->MicrocodeIndexCount; Index++) {
+    if ((CpuMpData->MicrocodeIndex[Index].ProcessorSignature == MicrocodeCpuId->ProcessorSignature) &&
+        (CpuMpData->MicrocodeIndex[Index].PlatformId == MicrocodeCpuId->PlatformId))
+    {
+      return &CpuMpData->MicrocodeIndex[Index];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+  Build the microcode patch index for all processors found.
+
+  The patch headers in the region are indexed once, then the latest patch of
+  each distinct processor signature and platform ID is looked up in the patch
+  index, instead of scanning the region by every core that differs from the BSP.
+  When the patch index cannot be built, the region is scanned once for each
+  distinct processor type.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+BuildMicrocodeIndex (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  )
+{
+  UINTN                        Index;
+  EDKII_PEI_MICROCODE_CPU_ID   MicrocodeCpuId;
+  MICROCODE_INDEX_ENTRY        *Entry;
+  MICROCODE_PATCH_INDEX_ENTRY  *PatchIndex;
+  UINTN                        PatchIndexCount;
+  RETURN_STATUS                Status;
+
+  if ((CpuMpData->MicrocodePatchRegionSize == 0) || (CpuMpData->MicrocodeIndex != NULL)) {
+    return;
+  }
+
+  CpuMpData->MicrocodeIndex = AllocatePages (
+                                EFI_SIZE_TO_PAGES (CpuMpData->CpuCount * sizeof (MICROCODE_INDEX_ENTRY))
+                                );
+  if (CpuMpData->MicrocodeIndex == NULL) {
+    //
+    // Each processor scans the patch region by itself.
+    //
+    return;
+  }
+
+  //
+  // Get the number of the patch index entries first, then build the index.
+  //
+  PatchIndex      = NULL;
+  PatchIndexCount = 0;
+  Status          = BuildMicrocodePatchIndex (
+                      (VOID *)(UINTN)CpuMpData->MicrocodePatchAddress,
+                      (UINTN)CpuMpData->MicrocodePatchRegionSize,
+                      NULL,
+                      &PatchIndexCount
+                      );
+  if (Status == RETURN_BUFFER_TOO_SMALL) {
+    PatchIndex = AllocatePool (PatchIndexCount * sizeof (MICROCODE_PATCH_INDEX_ENTRY));
+    if (PatchIndex != NULL) {
+      Status = BuildMicrocodePatchIndex (
+                 (VOID *)(UINTN)CpuMpData->MicrocodePatchAddress,
+                 (UINTN)CpuMpData->MicrocodePatchRegionSize,
+                 PatchIndex,
+                 &PatchIndexCount
+                 );
+      if (RETURN_ERROR (Status)) {
+        FreePool (PatchIndex);
+        PatchIndex = NULL;
+      }
+    }
+  }
+
+  CpuMpData->MicrocodeIndexCount = 0;
+  for (Index = 0; Index < CpuMpData->CpuCount; Index++) {
+    //
+    // Skip processors whose identity was not collected, e.g. when the APs
+    // were handed off from the previous phase.
+    //
+    if (CpuMpData->CpuData[Index].ProcessorSignature == 0) {
+      continue;
+    }
+
+    MicrocodeCpuId.ProcessorSignature = CpuMpData->CpuData[Index].ProcessorSignature;
+    MicrocodeCpuId.PlatformId         = CpuMpData->CpuData[Index].PlatformId;
+    if (LookupMicrocodeIndex (CpuMpData, &MicrocodeCpuId) != NULL) {
+      continue;
+    }
+
+    Entry                     = &CpuMpData->MicrocodeIndex[CpuMpData->MicrocodeIndexCount];
+    Entry->ProcessorSignature = MicrocodeCpuId.ProcessorSignature;
+    Entry->PlatformId         = MicrocodeCpuId.PlatformId;
+    if (PatchIndex != NULL) {
+      //
+      // Use 0 as the minimum revision because MicrocodePatchInfo HOB needs
+      // the latest microcode location even it's loaded to the processor.
+      //
+      Entry->MicrocodeEntryAddr = (UINTN)FindMicrocodeInIndex (
+                                           (VOID *)(UINTN)CpuMpData->MicrocodePatchAddress,
+                                           (UINTN)CpuMpData->MicrocodePatchRegionSize,
+                                           PatchIndex,
+                                           PatchIndexCount,
+                                           &MicrocodeCpuId,
+                                           0
+                                           );
+    } else {
+      Entry->MicrocodeEntryAddr = (UINTN)FindLatestMicrocode (CpuMpData, &MicrocodeCpuId);
+    }
+
+    CpuMpData->MicrocodeIndexCount++;
+  }
+
+  if (PatchIndex != NULL) {
+    FreePool (PatchIndex);
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "%a: 0x%x distinct processor type(s) indexed.\n",
+    __func__,
+    CpuMpData->MicrocodeIndexCount
+    ));
+}
+
+/**
+  Free the microcode patch index.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+FreeMicrocodeIndex (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  )
+{
+  if (CpuMpData->MicrocodeIndex == NULL) {
+    return;
+  }
+
+  FreePages (
+    CpuMpData->MicrocodeIndex,
+    EFI_SIZE_TO_PAGES (CpuMpData->CpuCount * sizeof (MICROCODE_INDEX_ENTRY))
+    );
+  CpuMpData->MicrocodeIndex      = NULL;
+  CpuMpData->MicrocodeIndexCount = 0;
+}
+
 /**
   Detect whether specified processor can find matching microcode patch and load it.
 
@@ -22,13 +238,12 @@ MicrocodeDetect (
   IN UINTN        ProcessorNumber
   )
 {
-  CPU_MICROCODE_HEADER        *Microcode;
-  UINTN                       MicrocodeEnd;
   CPU_AP_DATA                 *BspData;
   UINT32                      LatestRevision;
   CPU_MICROCODE_HEADER        *LatestMicrocode;
   UINT32                      ThreadId;
   EDKII_PEI_MICROCODE_CPU_ID  MicrocodeCpuId;
+  MICROCODE_INDEX_ENTRY       *IndexEntry;
 
   if (CpuMpData->MicrocodePatchRegionSize == 0) {
     //
@@ -64,33 +279,18 @@ MicrocodeDetect (
   }
 
   //
-  // BSP or AP which is different from BSP runs here
-  // Use 0 as the starting revision to search for microcode because MicrocodePatchInfo HOB needs
-  // the latest microcode location even it's loaded to the processor.
+  // BSP or AP which is different from BSP runs here.
+  // Use the index built by BSP when this processor type is in it, otherwise
+  // scan the patch region.
   //
-  LatestRevision  = 0;
-  LatestMicrocode = NULL;
-  Microcode       = (CPU_MICROCODE_HEADER *)(UINTN)CpuMpData->MicrocodePatchAddress;
-  MicrocodeEnd    = (UINTN)Microcode + (UINTN)CpuMpData->MicrocodePatchRegionSize;
-
-  do {
-    if (!IsValidMicrocode (Microcode, MicrocodeEnd - (UINTN)Microcode, LatestRevision, &MicrocodeCpuId, 1, TRUE)) {
-      //
-      // It is the padding data between the microcode patches for microcode patches alignment.
-      // Because the microcode patch is the multiple of 1-KByte, the padding data should not
-      // exist if the microcode patch alignment value is not larger than 1-KByte. So, the microcode
-      // alignment value should be larger than 1-KByte. We could skip SIZE_1KB padding data to
-      // find the next possible microcode patch header.
-      //
-      Microcode = (CPU_MICROCODE_HEADER *)((UINTN)Microcode + SIZE_1KB);
-      continue;
-    }
-
-    LatestMicrocode = Microcode;
-    LatestRevision  = LatestMicrocode->UpdateRevision;
+  IndexEntry = LookupMicrocodeIndex (CpuMpData, &MicrocodeCpuId);
+  if (IndexEntry != NULL) {
+    LatestMicrocode = (CPU_MICROCODE_HEADER *)IndexEntry->MicrocodeEntryAddr;
+  } else {
+    LatestMicrocode = FindLatestMicrocode (CpuMpData, &MicrocodeCpuId);
+  }
 
-    Microcode = (CPU_MICROCODE_HEADER *)(((UINTN)Microcode) + GetMicrocodeLength (Microcode));
-  } while ((UINTN)Microcode < MicrocodeEnd);
+  LatestRevision = (LatestMicrocode != NULL) ? LatestMicrocode->UpdateRevision : 0;
 
 LoadMicrocode:
   if (LatestRevision != 0) {
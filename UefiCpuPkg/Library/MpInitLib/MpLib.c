@@ -2089,6 +2089,7 @@ MpInitLibInitialize (
   UINTN                    BackupBufferAddr;
   UINTN                    ApIdtBase;
   IA32_CR0                 Cr0;
+  UINT64                   StartTime;
 
   FirstMpHandOff = GetNextMpHandOffHob (NULL);
   if (FirstMpHandOff != NULL) {
@@ -2299,6 +2300,7 @@ MpInitLibInitialize (
       //
       // Wakeup all APs and calculate the processor count in system
       //
+      StartTime = GetPerformanceCounter ();
       CollectProcessorCount (CpuMpData);
 
       //
@@ -2313,7 +2315,12 @@ MpInitLibInitialize (
       //
       SortApicId (CpuMpData);
 
-      DEBUG ((DEBUG_INFO, "MpInitLib: Find %d processors in system.\n", CpuMpData->CpuCount));
+      DEBUG ((
+        DEBUG_INFO,
+        "MpInitLib: Find %d processors in system in %Lu microseconds.\n",
+        CpuMpData->CpuCount,
+        DivU64x32 (GetTimeInNanoSecond (GetPerformanceCounter () - StartTime), 1000)
+        ));
     }
   } else {
     //
@@ -2417,6 +2424,12 @@ MpInitLibInitialize (
     ShadowMicrocodeUpdatePatch (CpuMpData);
   }
 
+  //
+  // Index the microcode patches of all processor types found, so that APs
+  // look up their patch instead of scanning the patch region.
+  //
+  BuildMicrocodeIndex (CpuMpData);
+
   //
   // Detect and apply Microcode on BSP
   //
@@ -2430,6 +2443,7 @@ MpInitLibInitialize (
   // Wakeup APs to do some AP initialize sync (Microcode & MTRR)
   //
   if (CpuMpData->CpuCount > 1) {
+    StartTime = GetPerformanceCounter ();
     WakeUpAP (CpuMpData, TRUE, 0, ApInitializeSync, CpuMpData, TRUE);
     //
     // Wait for all APs finished initialization
@@ -2441,8 +2455,16 @@ MpInitLibInitialize (
     for (Index = 0; Index < CpuMpData->CpuCount; Index++) {
       SetApState (&CpuMpData->CpuData[Index], CpuStateIdle);
     }
+
+    DEBUG ((
+      DEBUG_INFO,
+      "MpInitLib: AP microcode and MTRR sync took %Lu microseconds.\n",
+      DivU64x32 (GetTimeInNanoSecond (GetPerformanceCounter () - StartTime), 1000)
+      ));
   }
 
+  FreeMicrocodeIndex (CpuMpData);
+
   //
   // Dump the microcode revision for each core.
   //
@@ -80,6 +80,16 @@ typedef struct {
   UINTN    Size;
 } MICROCODE_PATCH_INFO;
 
+//
+// Entry of the microcode patch index the BSP builds before waking up APs.
+// MicrocodeEntryAddr is 0 if no patch matches the processor.
+//
+typedef struct {
+  UINT32    ProcessorSignature;
+  UINT8     PlatformId;
+  UINTN     MicrocodeEntryAddr;
+} MICROCODE_INDEX_ENTRY;
+
 //
 // CPU volatile registers around INIT-SIPI-SIPI
 //
@@ -314,6 +324,12 @@ struct _CPU_MP_DATA {
   BOOLEAN                          TimerInterruptState;
   UINT64                           MicrocodePatchAddress;
   UINT64                           MicrocodePatchRegionSize;
+  //
+  // Microcode patch index with one entry per distinct processor signature
+  // and platform ID, so that APs do not scan the patch region.
+  //
+  MICROCODE_INDEX_ENTRY            *MicrocodeIndex;
+  UINTN                            MicrocodeIndexCount;
 
   //
   // Whether need to use Init-Sipi-Sipi to wake up the APs.
@@ -781,6 +797,29 @@ ShadowMicrocodeUpdatePatch (
   IN OUT CPU_MP_DATA  *CpuMpData
   );
 
+/**
+  Build the microcode patch index for all processors found.
+
+  The patch region is scanned once for each distinct processor signature
+  and platform ID, instead of once by every core that differs from the BSP.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+BuildMicrocodeIndex (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  );
+
+/**
+  Free the microcode patch index.
+
+  @param[in, out]  CpuMpData    The pointer to CPU MP Data structure.
+**/
+VOID
+FreeMicrocodeIndex (
+  IN OUT CPU_MP_DATA  *CpuMpData
+  );
+
 /**
   Get the cached microcode patch base address and size from the microcode patch
   information cache HOB.
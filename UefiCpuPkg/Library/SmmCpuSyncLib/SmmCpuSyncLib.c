@@ -27,18 +27,7 @@
   SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
-#include <Library/BaseLib.h>
-#include <Library/DebugLib.h>
-#include <Library/MemoryAllocationLib.h>
-#include <Library/SafeIntLib.h>
-#include <Library/SmmCpuSyncLib.h>
-#include <Library/SynchronizationLib.h>
-#include <Uefi.h>
-
-///
-/// The implementation shall place one semaphore on exclusive cache line for good performance.
-///
-typedef volatile UINT32 SMM_CPU_SYNC_SEMAPHORE;
+#include "InternalSmmCpuSyncLib.h"
 
 typedef struct {
   ///
@@ -78,116 +67,6 @@ struct SMM_CPU_SYNC_CONTEXT  {
   SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_CPU    CpuSem[];
 };
 
-/**
-  Performs an atomic compare exchange operation to get semaphore.
-  The compare exchange operation must be performed using MP safe
-  mechanisms.
-
-  @param[in,out]  Sem    IN:  32-bit unsigned integer
-                         OUT: original integer - 1 if Sem is not locked.
-                         OUT: MAX_UINT32 if Sem is locked.
-
-  @retval     Original integer - 1 if Sem is not locked.
-              MAX_UINT32 if Sem is locked.
-
-**/
-STATIC
-UINT32
-InternalWaitForSemaphore (
-  IN OUT  volatile UINT32  *Sem
-  )
-{
-  UINT32  Value;
-
-  for ( ; ;) {
-    Value = *Sem;
-    if (Value == MAX_UINT32) {
-      return Value;
-    }
-
-    if ((Value != 0) &&
-        (InterlockedCompareExchange32 (
-           (UINT32 *)Sem,
-           Value,
-           Value - 1
-           ) == Value))
-    {
-      break;
-    }
-
-    CpuPause ();
-  }
-
-  return Value - 1;
-}
-
-/**
-  Performs an atomic compare exchange operation to release semaphore.
-  The compare exchange operation must be performed using MP safe
-  mechanisms.
-
-  @param[in,out]  Sem    IN:  32-bit unsigned integer
-                         OUT: original integer + 1 if Sem is not locked.
-                         OUT: MAX_UINT32 if Sem is locked.
-
-  @retval    Original integer + 1 if Sem is not locked.
-             MAX_UINT32 if Sem is locked.
-
-**/
-STATIC
-UINT32
-InternalReleaseSemaphore (
-  IN OUT  volatile UINT32  *Sem
-  )
-{
-  UINT32  Value;
-
-  do {
-    Value = *Sem;
-  } while (Value + 1 != 0 &&
-           InterlockedCompareExchange32 (
-             (UINT32 *)Sem,
-             Value,
-             Value + 1
-             ) != Value);
-
-  if (Value == MAX_UINT32) {
-    return Value;
-  }
-
-  return Value + 1;
-}
-
-/**
-  Performs an atomic compare exchange operation to lock semaphore.
-  The compare exchange operation must be performed using MP safe
-  mechanisms.
-
-  @param[in,out]  Sem    IN:  32-bit unsigned integer
-                         OUT: -1
-
-  @retval    Original integer
-
-**/
-STATIC
-UINT32
-InternalLockdownSemaphore (
-  IN OUT  volatile UINT32  *Sem
-  )
-{
-  UINT32  Value;
-
-  do {
-    Value = *Sem;
-  } while (InterlockedCompareExchange32 (
-             (UINT32 *)Sem,
-             Value,
-             (UINT32)-1
-             ) != Value);
-
-  return Value;
-}
-
 /**
   Create and initialize the SMM CPU Sync context. It is to allocate and initialize the
   SMM CPU Sync context.
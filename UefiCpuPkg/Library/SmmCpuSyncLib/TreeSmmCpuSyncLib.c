@@ -0,0 +1,695 @@
+/** @file
+  SMM CPU Sync lib implementation with per-package arrival counters.
+
+  The base instance counts checked-in CPUs and AP releases of the BSP on one
+  semaphore each, so all CPUs in the system contend for the same two cache
+  lines on every SMI. This instance forms a two-level tree instead: each CPU
+  checks in to, checks out of and releases the BSP through the counters of
+  its own group, and only the BSP combines the group counters. CPUs of one
+  processor package share a group, so the contended cache lines stay within
+  a package.
+
+  The grouping only affects performance. All counts seen by callers are the
+  same as in the base instance.
+
+  Copyright (c) 2023, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#include "InternalSmmCpuSyncLib.h"
+#include <Library/LocalApicLib.h>
+#include <Register/Intel/Cpuid.h>
+
+///
+/// Group index of a CPU that has not checked in yet.
+///
+#define SMM_CPU_SYNC_NO_GROUP  MAX_UINT32
+
+typedef struct {
+  ///
+  /// Used for control each CPU continue run or wait for signal
+  ///
+  SMM_CPU_SYNC_SEMAPHORE    *Run;
+  ///
+  /// The group the CPU checks in to. Set by the CPU itself on its first check-in.
+  ///
+  UINT32                    Group;
+} SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_CPU;
+
+typedef struct {
+  ///
+  /// Before the door is locked, CpuCount stores the arrived CPU count of the group.
+  /// After the door is locked, CpuCount is set to -1 indicating the door is locked.
+  /// ArrivedCpuCountUponLock stores the arrived CPU count of the group then.
+  ///
+  SMM_CPU_SYNC_SEMAPHORE    *CpuCount;
+  UINTN                     ArrivedCpuCountUponLock;
+  ///
+  /// Number of releases of the BSP by the APs of the group.
+  ///
+  SMM_CPU_SYNC_SEMAPHORE    *BspRun;
+} SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_GROUP;
+
+struct SMM_CPU_SYNC_CONTEXT  {
+  ///
+  /// Indicate all CPUs in the system.
+  ///
+  UINTN                                    NumberOfCpus;
+  ///
+  /// Number of CPU groups.
+  ///
+  UINTN                                    NumberOfGroups;
+  ///
+  /// Address of semaphores.
+  ///
+  VOID                                     *SemBuffer;
+  ///
+  /// Size of semaphores.
+  ///
+  UINTN                                    SemBufferPages;
+  ///
+  /// Semaphores of each group, allocated after CpuSem[].
+  ///
+  SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_GROUP    *GroupSem;
+  ///
+  /// Semaphores of each CPU.
+  ///
+  SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_CPU      CpuSem[];
+};
+
+/**
+  Get the number of logical processors in the package of the calling processor.
+
+  @return The number of logical processors per package, at least 1.
+
+**/
+STATIC
+UINTN
+InternalGetThreadsPerPackage (
+  VOID
+  )
+{
+  UINT32                       MaxLeaf;
+  CPUID_VERSION_INFO_EBX       VersionInfoEbx;
+  CPUID_EXTENDED_TOPOLOGY_EBX  TopologyEbx;
+  CPUID_EXTENDED_TOPOLOGY_ECX  TopologyEcx;
+  UINT32                       SubLeaf;
+  UINTN                        ThreadsPerPackage;
+
+  AsmCpuid (CPUID_SIGNATURE, &MaxLeaf, NULL, NULL, NULL);
+
+  ThreadsPerPackage = 0;
+  if (MaxLeaf >= CPUID_EXTENDED_TOPOLOGY) {
+    //
+    // The last level reported before the invalid level covers the package.
+    //
+    for (SubLeaf = 0; ; SubLeaf++) {
+      AsmCpuidEx (CPUID_EXTENDED_TOPOLOGY, SubLeaf, NULL, &TopologyEbx.Uint32, &TopologyEcx.Uint32, NULL);
+      if (TopologyEcx.Bits.LevelType == CPUID_EXTENDED_TOPOLOGY_LEVEL_TYPE_INVALID) {
+        break;
+      }
+
+      ThreadsPerPackage = TopologyEbx.Bits.LogicalProcessors;
+    }
+  }
+
+  if (ThreadsPerPackage == 0) {
+    AsmCpuid (CPUID_VERSION_INFO, NULL, &VersionInfoEbx.Uint32, NULL, NULL);
+    ThreadsPerPackage = VersionInfoEbx.Bits.MaximumAddressableIdsForLogicalProcessors;
+  }
+
+  return MAX (ThreadsPerPackage, 1);
+}
+
+/**
+  Get the group of a CPU, assigning it from the package of the calling CPU
+  the first time the CPU uses the context.
+
+  @param[in,out]  Context     Pointer to the SMM CPU Sync context object.
+  @param[in]      CpuIndex    The index of the calling CPU.
+
+  @return The group index of the CPU.
+
+**/
+STATIC
+UINTN
+InternalGetCpuGroup (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context,
+  IN     UINTN                 CpuIndex
+  )
+{
+  UINT32  Package;
+
+  if (Context->CpuSem[CpuIndex].Group == SMM_CPU_SYNC_NO_GROUP) {
+    GetProcessorLocationByApicId (GetInitialApicId (), &Package, NULL, NULL);
+    Context->CpuSem[CpuIndex].Group = (UINT32)(Package % Context->NumberOfGroups);
+  }
+
+  return Context->CpuSem[CpuIndex].Group;
+}
+
+/**
+  Create and initialize the SMM CPU Sync context. It is to allocate and initialize the
+  SMM CPU Sync context.
+
+  If Context is NULL, then ASSERT().
+
+  @param[in]  NumberOfCpus          The number of Logical Processors in the system.
+  @param[out] Context               Pointer to the new created and initialized SMM CPU Sync context object.
+                                    NULL will be returned if any error happen during init.
+
+  @retval RETURN_SUCCESS            The SMM CPU Sync context was successful created and initialized.
+  @retval RETURN_OUT_OF_RESOURCES   There are not enough resources available to create and initialize SMM CPU Sync context.
+  @retval RETURN_BUFFER_TOO_SMALL   Overflow happen
+
+**/
+RETURN_STATUS
+EFIAPI
+SmmCpuSyncContextInit (
+  IN   UINTN                 NumberOfCpus,
+  OUT  SMM_CPU_SYNC_CONTEXT  **Context
+  )
+{
+  RETURN_STATUS                          Status;
+  UINTN                                  ThreadsPerPackage;
+  UINTN                                  NumberOfGroups;
+  UINTN                                  ContextSize;
+  UINTN                                  GroupSemSize;
+  UINTN                                  OneSemSize;
+  UINTN                                  NumSem;
+  UINTN                                  TotalSemSize;
+  UINTN                                  SemAddr;
+  UINTN                                  CpuIndex;
+  UINTN                                  GroupIndex;
+  SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_CPU    *CpuSem;
+  SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_GROUP  *GroupSem;
+
+  ASSERT (Context != NULL);
+
+  //
+  // One group per package, assuming all packages have as many threads as
+  // the package of the BSP.
+  //
+  ThreadsPerPackage = InternalGetThreadsPerPackage ();
+  NumberOfGroups    = (NumberOfCpus + ThreadsPerPackage - 1) / ThreadsPerPackage;
+  NumberOfGroups    = MAX (NumberOfGroups, 1);
+
+  //
+  // Calculate ContextSize
+  //
+  Status = SafeUintnMult (NumberOfCpus, sizeof (SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_CPU), &ContextSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = SafeUintnAdd (ContextSize, sizeof (SMM_CPU_SYNC_CONTEXT), &ContextSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = SafeUintnMult (NumberOfGroups, sizeof (SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_GROUP), &GroupSemSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = SafeUintnAdd (ContextSize, GroupSemSize, &ContextSize);
+  if (RETURN_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Allocate Buffer for Context
+  //
+  *Context = AllocatePool (ContextSize);
+  if (*Context == NULL) {
+    return RETURN_OUT_OF_RESOURCES;
+  }
+
+  (*Context)->NumberOfCpus   = NumberOfCpus;
+  (*Context)->NumberOfGroups = NumberOfGroups;
+  (*Context)->GroupSem       = (SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_GROUP *)&(*Context)->CpuSem[NumberOfCpus];
+
+  //
+  // Calculate total semaphore size: two for each group and one for each CPU.
+  //
+  OneSemSize = GetSpinLockProperties ();
+  ASSERT (sizeof (SMM_CPU_SYNC_SEMAPHORE) <= OneSemSize);
+
+  Status = SafeUintnMult (2, NumberOfGroups, &NumSem);
+  if (RETURN_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = SafeUintnAdd (NumSem, NumberOfCpus, &NumSem);
+  if (RETURN_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  Status = SafeUintnMult (NumSem, OneSemSize, &TotalSemSize);
+  if (RETURN_ERROR (Status)) {
+    goto ON_ERROR;
+  }
+
+  //
+  // Allocate for Semaphores in the *Context
+  //
+  (*Context)->SemBufferPages = EFI_SIZE_TO_PAGES (TotalSemSize);
+  (*Context)->SemBuffer      = AllocatePages ((*Context)->SemBufferPages);
+  if ((*Context)->SemBuffer == NULL) {
+    Status = RETURN_OUT_OF_RESOURCES;
+    goto ON_ERROR;
+  }
+
+  SemAddr = (UINTN)(*Context)->SemBuffer;
+
+  //
+  // Assign Group Semaphore pointer
+  //
+  GroupSem = (*Context)->GroupSem;
+  for (GroupIndex = 0; GroupIndex < NumberOfGroups; GroupIndex++) {
+    GroupSem->ArrivedCpuCountUponLock = 0;
+    GroupSem->CpuCount                = (SMM_CPU_SYNC_SEMAPHORE *)SemAddr;
+    *GroupSem->CpuCount               = 0;
+    SemAddr                          += OneSemSize;
+    GroupSem->BspRun                  = (SMM_CPU_SYNC_SEMAPHORE *)SemAddr;
+    *GroupSem->BspRun                 = 0;
+    SemAddr                          += OneSemSize;
+
+    GroupSem++;
+  }
+
+  //
+  // Assign CPU Semaphore pointer
+  //
+  CpuSem = (*Context)->CpuSem;
+  for (CpuIndex = 0; CpuIndex < NumberOfCpus; CpuIndex++) {
+    CpuSem->Run   = (SMM_CPU_SYNC_SEMAPHORE *)SemAddr;
+    *CpuSem->Run  = 0;
+    CpuSem->Group = SMM_CPU_SYNC_NO_GROUP;
+
+    CpuSem++;
+    SemAddr += OneSemSize;
+  }
+
+  DEBUG ((DEBUG_INFO, "%a: %d CPUs in %d groups\n", __func__, NumberOfCpus, NumberOfGroups));
+
+  return RETURN_SUCCESS;
+
+ON_ERROR:
+  FreePool (*Context);
+  return Status;
+}
+
+/**
+  Deinit an allocated SMM CPU Sync context. The resources allocated in SmmCpuSyncContextInit() will
+  be freed.
+
+  If Context is NULL, then ASSERT().
+
+  @param[in,out]  Context     Pointer to the SMM CPU Sync context object to be deinitialized.
+
+**/
+VOID
+EFIAPI
+SmmCpuSyncContextDeinit (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context
+  )
+{
+  ASSERT (Context != NULL);
+
+  FreePages (Context->SemBuffer, Context->SemBufferPages);
+
+  FreePool (Context);
+}
+
+/**
+  Reset SMM CPU Sync context. SMM CPU Sync context will be reset to the initialized state.
+
+  This function is called by one of CPUs after all CPUs are ready to exit SMI, which allows CPU to
+  check into the next SMI from this point.
+
+  If Context is NULL, then ASSERT().
+
+  @param[in,out]  Context     Pointer to the SMM CPU Sync context object to be reset.
+
+**/
+VOID
+EFIAPI
+SmmCpuSyncContextReset (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context
+  )
+{
+  UINTN  GroupIndex;
+
+  ASSERT (Context != NULL);
+
+  for (GroupIndex = 0; GroupIndex < Context->NumberOfGroups; GroupIndex++) {
+    Context->GroupSem[GroupIndex].ArrivedCpuCountUponLock = 0;
+    *Context->GroupSem[GroupIndex].CpuCount               = 0;
+  }
+}
+
+/**
+  Get current number of arrived CPU in SMI.
+
+  BSP might need to know the current number of arrived CPU in SMI to make sure all APs
+  in SMI. This API can be for that purpose.
+
+  If Context is NULL, then ASSERT().
+
+  @param[in]      Context     Pointer to the SMM CPU Sync context object.
+
+  @retval    Current number of arrived CPU in SMI.
+
+**/
+UINTN
+EFIAPI
+SmmCpuSyncGetArrivedCpuCount (
+  IN  SMM_CPU_SYNC_CONTEXT  *Context
+  )
+{
+  UINTN   GroupIndex;
+  UINTN   Arrived;
+  UINT32  Value;
+
+  ASSERT (Context != NULL);
+
+  Arrived = 0;
+  for (GroupIndex = 0; GroupIndex < Context->NumberOfGroups; GroupIndex++) {
+    Value = *Context->GroupSem[GroupIndex].CpuCount;
+    if (Value == (UINT32)-1) {
+      Arrived += Context->GroupSem[GroupIndex].ArrivedCpuCountUponLock;
+    } else {
+      Arrived += Value;
+    }
+  }
+
+  return Arrived;
+}
+
+/**
+  Performs an atomic operation to check in CPU.
+
+  When SMI happens, all processors including BSP enter to SMM mode by calling SmmCpuSyncCheckInCpu().
+
+  If Context is NULL, then ASSERT().
+  If CpuIndex exceeds the range of all CPUs in the system, then ASSERT().
+
+  @param[in,out]  Context           Pointer to the SMM CPU Sync context object.
+  @param[in]      CpuIndex          Check in CPU index.
+
+  @retval RETURN_SUCCESS            Check in CPU (CpuIndex) successfully.
+  @retval RETURN_ABORTED            Check in CPU failed due to SmmCpuSyncLockDoor() has been called by one elected CPU.
+
+**/
+RETURN_STATUS
+EFIAPI
+SmmCpuSyncCheckInCpu (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context,
+  IN     UINTN                 CpuIndex
+  )
+{
+  UINTN  Group;
+
+  ASSERT (Context != NULL);
+
+  ASSERT (CpuIndex < Context->NumberOfCpus);
+
+  Group = InternalGetCpuGroup (Context, CpuIndex);
+
+  //
+  // Check to return if CpuCount of the group has already been locked.
+  //
+  if (InternalReleaseSemaphore (Context->GroupSem[Group].CpuCount) == MAX_UINT32) {
+    return RETURN_ABORTED;
+  }
+
+  return RETURN_SUCCESS;
+}
+
+/**
+  Performs an atomic operation to check out CPU.
+
+  This function can be called in error handling flow for the CPU who calls CheckInCpu() earlier.
+  The caller shall make sure the CPU specified by CpuIndex has already checked-in.
+
+  If Context is NULL, then ASSERT().
+  If CpuIndex exceeds the range of all CPUs in the system, then ASSERT().
+
+  @param[in,out]  Context           Pointer to the SMM CPU Sync context object.
+  @param[in]      CpuIndex          Check out CPU index.
+
+  @retval RETURN_SUCCESS            Check out CPU (CpuIndex) successfully.
+  @retval RETURN_ABORTED            Check out CPU failed due to SmmCpuSyncLockDoor() has been called by one elected CPU.
+
+**/
+RETURN_STATUS
+EFIAPI
+SmmCpuSyncCheckOutCpu (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context,
+  IN     UINTN                 CpuIndex
+  )
+{
+  ASSERT (Context != NULL);
+
+  ASSERT (CpuIndex < Context->NumberOfCpus);
+
+  if (InternalWaitForSemaphore (Context->GroupSem[InternalGetCpuGroup (Context, CpuIndex)].CpuCount) == MAX_UINT32) {
+    return RETURN_ABORTED;
+  }
+
+  return RETURN_SUCCESS;
+}
+
+/**
+  Performs an atomic operation lock door for CPU checkin and checkout. After this function:
+  CPU can not check in via SmmCpuSyncCheckInCpu().
+  CPU can not check out via SmmCpuSyncCheckOutCpu().
+
+  The CPU specified by CpuIndex is elected to lock door. The caller shall make sure the CpuIndex
+  is the actual CPU calling this function to avoid the undefined behavior.
+
+  If Context is NULL, then ASSERT().
+  If CpuCount is NULL, then ASSERT().
+  If CpuIndex exceeds the range of all CPUs in the system, then ASSERT().
+
+  @param[in,out]  Context           Pointer to the SMM CPU Sync context object.
+  @param[in]      CpuIndex          Indicate which CPU to lock door.
+  @param[out]     CpuCount          Number of arrived CPU in SMI after look door.
+
+**/
+VOID
+EFIAPI
+SmmCpuSyncLockDoor (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context,
+  IN     UINTN                 CpuIndex,
+  OUT UINTN                    *CpuCount
+  )
+{
+  UINTN                                  GroupIndex;
+  SMM_CPU_SYNC_SEMAPHORE_FOR_EACH_GROUP  *GroupSem;
+
+  ASSERT (Context != NULL);
+
+  ASSERT (CpuCount != NULL);
+
+  ASSERT (CpuIndex < Context->NumberOfCpus);
+
+  //
+  // Lock the door of each group. A CPU checking in to a group either gets
+  // counted before the group is locked or fails to check in, so the sum of
+  // the counts upon lock is the exact number of arrived CPUs.
+  //
+  *CpuCount = 0;
+  for (GroupIndex = 0; GroupIndex < Context->NumberOfGroups; GroupIndex++) {
+    GroupSem = &Context->GroupSem[GroupIndex];
+
+    //
+    // Temporarily record the CpuCount into the ArrivedCpuCountUponLock before lock door.
+    // Recording before lock door is to avoid the CpuCount is locked but possible
+    // ArrivedCpuCountUponLock is not updated.
+    //
+    GroupSem->ArrivedCpuCountUponLock = *GroupSem->CpuCount;
+    GroupSem->ArrivedCpuCountUponLock = InternalLockdownSemaphore (GroupSem->CpuCount);
+    *CpuCount                        += GroupSem->ArrivedCpuCountUponLock;
+  }
+}
+
+/**
+  Used by the BSP to wait for APs.
+
+  The number of APs need to be waited is specified by NumberOfAPs. The BSP is specified by BspIndex.
+  The caller shall make sure the BspIndex is the actual CPU calling this function to avoid the undefined behavior.
+  The caller shall make sure the NumberOfAPs have already checked-in to avoid the undefined behavior.
+
+  If Context is NULL, then ASSERT().
+  If NumberOfAPs >= All CPUs in system, then ASSERT().
+  If BspIndex exceeds the range of all CPUs in the system, then ASSERT().
+
+  Note:
+  This function is blocking mode, and it will return only after the number of APs released by
+  calling SmmCpuSyncReleaseBsp():
+  BSP: WaitForAPs    <--  AP: ReleaseBsp
+
+  @param[in,out]  Context           Pointer to the SMM CPU Sync context object.
+  @param[in]      NumberOfAPs       Number of APs need to be waited by BSP.
+  @param[in]      BspIndex          The BSP Index to wait for APs.
+
+**/
+VOID
+EFIAPI
+SmmCpuSyncWaitForAPs (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context,
+  IN     UINTN                 NumberOfAPs,
+  IN     UINTN                 BspIndex
+  )
+{
+  UINTN   Remaining;
+  UINTN   GroupIndex;
+  UINT32  Value;
+  UINT32  Taken;
+
+  ASSERT (Context != NULL);
+
+  ASSERT (NumberOfAPs < Context->NumberOfCpus);
+
+  ASSERT (BspIndex < Context->NumberOfCpus);
+
+  //
+  // Collect the releases from the groups, taking all pending releases of a
+  // group at once but no more than still needed.
+  //
+  Remaining = NumberOfAPs;
+  while (Remaining > 0) {
+    for (GroupIndex = 0; (GroupIndex < Context->NumberOfGroups) && (Remaining > 0); GroupIndex++) {
+      Value = *Context->GroupSem[GroupIndex].BspRun;
+      if (Value == 0) {
+        continue;
+      }
+
+      Taken = (UINT32)MIN (Value, Remaining);
+      if (InterlockedCompareExchange32 (
+            (UINT32 *)Context->GroupSem[GroupIndex].BspRun,
+            Value,
+            Value - Taken
+            ) == Value)
+      {
+        Remaining -= Taken;
+      }
+    }
+
+    if (Remaining > 0) {
+      CpuPause ();
+    }
+  }
+}
+
+/**
+  Used by the BSP to release one AP.
+
+  The AP is specified by CpuIndex. The BSP is specified by BspIndex.
+  The caller shall make sure the BspIndex is the actual CPU calling this function to avoid the undefined behavior.
+  The caller shall make sure the CpuIndex has already checked-in to avoid the undefined behavior.
+
+  If Context is NULL, then ASSERT().
+  If CpuIndex == BspIndex, then ASSERT().
+  If BspIndex or CpuIndex exceed the range of all CPUs in the system, then ASSERT().
+
+  @param[in,out]  Context           Pointer to the SMM CPU Sync context object.
+  @param[in]      CpuIndex          Indicate which AP need to be released.
+  @param[in]      BspIndex          The BSP Index to release AP.
+
+**/
+VOID
+EFIAPI
+SmmCpuSyncReleaseOneAp   (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context,
+  IN     UINTN                 CpuIndex,
+  IN     UINTN                 BspIndex
+  )
+{
+  ASSERT (Context != NULL);
+
+  ASSERT (BspIndex != CpuIndex);
+
+  ASSERT (CpuIndex < Context->NumberOfCpus);
+
+  ASSERT (BspIndex < Context->NumberOfCpus);
+
+  InternalReleaseSemaphore (Context->CpuSem[CpuIndex].Run);
+}
+
+/**
+  Used by the AP to wait BSP.
+
+  The AP is specified by CpuIndex.
+  The caller shall make sure the CpuIndex is the actual CPU calling this function to avoid the undefined behavior.
+  The BSP is specified by BspIndex.
+
+  If Context is NULL, then ASSERT().
+  If CpuIndex == BspIndex, then ASSERT().
+  If BspIndex or CpuIndex exceed the range of all CPUs in the system, then ASSERT().
+
+  Note:
+  This function is blocking mode, and it will return only after the AP released by
+  calling SmmCpuSyncReleaseOneAp():
+  BSP: ReleaseOneAp  -->  AP: WaitForBsp
+
+  @param[in,out]  Context          Pointer to the SMM CPU Sync context object.
+  @param[in]      CpuIndex         Indicate which AP wait BSP.
+  @param[in]      BspIndex         The BSP Index to be waited.
+
+**/
+VOID
+EFIAPI
+SmmCpuSyncWaitForBsp (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context,
+  IN     UINTN                 CpuIndex,
+  IN     UINTN                 BspIndex
+  )
+{
+  ASSERT (Context != NULL);
+
+  ASSERT (BspIndex != CpuIndex);
+
+  ASSERT (CpuIndex < Context->NumberOfCpus);
+
+  ASSERT (BspIndex < Context->NumberOfCpus);
+
+  InternalWaitForSemaphore (Context->CpuSem[CpuIndex].Run);
+}
+
+/**
+  Used by the AP to release BSP.
+
+  The AP is specified by CpuIndex.
+  The caller shall make sure the CpuIndex is the actual CPU calling this function to avoid the undefined behavior.
+  The BSP is specified by BspIndex.
+
+  If Context is NULL, then ASSERT().
+  If CpuIndex == BspIndex, then ASSERT().
+  If BspIndex or CpuIndex exceed the range of all CPUs in the system, then ASSERT().
+
+  @param[in,out]  Context           Pointer to the SMM CPU Sync context object.
+  @param[in]      CpuIndex          Indicate which AP release BSP.
+  @param[in]      BspIndex          The BSP Index to be released.
+
+**/
+VOID
+EFIAPI
+SmmCpuSyncReleaseBsp (
+  IN OUT SMM_CPU_SYNC_CONTEXT  *Context,
+  IN     UINTN                 CpuIndex,
+  IN     UINTN                 BspIndex
+  )
+{
+  ASSERT (Context != NULL);
+
+  ASSERT (BspIndex != CpuIndex);
+
+  ASSERT (CpuIndex < Context->NumberOfCpus);
+
+  ASSERT (BspIndex < Context->NumberOfCpus);
+
+  InternalReleaseSemaphore (Context->GroupSem[InternalGetCpuGroup (Context, CpuIndex)].BspRun);
+}
@@ -0,0 +1,274 @@
+/** @file
+  Task pool library instance for DXE, built on the MP Services protocol.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiDxe.h>
+#include <Protocol/MpService.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include "InternalTaskPoolLib.h"
+
+/**
+  Allocate a batch with one queue per enabled processor.
+
+  @param[in]  MpServices    The MP Services protocol, or NULL if there is none.
+  @param[in]  TaskCount     The number of tasks in the batch.
+  @param[in]  Procedure     The function run for each task.
+  @param[in]  Context       The context passed to Procedure.
+
+  @return The new batch, or NULL if it could not be allocated.
+
+**/
+TASK_POOL_BATCH *
+TaskPoolCreateBatch (
+  IN EFI_MP_SERVICES_PROTOCOL  *MpServices,
+  IN UINTN                     TaskCount,
+  IN TASK_POOL_PROCEDURE       Procedure,
+  IN VOID                      *Context
+  )
+{
+  EFI_STATUS       Status;
+  TASK_POOL_BATCH  *Batch;
+  UINTN            NumberOfProcessors;
+  UINTN            NumberOfEnabledProcessors;
+
+  NumberOfEnabledProcessors = 1;
+  if (MpServices != NULL) {
+    Status = MpServices->GetNumberOfProcessors (MpServices, &NumberOfProcessors, &NumberOfEnabledProcessors);
+    if (EFI_ERROR (Status) || (NumberOfEnabledProcessors == 0)) {
+      NumberOfEnabledProcessors = 1;
+    }
+  }
+
+  Batch = AllocateZeroPool (sizeof (TASK_POOL_BATCH) + NumberOfEnabledProcessors * sizeof (TASK_POOL_QUEUE));
+  if (Batch == NULL) {
+    return NULL;
+  }
+
+  Batch->Procedure   = Procedure;
+  Batch->Context     = Context;
+  Batch->WorkerCount = NumberOfEnabledProcessors;
+  Batch->Queues      = (TASK_POOL_QUEUE *)(Batch + 1);
+  TaskPoolInitQueues (Batch->Queues, Batch->WorkerCount, TaskCount);
+
+  return Batch;
+}
+
+/**
+  Get the MP Services protocol if there is at least one enabled AP.
+
+  @return The MP Services protocol, or NULL if the tasks must run on the BSP.
+
+**/
+EFI_MP_SERVICES_PROTOCOL *
+TaskPoolGetMpServices (
+  VOID
+  )
+{
+  EFI_STATUS                Status;
+  EFI_MP_SERVICES_PROTOCOL  *MpServices;
+  UINTN                     NumberOfProcessors;
+  UINTN                     NumberOfEnabledProcessors;
+
+  Status = gBS->LocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&MpServices);
+  if (EFI_ERROR (Status)) {
+    return NULL;
+  }
+
+  Status = MpServices->GetNumberOfProcessors (MpServices, &NumberOfProcessors, &NumberOfEnabledProcessors);
+  if (EFI_ERROR (Status) || (NumberOfEnabledProcessors < 2)) {
+    return NULL;
+  }
+
+  return MpServices;
+}
+
+/**
+  Run TaskCount tasks on all enabled processors and wait for them to finish.
+
+  The BSP runs tasks together with the APs. When there is no AP, or the APs
+  are busy with other work, all tasks run on the BSP.
+
+  @param[in] TaskCount    The number of tasks in the batch.
+  @param[in] Procedure    The function run for each task.
+  @param[in] Context      The context passed to Procedure.
+
+  @retval EFI_SUCCESS            All tasks have run.
+  @retval EFI_INVALID_PARAMETER  Procedure is NULL.
+  @retval EFI_OUT_OF_RESOURCES   Failed to allocate the batch.
+
+**/
+EFI_STATUS
+EFIAPI
+TaskPoolParallelFor (
+  IN UINTN                TaskCount,
+  IN TASK_POOL_PROCEDURE  Procedure,
+  IN VOID                 *Context
+  )
+{
+  EFI_STATUS                Status;
+  EFI_MP_SERVICES_PROTOCOL  *MpServices;
+  TASK_POOL_BATCH           *Batch;
+  EFI_EVENT                 WaitEvent;
+  UINTN                     Index;
+
+  if (Procedure == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  MpServices = NULL;
+  if (TaskCount > 1) {
+    MpServices = TaskPoolGetMpServices ();
+  }
+
+  if (MpServices == NULL) {
+    for (Index = 0; Index < TaskCount; Index++) {
+      Procedure (Context, Index);
+    }
+
+    return EFI_SUCCESS;
+  }
+
+  Batch = TaskPoolCreateBatch (MpServices, TaskCount, Procedure, Context);
+  if (Batch == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // MP Services checks non-blocking requests from a timer at TPL_NOTIFY, so
+  // the BSP can only join the APs below that level.
+  //
+  WaitEvent = NULL;
+  if (EfiGetCurrentTpl () < TPL_NOTIFY) {
+    Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &WaitEvent);
+    if (EFI_ERROR (Status)) {
+      WaitEvent = NULL;
+    }
+  }
+
+  Status = MpServices->StartupAllAPs (MpServices, TaskPoolRunWorker, FALSE, WaitEvent, 0, Batch, NULL);
+  if (EFI_ERROR (Status)) {
+    //
+    // The APs are not available, the BSP steals all tasks.
+    //
+    DEBUG ((DEBUG_VERBOSE, "%a: StartupAllAPs - %r, run on BSP\n", __func__, Status));
+    TaskPoolRunWorker (Batch);
+  } else if (WaitEvent != NULL) {
+    TaskPoolRunWorker (Batch);
+    while (gBS->CheckEvent (WaitEvent) == EFI_NOT_READY) {
+      CpuPause ();
+    }
+  } else {
+    //
+    // The APs ran all tasks while the BSP was blocked in StartupAllAPs().
+    //
+    TaskPoolRunWorker (Batch);
+  }
+
+  if (WaitEvent != NULL) {
+    gBS->CloseEvent (WaitEvent);
+  }
+
+  FreePool (Batch);
+  return EFI_SUCCESS;
+}
+
+/**
+  Notification function of the MP Services wait event of an asynchronous batch.
+
+  @param[in] Event      The wait event.
+  @param[in] Context    The finished batch.
+
+**/
+VOID
+EFIAPI
+TaskPoolBatchDone (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  TASK_POOL_BATCH  *Batch;
+
+  Batch = (TASK_POOL_BATCH *)Context;
+
+  gBS->CloseEvent (Batch->WaitEvent);
+  gBS->SignalEvent (Batch->CompletionEvent);
+  FreePool (Batch);
+}
+
+/**
+  Start TaskCount tasks on the APs and return without waiting for them.
+
+  CompletionEvent is signaled at TPL_CALLBACK once all tasks have run. When
+  there is no AP, or the APs are busy with other work, all tasks run on the
+  BSP before this function returns and CompletionEvent is signaled.
+
+  @param[in] TaskCount        The number of tasks in the batch.
+  @param[in] Procedure        The function run for each task.
+  @param[in] Context          The context passed to Procedure. It must stay
+                              valid until CompletionEvent is signaled.
+  @param[in] CompletionEvent  The event signaled when all tasks have run.
+
+  @retval EFI_SUCCESS            The batch is started or done.
+  @retval EFI_INVALID_PARAMETER  Procedure or CompletionEvent is NULL.
+  @retval EFI_OUT_OF_RESOURCES   Failed to allocate the batch.
+
+**/
+EFI_STATUS
+EFIAPI
+TaskPoolParallelForAsync (
+  IN UINTN                TaskCount,
+  IN TASK_POOL_PROCEDURE  Procedure,
+  IN VOID                 *Context,
+  IN EFI_EVENT            CompletionEvent
+  )
+{
+  EFI_STATUS                Status;
+  EFI_MP_SERVICES_PROTOCOL  *MpServices;
+  TASK_POOL_BATCH           *Batch;
+  UINTN                     Index;
+
+  if ((Procedure == NULL) || (CompletionEvent == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  MpServices = NULL;
+  if (TaskCount > 0) {
+    MpServices = TaskPoolGetMpServices ();
+  }
+
+  if (MpServices != NULL) {
+    //
+    // The BSP does not take part, so the APs get all queues.
+    //
+    Batch = TaskPoolCreateBatch (MpServices, TaskCount, Procedure, Context);
+    if (Batch == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Batch->CompletionEvent = CompletionEvent;
+    Status                 = gBS->CreateEvent (EVT_NOTIFY_SIGNAL, TPL_CALLBACK, TaskPoolBatchDone, Batch, &Batch->WaitEvent);
+    if (!EFI_ERROR (Status)) {
+      Status = MpServices->StartupAllAPs (MpServices, TaskPoolRunWorker, FALSE, Batch->WaitEvent, 0, Batch, NULL);
+      if (!EFI_ERROR (Status)) {
+        return EFI_SUCCESS;
+      }
+
+      gBS->CloseEvent (Batch->WaitEvent);
+    }
+
+    DEBUG ((DEBUG_VERBOSE, "%a: StartupAllAPs - %r, run on BSP\n", __func__, Status));
+    FreePool (Batch);
+  }
+
+  for (Index = 0; Index < TaskCount; Index++) {
+    Procedure (Context, Index);
+  }
+
+  gBS->SignalEvent (CompletionEvent);
+  return EFI_SUCCESS;
+}
@@ -0,0 +1,89 @@
+/** @file
+  Internal definitions of the task pool library.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef INTERNAL_TASK_POOL_LIB_H_
+#define INTERNAL_TASK_POOL_LIB_H_
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/TaskPoolLib.h>
+
+//
+// Range of task indexes owned by one worker. The owner takes tasks from
+// Begin, thieves take the upper half of the range by lowering End.
+//
+typedef struct {
+  SPIN_LOCK       Lock;
+  volatile UINTN  Begin;
+  volatile UINTN  End;
+} TASK_POOL_QUEUE;
+
+typedef struct {
+  TASK_POOL_PROCEDURE    Procedure;
+  VOID                   *Context;
+  UINTN                  WorkerCount;
+  TASK_POOL_QUEUE        *Queues;
+  volatile UINT32        NextWorker;
+  EFI_EVENT              WaitEvent;
+  EFI_EVENT              CompletionEvent;
+} TASK_POOL_BATCH;
+
+/**
+  Split TaskCount tasks evenly across the queues of WorkerCount workers.
+
+  @param[out] Queues        Array of WorkerCount queues.
+  @param[in]  WorkerCount   The number of workers.
+  @param[in]  TaskCount     The number of tasks.
+
+**/
+VOID
+TaskPoolInitQueues (
+  OUT TASK_POOL_QUEUE  *Queues,
+  IN  UINTN            WorkerCount,
+  IN  UINTN            TaskCount
+  );
+
+/**
+  Take the next task for a worker.
+
+  The worker takes the first task of its own queue. When its queue is empty,
+  it steals the upper half of the largest remaining queue, keeps that range
+  as its own queue and takes the first task of it. A worker without a queue
+  steals one task at a time.
+
+  @param[in]  Queues        Array of WorkerCount queues.
+  @param[in]  WorkerCount   The number of workers.
+  @param[in]  Worker        The index of the worker taking a task.
+  @param[out] Index         The index of the task taken.
+
+  @retval TRUE    A task is taken.
+  @retval FALSE   No task is left in any queue.
+
+**/
+BOOLEAN
+TaskPoolTakeTask (
+  IN  TASK_POOL_QUEUE  *Queues,
+  IN  UINTN            WorkerCount,
+  IN  UINTN            Worker,
+  OUT UINTN            *Index
+  );
+
+/**
+  Run tasks of a batch until no task is left.
+
+  @param[in] Batch    The batch to work on.
+
+**/
+VOID
+EFIAPI
+TaskPoolRunWorker (
+  IN VOID  *Batch
+  );
+
+#endif
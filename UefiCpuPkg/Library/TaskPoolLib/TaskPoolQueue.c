@@ -0,0 +1,185 @@
+/** @file
+  Work-stealing task queues of the task pool library.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "InternalTaskPoolLib.h"
+
+/**
+  Split TaskCount tasks evenly across the queues of WorkerCount workers.
+
+  @param[out] Queues        Array of WorkerCount queues.
+  @param[in]  WorkerCount   The number of workers.
+  @param[in]  TaskCount     The number of tasks.
+
+**/
+VOID
+TaskPoolInitQueues (
+  OUT TASK_POOL_QUEUE  *Queues,
+  IN  UINTN            WorkerCount,
+  IN  UINTN            TaskCount
+  )
+{
+  UINTN  Worker;
+  UINTN  Share;
+  UINTN  Extra;
+  UINTN  Begin;
+
+  ASSERT (WorkerCount != 0);
+
+  Share = TaskCount / WorkerCount;
+  Extra = TaskCount % WorkerCount;
+  Begin = 0;
+  for (Worker = 0; Worker < WorkerCount; Worker++) {
+    InitializeSpinLock (&Queues[Worker].Lock);
+    Queues[Worker].Begin = Begin;
+    Begin               += Share + ((Worker < Extra) ? 1 : 0);
+    Queues[Worker].End   = Begin;
+  }
+}
+
+/**
+  Find the queue with the most remaining tasks.
+
+  The queues are read without their locks, so the result is only a hint.
+
+  @param[in]  Queues        Array of WorkerCount queues.
+  @param[in]  WorkerCount   The number of workers.
+
+  @return The index of the busiest queue, or WorkerCount if all are empty.
+
+**/
+UINTN
+TaskPoolFindVictim (
+  IN TASK_POOL_QUEUE  *Queues,
+  IN UINTN            WorkerCount
+  )
+{
+  UINTN  Worker;
+  UINTN  Victim;
+  UINTN  Remaining;
+  UINTN  MaxRemaining;
+
+  Victim       = WorkerCount;
+  MaxRemaining = 0;
+  for (Worker = 0; Worker < WorkerCount; Worker++) {
+    Remaining = Queues[Worker].End - Queues[Worker].Begin;
+    if ((Queues[Worker].End > Queues[Worker].Begin) && (Remaining > MaxRemaining)) {
+      MaxRemaining = Remaining;
+      Victim       = Worker;
+    }
+  }
+
+  return Victim;
+}
+
+/**
+  Take the next task for a worker.
+
+  The worker takes the first task of its own queue. When its queue is empty,
+  it steals the upper half of the largest remaining queue, keeps that range
+  as its own queue and takes the first task of it. A worker without a queue
+  steals one task at a time.
+
+  @param[in]  Queues        Array of WorkerCount queues.
+  @param[in]  WorkerCount   The number of workers.
+  @param[in]  Worker        The index of the worker taking a task.
+  @param[out] Index         The index of the task taken.
+
+  @retval TRUE    A task is taken.
+  @retval FALSE   No task is left in any queue.
+
+**/
+BOOLEAN
+TaskPoolTakeTask (
+  IN  TASK_POOL_QUEUE  *Queues,
+  IN  UINTN            WorkerCount,
+  IN  UINTN            Worker,
+  OUT UINTN            *Index
+  )
+{
+  TASK_POOL_QUEUE  *Own;
+  TASK_POOL_QUEUE  *Victim;
+  UINTN            VictimIndex;
+  UINTN            StolenBegin;
+  UINTN            StolenEnd;
+
+  Own = (Worker < WorkerCount) ? &Queues[Worker] : NULL;
+
+  if (Own != NULL) {
+    AcquireSpinLock (&Own->Lock);
+    if (Own->Begin < Own->End) {
+      *Index = Own->Begin++;
+      ReleaseSpinLock (&Own->Lock);
+      return TRUE;
+    }
+
+    ReleaseSpinLock (&Own->Lock);
+  }
+
+  while (TRUE) {
+    VictimIndex = TaskPoolFindVictim (Queues, WorkerCount);
+    if (VictimIndex == WorkerCount) {
+      return FALSE;
+    }
+
+    Victim = &Queues[VictimIndex];
+    AcquireSpinLock (&Victim->Lock);
+    if (Victim->Begin >= Victim->End) {
+      //
+      // Drained by its owner or another thief meanwhile, look again.
+      //
+      ReleaseSpinLock (&Victim->Lock);
+      continue;
+    }
+
+    StolenEnd = Victim->End;
+    if (Own == NULL) {
+      StolenBegin = StolenEnd - 1;
+    } else {
+      StolenBegin = StolenEnd - (StolenEnd - Victim->Begin + 1) / 2;
+    }
+
+    Victim->End = StolenBegin;
+    ReleaseSpinLock (&Victim->Lock);
+    break;
+  }
+
+  *Index = StolenBegin;
+  if ((Own != NULL) && (StolenBegin + 1 < StolenEnd)) {
+    AcquireSpinLock (&Own->Lock);
+    Own->Begin = StolenBegin + 1;
+    Own->End   = StolenEnd;
+    ReleaseSpinLock (&Own->Lock);
+  }
+
+  return TRUE;
+}
+
+/**
+  Run tasks of a batch until no task is left.
+
+  Every processor taking part in the batch gets its own worker index.
+
+  @param[in] Batch    The batch to work on.
+
+**/
+VOID
+EFIAPI
+TaskPoolRunWorker (
+  IN VOID  *Batch
+  )
+{
+  TASK_POOL_BATCH  *TaskBatch;
+  UINTN            Worker;
+  UINTN            Index;
+
+  TaskBatch = (TASK_POOL_BATCH *)Batch;
+  Worker    = InterlockedIncrement (&TaskBatch->NextWorker) - 1;
+
+  while (TaskPoolTakeTask (TaskBatch->Queues, TaskBatch->WorkerCount, Worker, &Index)) {
+    TaskBatch->Procedure (TaskBatch->Context, Index);
+  }
+}
@@ -0,0 +1,346 @@
+/** @file
+  Unit tests of the work-stealing task queues of the task pool library.
+
+  The tests model processors running a batch concurrently by interleaving
+  the workers on one host thread in a pseudo-random order.
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UnitTestLib.h>
+
+#include "../InternalTaskPoolLib.h"
+
+#define UNIT_TEST_APP_NAME     "TaskPoolLib Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+typedef struct {
+  UINTN    WorkerCount;
+  UINTN    TaskCount;
+  //
+  // Number of extra workers without a queue, as when more processors join a
+  // batch than it was created for.
+  //
+  UINTN    ExtraWorkers;
+  //
+  // Worker 0 is scheduled this many times as often as the others, to model
+  // one processor running much shorter tasks than the rest.
+  //
+  UINTN    Skew;
+} TASK_POOL_TEST_CONTEXT;
+
+STATIC TASK_POOL_TEST_CONTEXT  mTestContexts[] = {
+  { 1,  1,    0, 1 },
+  { 1,  100,  0, 1 },
+  { 4,  0,    0, 1 },
+  { 4,  3,    0, 1 },
+  { 4,  1000, 0, 1 },
+  { 8,  1000, 0, 16 },
+  { 16, 7,    0, 4 },
+  { 16, 4096, 0, 1 },
+  { 4,  100,  4, 1 },
+  { 64, 100,  0, 8 },
+};
+
+STATIC UINT32  mRandomSeed;
+
+/**
+  Return a pseudo-random number.
+
+  @return A pseudo-random number.
+**/
+STATIC
+UINT32
+NextRandom (
+  VOID
+  )
+{
+  mRandomSeed = mRandomSeed * 1103515245 + 12345;
+  return mRandomSeed >> 8;
+}
+
+/**
+  Check that the queues cover all tasks with contiguous, balanced ranges.
+
+  @param[in]  Context    The test context.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnitTestInitQueues (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TASK_POOL_TEST_CONTEXT  *TestContext;
+  TASK_POOL_QUEUE         *Queues;
+  UINTN                   Worker;
+  UINTN                   Size;
+  UINTN                   MinSize;
+  UINTN                   MaxSize;
+
+  TestContext = (TASK_POOL_TEST_CONTEXT *)Context;
+  Queues      = AllocateZeroPool (TestContext->WorkerCount * sizeof (TASK_POOL_QUEUE));
+  UT_ASSERT_NOT_NULL (Queues);
+
+  TaskPoolInitQueues (Queues, TestContext->WorkerCount, TestContext->TaskCount);
+
+  MinSize = MAX_UINTN;
+  MaxSize = 0;
+  UT_ASSERT_EQUAL (Queues[0].Begin, 0);
+  for (Worker = 0; Worker < TestContext->WorkerCount; Worker++) {
+    UT_ASSERT_TRUE (Queues[Worker].Begin <= Queues[Worker].End);
+    if (Worker > 0) {
+      UT_ASSERT_EQUAL (Queues[Worker].Begin, Queues[Worker - 1].End);
+    }
+
+    Size    = Queues[Worker].End - Queues[Worker].Begin;
+    MinSize = MIN (MinSize, Size);
+    MaxSize = MAX (MaxSize, Size);
+  }
+
+  UT_ASSERT_EQUAL (Queues[TestContext->WorkerCount - 1].End, TestContext->TaskCount);
+  UT_ASSERT_TRUE (MaxSize - MinSize <= 1);
+
+  FreePool (Queues);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Run a batch with interleaved workers and check that every task is taken
+  exactly once, and that idle workers steal from busy ones.
+
+  @param[in]  Context    The test context.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnitTestTakeAllTasks (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TASK_POOL_TEST_CONTEXT  *TestContext;
+  TASK_POOL_QUEUE         *Queues;
+  UINT8                   *Taken;
+  UINTN                   *TakenBy;
+  BOOLEAN                 *Done;
+  UINTN                   Workers;
+  UINTN                   DoneCount;
+  UINTN                   Worker;
+  UINTN                   Index;
+  UINTN                   TakenCount;
+  UINTN                   InitialShare;
+
+  TestContext = (TASK_POOL_TEST_CONTEXT *)Context;
+  Workers     = TestContext->WorkerCount + TestContext->ExtraWorkers;
+  Queues      = AllocateZeroPool (TestContext->WorkerCount * sizeof (TASK_POOL_QUEUE));
+  Taken       = AllocateZeroPool (TestContext->TaskCount + 1);
+  TakenBy     = AllocateZeroPool (Workers * sizeof (UINTN));
+  Done        = AllocateZeroPool (Workers * sizeof (BOOLEAN));
+  UT_ASSERT_NOT_NULL (Queues);
+  UT_ASSERT_NOT_NULL (Taken);
+  UT_ASSERT_NOT_NULL (TakenBy);
+  UT_ASSERT_NOT_NULL (Done);
+
+  mRandomSeed = (UINT32)(TestContext->WorkerCount * 31 + TestContext->TaskCount);
+  TaskPoolInitQueues (Queues, TestContext->WorkerCount, TestContext->TaskCount);
+  InitialShare = Queues[0].End - Queues[0].Begin;
+
+  TakenCount = 0;
+  DoneCount  = 0;
+  while (DoneCount < Workers) {
+    Worker = NextRandom () % (Workers + TestContext->Skew - 1);
+    if (Worker >= Workers) {
+      Worker = 0;
+    }
+
+    if (Done[Worker]) {
+      continue;
+    }
+
+    if (!TaskPoolTakeTask (Queues, TestContext->WorkerCount, Worker, &Index)) {
+      //
+      // A worker only stops when no task is left anywhere.
+      //
+      UT_ASSERT_EQUAL (TakenCount, TestContext->TaskCount);
+      Done[Worker] = TRUE;
+      DoneCount++;
+      continue;
+    }
+
+    UT_ASSERT_TRUE (Index < TestContext->TaskCount);
+    UT_ASSERT_EQUAL (Taken[Index], 0);
+    Taken[Index] = 1;
+    TakenBy[Worker]++;
+    TakenCount++;
+  }
+
+  UT_ASSERT_EQUAL (TakenCount, TestContext->TaskCount);
+
+  //
+  // A worker scheduled more often than the others must have run more than
+  // its initial share, which it can only get by stealing.
+  //
+  if ((TestContext->Skew > 1) && (TestContext->TaskCount >= 2 * TestContext->WorkerCount)) {
+    UT_ASSERT_TRUE (TakenBy[0] > InitialShare);
+  }
+
+  FreePool (Queues);
+  FreePool (Taken);
+  FreePool (TakenBy);
+  FreePool (Done);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Task procedure counting how often each task runs.
+
+  @param[in] Context    Array of run counts, one per task.
+  @param[in] Index      The index of the task.
+**/
+STATIC
+VOID
+EFIAPI
+CountTask (
+  IN VOID   *Context,
+  IN UINTN  Index
+  )
+{
+  ((UINT8 *)Context)[Index]++;
+}
+
+/**
+  Run the batch procedure through TaskPoolRunWorker() and check that each
+  task ran once.
+
+  @param[in]  Context    The test context.
+
+  @retval  UNIT_TEST_PASSED             The test passed.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+UnitTestRunWorker (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  TASK_POOL_TEST_CONTEXT  *TestContext;
+  TASK_POOL_BATCH         Batch;
+  UINT8                   *RunCount;
+  UINTN                   Index;
+
+  TestContext = (TASK_POOL_TEST_CONTEXT *)Context;
+  RunCount    = AllocateZeroPool (TestContext->TaskCount + 1);
+  UT_ASSERT_NOT_NULL (RunCount);
+
+  ZeroMem (&Batch, sizeof (Batch));
+  Batch.Procedure   = CountTask;
+  Batch.Context     = RunCount;
+  Batch.WorkerCount = TestContext->WorkerCount;
+  Batch.Queues      = AllocateZeroPool (TestContext->WorkerCount * sizeof (TASK_POOL_QUEUE));
+  UT_ASSERT_NOT_NULL (Batch.Queues);
+  TaskPoolInitQueues (Batch.Queues, Batch.WorkerCount, TestContext->TaskCount);
+
+  //
+  // The first worker drains the batch, later workers find nothing to do.
+  //
+  TaskPoolRunWorker (&Batch);
+  TaskPoolRunWorker (&Batch);
+  UT_ASSERT_EQUAL (Batch.NextWorker, 2);
+
+  for (Index = 0; Index < TestContext->TaskCount; Index++) {
+    UT_ASSERT_EQUAL (RunCount[Index], 1);
+  }
+
+  FreePool (Batch.Queues);
+  FreePool (RunCount);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests and run them.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      QueueTests;
+  UINTN                       Index;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&QueueTests, Framework, "TaskPoolLib Queue Tests", "TaskPoolLib.Queue", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for TaskPoolLib Queue Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  for (Index = 0; Index < ARRAY_SIZE (mTestContexts); Index++) {
+    AddTestCase (QueueTests, "Test TaskPoolInitQueues", "InitQueues", UnitTestInitQueues, NULL, NULL, &mTestContexts[Index]);
+    AddTestCase (QueueTests, "Test TaskPoolTakeTask", "TakeAllTasks", UnitTestTakeAllTasks, NULL, NULL, &mTestContexts[Index]);
+    AddTestCase (QueueTests, "Test TaskPoolRunWorker", "RunWorker", UnitTestRunWorker, NULL, NULL, &mTestContexts[Index]);
+  }
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param Argc  Number of arguments.
+  @param Argv  Array of arguments.
+
+  @return Test application exit code.
+**/
+INT32
+main (
+  INT32  Argc,
+  CHAR8  *Argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
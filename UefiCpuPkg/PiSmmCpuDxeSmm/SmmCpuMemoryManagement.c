@@ -1177,8 +1177,10 @@ EdkiiSmmClearMemoryAttributes (
   @param[in]       MapAttribute        The MapAttribute of the linear address range
   @param[in]       MapMask             The MapMask used for attribute. The corresponding field in Attribute is ignored if that in MapMask is 0.
 
+  @return The number of pages allocated for the page table.
+
 **/
-VOID
+UINTN
 GenPageTable (
   IN OUT UINTN               *PageTable,
   IN     PAGING_MODE         PagingMode,
@@ -1190,9 +1192,11 @@ GenPageTable (
 {
   RETURN_STATUS  Status;
   UINTN          PageTableBufferSize;
+  UINTN          PageTablePages;
   VOID           *PageTableBuffer;
 
   PageTableBufferSize = 0;
+  PageTablePages      = 0;
 
   Status = PageTableMap (
              PageTable,
@@ -1206,7 +1210,8 @@ GenPageTable (
              NULL
              );
   if (Status == RETURN_BUFFER_TOO_SMALL) {
-    PageTableBuffer = AllocatePageTableMemory (EFI_SIZE_TO_PAGES (PageTableBufferSize));
+    PageTablePages  = EFI_SIZE_TO_PAGES (PageTableBufferSize);
+    PageTableBuffer = AllocatePageTableMemory (PageTablePages);
     ASSERT (PageTableBuffer != NULL);
     Status = PageTableMap (
                PageTable,
@@ -1223,6 +1228,129 @@ GenPageTable (
 
   ASSERT (Status == RETURN_SUCCESS);
   ASSERT (PageTableBufferSize == 0);
+
+  return PageTablePages;
+}
+
+/**
+  Function to compare 2 IA32_MAP_REQUEST based on linear address.
+
+  @param[in] Buffer1            pointer to the first IA32_MAP_REQUEST to compare
+  @param[in] Buffer2            pointer to the second IA32_MAP_REQUEST to compare
+
+  @retval 0                     Buffer1 equal to Buffer2
+  @retval <0                    Buffer1 is less than Buffer2
+  @retval >0                    Buffer1 is greater than Buffer2
+**/
+INTN
+EFIAPI
+MapRequestCompare (
+  IN  CONST VOID  *Buffer1,
+  IN  CONST VOID  *Buffer2
+  )
+{
+  if (((IA32_MAP_REQUEST *)Buffer1)->LinearAddress > ((IA32_MAP_REQUEST *)Buffer2)->LinearAddress) {
+    return 1;
+  } else if (((IA32_MAP_REQUEST *)Buffer1)->LinearAddress < ((IA32_MAP_REQUEST *)Buffer2)->LinearAddress) {
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+  Create page table for multiple non-overlapping linear address ranges at once.
+
+  The ranges are sorted, and adjacent ranges with identical attributes that map contiguous
+  physical memory are merged first, so the page table is created with fewer and larger
+  ranges than calling GenPageTable() for each range.
+
+  @param[in, out]  PageTable           The pointer to the page table.
+  @param[in]       PagingMode          The paging mode.
+  @param[in, out]  Requests            The linear address ranges and their attributes.
+                                       The array is sorted and merged in place on return.
+  @param[in]       RequestCount        The number of entries in Requests.
+
+  @retval RETURN_SUCCESS            The page table is created.
+  @retval RETURN_INVALID_PARAMETER  Some ranges overlap. The page table is not modified.
+**/
+RETURN_STATUS
+GenPageTableBatch (
+  IN OUT UINTN             *PageTable,
+  IN     PAGING_MODE       PagingMode,
+  IN OUT IA32_MAP_REQUEST  *Requests,
+  IN     UINTN             RequestCount
+  )
+{
+  IA32_MAP_REQUEST  Request;
+  UINTN             Index;
+  UINTN             MergedCount;
+  UINTN             PageTablePages;
+
+  //
+  // Drop the empty ranges.
+  //
+  for (Index = 0, MergedCount = 0; Index < RequestCount; Index++) {
+    if (Requests[Index].Length != 0) {
+      CopyMem (&Requests[MergedCount++], &Requests[Index], sizeof (IA32_MAP_REQUEST));
+    }
+  }
+
+  RequestCount = MergedCount;
+  if (RequestCount == 0) {
+    return RETURN_SUCCESS;
+  }
+
+  QuickSort (Requests, RequestCount, sizeof (IA32_MAP_REQUEST), (BASE_SORT_COMPARE)MapRequestCompare, &Request);
+
+  //
+  // The physical address is part of the attribute, so two adjacent ranges are merged
+  // only when the physical address also continues from one to the next.
+  //
+  MergedCount = 0;
+  for (Index = 1; Index < RequestCount; Index++) {
+    if (Requests[Index].LinearAddress < Requests[MergedCount].LinearAddress + Requests[MergedCount].Length) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    if ((Requests[Index].LinearAddress == Requests[MergedCount].LinearAddress + Requests[MergedCount].Length) &&
+        (Requests[Index].Mask.Uint64 == Requests[MergedCount].Mask.Uint64) &&
+        (IA32_MAP_ATTRIBUTE_ATTRIBUTES (&Requests[Index].Attribute) == IA32_MAP_ATTRIBUTE_ATTRIBUTES (&Requests[MergedCount].Attribute)) &&
+        (IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (&Requests[Index].Attribute) ==
+         IA32_MAP_ATTRIBUTE_PAGE_TABLE_BASE_ADDRESS (&Requests[MergedCount].Attribute) + Requests[MergedCount].Length))
+    {
+      Requests[MergedCount].Length += Requests[Index].Length;
+    } else {
+      MergedCount++;
+      if (MergedCount != Index) {
+        CopyMem (&Requests[MergedCount], &Requests[Index], sizeof (IA32_MAP_REQUEST));
+      }
+    }
+  }
+
+  MergedCount++;
+
+  PageTablePages = 0;
+  for (Index = 0; Index < MergedCount; Index++) {
+    PageTablePages += GenPageTable (
+                        PageTable,
+                        PagingMode,
+                        Requests[Index].LinearAddress,
+                        Requests[Index].Length,
+                        Requests[Index].Attribute,
+                        Requests[Index].Mask
+                        );
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "SMM page table: %Lu ranges merged into %Lu, mapped with 0x%Lx pages\n",
+    (UINT64)RequestCount,
+    (UINT64)MergedCount,
+    (UINT64)PageTablePages
+    ));
+
+  return RETURN_SUCCESS;
 }
 
 /**
@@ -1246,9 +1374,14 @@ GenSmmPageTable (
   UINTN                 MemoryRegionCount;
   IA32_MAP_ATTRIBUTE    MapAttribute;
   IA32_MAP_ATTRIBUTE    MapMask;
+  IA32_MAP_REQUEST      *Requests;
+  IA32_MAP_REQUEST      *SortedRequests;
+  UINTN                 RequestCount;
   RETURN_STATUS         Status;
   UINTN                 GuardPage;
 
+  PERF_FUNCTION_BEGIN ();
+
   PageTable         = 0;
   MemoryRegion      = NULL;
   MemoryRegionCount = 0;
@@ -1260,8 +1393,12 @@ GenSmmPageTable (
   CreateNonMmramMemMap (PhysicalAddressBits, &MemoryRegion, &MemoryRegionCount);
   ASSERT (MemoryRegion != NULL && MemoryRegionCount != 0);
 
+  Requests = AllocatePool (sizeof (IA32_MAP_REQUEST) * (MemoryRegionCount + mSmmCpuSmramRangeCount));
+  ASSERT (Requests != NULL);
+  RequestCount = 0;
+
   //
-  // 2. Gen NonMmram MemoryRegion PageTable
+  // 2. Collect NonMmram MemoryRegion mapping
   //
   for (Index = 0; Index < MemoryRegionCount; Index++) {
     ASSERT (MemoryRegion[Index].Base % SIZE_4KB == 0);
@@ -1290,7 +1427,11 @@ GenSmmPageTable (
       }
     }
 
-    GenPageTable (&PageTable, PagingMode, MemoryRegion[Index].Base, (UINTN)MemoryRegion[Index].Length, MapAttribute, MapMask);
+    Requests[RequestCount].LinearAddress = MemoryRegion[Index].Base;
+    Requests[RequestCount].Length        = MemoryRegion[Index].Length;
+    Requests[RequestCount].Attribute     = MapAttribute;
+    Requests[RequestCount].Mask          = MapMask;
+    RequestCount++;
   }
 
   //
@@ -1301,7 +1442,7 @@ GenSmmPageTable (
   }
 
   //
-  // 3. Gen MMRAM Range PageTable
+  // 3. Collect MMRAM Range mapping
   //
   for (Index = 0; Index < mSmmCpuSmramRangeCount; Index++) {
     ASSERT (mSmmCpuSmramRanges[Index].CpuStart % SIZE_4KB == 0);
@@ -1317,9 +1458,35 @@ GenSmmPageTable (
     MapAttribute.Bits.Accessed       = 1;
     MapAttribute.Bits.Dirty          = 1;
 
-    GenPageTable (&PageTable, PagingMode, mSmmCpuSmramRanges[Index].CpuStart, mSmmCpuSmramRanges[Index].PhysicalSize, MapAttribute, MapMask);
+    Requests[RequestCount].LinearAddress = mSmmCpuSmramRanges[Index].CpuStart;
+    Requests[RequestCount].Length        = mSmmCpuSmramRanges[Index].PhysicalSize;
+    Requests[RequestCount].Attribute     = MapAttribute;
+    Requests[RequestCount].Mask          = MapMask;
+    RequestCount++;
+  }
+
+  //
+  // 4. Gen PageTable for all the ranges at once.
+  //    When some ranges overlap, the later range takes precedence. Fall back to
+  //    mapping the ranges one by one in order to keep that behavior.
+  //
+  SortedRequests = AllocateCopyPool (sizeof (IA32_MAP_REQUEST) * RequestCount, Requests);
+  ASSERT (SortedRequests != NULL);
+  Status = GenPageTableBatch (&PageTable, PagingMode, SortedRequests, RequestCount);
+  if (Status == RETURN_INVALID_PARAMETER) {
+    DEBUG ((DEBUG_INFO, "SMM page table: ranges overlap, map them one by one\n"));
+    for (Index = 0; Index < RequestCount; Index++) {
+      if (Requests[Index].Length != 0) {
+        GenPageTable (&PageTable, PagingMode, Requests[Index].LinearAddress, Requests[Index].Length, Requests[Index].Attribute, Requests[Index].Mask);
+      }
+    }
+  } else {
+    ASSERT (Status == RETURN_SUCCESS);
   }
 
+  FreePool (SortedRequests);
+  FreePool (Requests);
+
   if (FeaturePcdGet (PcdCpuSmmStackGuard)) {
     //
     // Mark the 4KB guard page between known good stack and smm stack as non-present
@@ -1339,6 +1506,8 @@ GenSmmPageTable (
     ASSERT (Status == RETURN_SUCCESS);
   }
 
+  PERF_FUNCTION_END ();
+
   return (UINTN)PageTable;
 }
 